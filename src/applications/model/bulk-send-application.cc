@@ -19,12 +19,15 @@
 
 #include "bulk-send-application.h"
 
+#include "fluid-flow-manager.h"
+
 #include "ns3/address.h"
 #include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
 #include "ns3/packet.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
@@ -87,6 +90,12 @@ BulkSendApplication::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&BulkSendApplication::m_enableSeqTsSizeHeader),
                           MakeBooleanChecker())
+            .AddAttribute("FluidFlowManager",
+                          "The manager of the fluid flows, to send the data as a fluid flow "
+                          "until competing packets require packet mode. Null for packet mode.",
+                          PointerValue(),
+                          MakePointerAccessor(&BulkSendApplication::m_fluid),
+                          MakePointerChecker<FluidFlowManager>())
             .AddTraceSource("Tx",
                             "A new packet is sent",
                             MakeTraceSourceAccessor(&BulkSendApplication::m_txTrace),
@@ -133,6 +142,7 @@ BulkSendApplication::DoDispose()
 
     m_socket = nullptr;
     m_unsentPacket = nullptr;
+    m_fluid = nullptr;
     // chain up
     Application::DoDispose();
 }
@@ -144,6 +154,11 @@ BulkSendApplication::StartApplication() // Called at time specified by Start
     NS_LOG_FUNCTION(this);
     Address from;
 
+    if (!m_socket && StartFluidFlow())
+    {
+        return;
+    }
+
     // Create the socket if not already
     if (!m_socket)
     {
@@ -207,12 +222,17 @@ BulkSendApplication::StopApplication() // Called at time specified by Stop
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_socket)
+    if (m_fluidFlow)
+    {
+        m_totBytes += m_fluid->RemoveFlow(m_fluidFlow);
+        m_fluidFlow = 0;
+    }
+    else if (m_socket)
     {
         m_socket->Close();
         m_connected = false;
     }
-    else
+    else if (!m_fluid)
     {
         NS_LOG_WARN("BulkSendApplication found null socket to close in StopApplication");
     }
@@ -305,6 +325,42 @@ BulkSendApplication::SendData(const Address& from, const Address& to)
     }
 }
 
+bool
+BulkSendApplication::StartFluidFlow()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_fluid || m_packetMode || !InetSocketAddress::IsMatchingType(m_peer))
+    {
+        return false;
+    }
+    if (m_fluidFlow || (m_maxBytes > 0 && m_totBytes >= m_maxBytes))
+    {
+        return true;
+    }
+    m_fluidFlow =
+        m_fluid->AddFlow(GetNode(),
+                         InetSocketAddress::ConvertFrom(m_peer).GetIpv4(),
+                         m_maxBytes > 0 ? m_maxBytes - m_totBytes : 0,
+                         MakeCallback(&BulkSendApplication::FluidFlowStopped, this));
+    return m_fluidFlow != 0;
+}
+
+void
+BulkSendApplication::FluidFlowStopped(uint64_t sent, bool completed)
+{
+    NS_LOG_FUNCTION(this << sent << completed);
+
+    m_fluidFlow = 0;
+    m_totBytes += sent;
+    if (!completed)
+    {
+        // Send the remaining data as packets
+        m_packetMode = true;
+        StartApplication();
+    }
+}
+
 void
 BulkSendApplication::ConnectionSucceeded(Ptr<Socket> socket)
 {
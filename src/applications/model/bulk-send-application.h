@@ -32,6 +32,7 @@ namespace ns3
 {
 
 class Address;
+class FluidFlowManager;
 class Socket;
 
 /**
@@ -72,6 +73,12 @@ class Socket;
  * statistics from this header have been added to \c ns3::PacketSink
  * (enable its "EnableSeqTsSizeHeader" attribute), or users may extract
  * the header via trace sources.
+ *
+ * If the attribute "FluidFlowManager" is set, the application first tries
+ * to send its data as a fluid flow of this FluidFlowManager, without
+ * packets, towards an IPv4 remote address. It opens its socket and sends
+ * the bytes left as packets when the flow is switched back to packet mode,
+ * and never opens its socket if the fluid flow completes.
  */
 class BulkSendApplication : public Application
 {
@@ -122,6 +129,18 @@ class BulkSendApplication : public Application
      */
     void SendData(const Address& from, const Address& to);
 
+    /**
+     * \brief Start sending the data as a fluid flow.
+     * \return true if the fluid flow is started
+     */
+    bool StartFluidFlow();
+    /**
+     * \brief Handle the end of the fluid flow.
+     * \param sent the bytes transferred by the fluid flow
+     * \param completed whether the fluid flow has completed
+     */
+    void FluidFlowStopped(uint64_t sent, bool completed);
+
     Ptr<Socket> m_socket;                //!< Associated socket
     Address m_peer;                      //!< Peer address
     Address m_local;                     //!< Local address to bind to
@@ -134,6 +153,9 @@ class BulkSendApplication : public Application
     uint32_t m_seq{0};                   //!< Sequence
     Ptr<Packet> m_unsentPacket;          //!< Variable to cache unsent packet
     bool m_enableSeqTsSizeHeader{false}; //!< Enable or disable the SeqTsSizeHeader
+    Ptr<FluidFlowManager> m_fluid;       //!< Manager of the fluid flow, if any
+    uint32_t m_fluidFlow{0};             //!< Identifier of the fluid flow, 0 if none
+    bool m_packetMode{false};            //!< True once switched back to packet mode
 
     /// Traced Callback: sent packets
     TracedCallback<Ptr<const Packet>> m_txTrace;
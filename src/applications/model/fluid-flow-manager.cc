@@ -0,0 +1,374 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fluid-flow-manager.h"
+
+#include "ns3/channel.h"
+#include "ns3/double.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FluidFlowManager");
+
+NS_OBJECT_ENSURE_REGISTERED(FluidFlowManager);
+
+/// Maximum number of hops of the path of a fluid flow
+static const uint32_t FLUID_FLOW_MAX_HOPS = 255;
+
+TypeId
+FluidFlowManager::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FluidFlowManager")
+            .SetParent<Object>()
+            .SetGroupName("Applications")
+            .AddConstructor<FluidFlowManager>()
+            .AddAttribute("Efficiency",
+                          "The fraction of the link capacities carried as application data by "
+                          "the fluid flows, to account for the protocol headers.",
+                          DoubleValue(0.95),
+                          MakeDoubleAccessor(&FluidFlowManager::m_efficiency),
+                          MakeDoubleChecker<double>(0, 1));
+    return tid;
+}
+
+FluidFlowManager::FluidFlowManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FluidFlowManager::~FluidFlowManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FluidFlowManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [id, flow] : m_flows)
+    {
+        flow.completion.Cancel();
+    }
+    m_flows.clear();
+    m_links.clear();
+    for (const auto& ipv4 : m_tracedNodes)
+    {
+        ipv4->TraceDisconnectWithoutContext("Tx",
+                                            MakeCallback(&FluidFlowManager::PacketSent, this));
+    }
+    m_tracedNodes.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+FluidFlowManager::AddFlow(Ptr<Node> node,
+                          Ipv4Address destination,
+                          uint64_t maxBytes,
+                          FlowStoppedCallback stopped)
+{
+    NS_LOG_FUNCTION(this << node << destination << maxBytes);
+
+    std::vector<Ptr<NetDevice>> path = GetPath(node, destination);
+    if (path.empty())
+    {
+        NS_LOG_LOGIC("No eligible path from node " << node->GetId() << " to " << destination);
+        return 0;
+    }
+
+    Update();
+    uint32_t id = m_nextId++;
+    for (const auto& device : path)
+    {
+        m_links[device]++;
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        if (m_tracedNodes.insert(ipv4).second)
+        {
+            ipv4->TraceConnectWithoutContext("Tx",
+                                             MakeCallback(&FluidFlowManager::PacketSent, this));
+        }
+    }
+    m_flows[id] = {path, maxBytes, 0, 0, stopped, EventId()};
+    ComputeRates();
+    NS_LOG_DEBUG("Flow " << id << " from node " << node->GetId() << " to " << destination
+                         << " over " << path.size() << " links, rate "
+                         << m_flows[id].rate << " bit/s");
+    return id;
+}
+
+uint64_t
+FluidFlowManager::RemoveFlow(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+
+    auto it = m_flows.find(id);
+    if (it == m_flows.end())
+    {
+        return 0;
+    }
+    Update();
+    auto sent = static_cast<uint64_t>(it->second.sent);
+    it->second.completion.Cancel();
+    for (const auto& device : it->second.path)
+    {
+        auto link = m_links.find(device);
+        if (--link->second == 0)
+        {
+            m_links.erase(link);
+        }
+    }
+    m_flows.erase(it);
+    ComputeRates();
+    return sent;
+}
+
+void
+FluidFlowManager::SwitchToPacketMode(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+    StopFlow(id, false);
+}
+
+void
+FluidFlowManager::StopFlow(uint32_t id, bool completed)
+{
+    NS_LOG_FUNCTION(this << id << completed);
+
+    auto it = m_flows.find(id);
+    if (it == m_flows.end())
+    {
+        return;
+    }
+    FlowStoppedCallback stopped = it->second.stopped;
+    uint64_t maxBytes = it->second.maxBytes;
+    uint64_t sent = RemoveFlow(id);
+    if (completed)
+    {
+        sent = maxBytes;
+    }
+    NS_LOG_DEBUG("Flow " << id << (completed ? " completed" : " switched to packet mode")
+                         << " after " << sent << " bytes");
+    if (!stopped.IsNull())
+    {
+        stopped(sent, completed);
+    }
+}
+
+DataRate
+FluidFlowManager::GetRate(uint32_t id) const
+{
+    auto it = m_flows.find(id);
+    return DataRate(it == m_flows.end() ? 0 : static_cast<uint64_t>(it->second.rate));
+}
+
+uint64_t
+FluidFlowManager::GetBytesSent(uint32_t id) const
+{
+    auto it = m_flows.find(id);
+    if (it == m_flows.end())
+    {
+        return 0;
+    }
+    double sent =
+        it->second.sent + it->second.rate * (Simulator::Now() - m_lastUpdate).GetSeconds() / 8;
+    if (it->second.maxBytes > 0)
+    {
+        sent = std::min(sent, static_cast<double>(it->second.maxBytes));
+    }
+    return static_cast<uint64_t>(sent);
+}
+
+uint32_t
+FluidFlowManager::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+std::vector<Ptr<NetDevice>>
+FluidFlowManager::GetPath(Ptr<Node> node, Ipv4Address destination) const
+{
+    NS_LOG_FUNCTION(this << node << destination);
+
+    std::vector<Ptr<NetDevice>> path;
+    Ptr<Packet> probe = Create<Packet>();
+    Ipv4Header header;
+    header.SetDestination(destination);
+    for (uint32_t hop = 0; hop < FLUID_FLOW_MAX_HOPS; ++hop)
+    {
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        if (!ipv4 || !ipv4->GetRoutingProtocol())
+        {
+            break;
+        }
+        if (ipv4->GetInterfaceForAddress(destination) >= 0)
+        {
+            return path;
+        }
+        Socket::SocketErrno errno_;
+        Ptr<Ipv4Route> route =
+            ipv4->GetRoutingProtocol()->RouteOutput(probe, header, nullptr, errno_);
+        if (!route || GetCapacity(route->GetOutputDevice()) <= 0)
+        {
+            break;
+        }
+        Ptr<NetDevice> device = route->GetOutputDevice();
+        path.push_back(device);
+        Ptr<Channel> channel = device->GetChannel();
+        node = channel->GetDevice(channel->GetDevice(0) == device ? 1 : 0)->GetNode();
+    }
+    return {};
+}
+
+double
+FluidFlowManager::GetCapacity(Ptr<NetDevice> device) const
+{
+    if (!device || !device->IsPointToPoint() || !device->GetChannel() ||
+        device->GetChannel()->GetNDevices() != 2)
+    {
+        return 0;
+    }
+    DataRateValue rate;
+    if (!device->GetAttributeFailSafe("DataRate", rate))
+    {
+        return 0;
+    }
+    return rate.Get().GetBitRate() * m_efficiency;
+}
+
+void
+FluidFlowManager::Update()
+{
+    double elapsed = (Simulator::Now() - m_lastUpdate).GetSeconds();
+    for (auto& [id, flow] : m_flows)
+    {
+        flow.sent += flow.rate * elapsed / 8;
+        if (flow.maxBytes > 0)
+        {
+            flow.sent = std::min(flow.sent, static_cast<double>(flow.maxBytes));
+        }
+    }
+    m_lastUpdate = Simulator::Now();
+}
+
+void
+FluidFlowManager::ComputeRates()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Progressive filling: the flows crossing the link with the smallest
+    // fair share get that share, which is then removed from the capacity of
+    // the other links of their path, until all the flows have a rate
+    struct Link
+    {
+        double capacity{0}; //!< Capacity left to the flows without a rate
+        uint32_t flows{0};  //!< Number of flows without a rate
+    };
+
+    std::map<Ptr<NetDevice>, Link> links;
+    for (const auto& [device, count] : m_links)
+    {
+        links[device] = {GetCapacity(device), count};
+    }
+    std::set<uint32_t> pending;
+    for (const auto& [id, flow] : m_flows)
+    {
+        pending.insert(id);
+    }
+    while (!pending.empty())
+    {
+        auto bottleneck = links.end();
+        double share = std::numeric_limits<double>::max();
+        for (auto it = links.begin(); it != links.end(); ++it)
+        {
+            if (it->second.flows > 0 && it->second.capacity / it->second.flows < share)
+            {
+                share = it->second.capacity / it->second.flows;
+                bottleneck = it;
+            }
+        }
+        NS_ASSERT(bottleneck != links.end());
+        share = std::max(share, 0.0);
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            Flow& flow = m_flows[*it];
+            if (std::find(flow.path.begin(), flow.path.end(), bottleneck->first) ==
+                flow.path.end())
+            {
+                ++it;
+                continue;
+            }
+            flow.rate = share;
+            for (const auto& device : flow.path)
+            {
+                links[device].capacity -= share;
+                links[device].flows--;
+            }
+            it = pending.erase(it);
+        }
+    }
+
+    for (auto& [id, flow] : m_flows)
+    {
+        flow.completion.Cancel();
+        if (flow.maxBytes > 0 && flow.rate > 0)
+        {
+            Time left = Seconds((flow.maxBytes - flow.sent) * 8 / flow.rate);
+            flow.completion =
+                Simulator::Schedule(left, &FluidFlowManager::StopFlow, this, id, true);
+        }
+    }
+}
+
+void
+FluidFlowManager::PacketSent(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    Ptr<NetDevice> device = ipv4->GetNetDevice(interface);
+    if (m_links.find(device) == m_links.end())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << packet << ipv4 << interface);
+
+    std::vector<uint32_t> competing;
+    for (const auto& [id, flow] : m_flows)
+    {
+        if (std::find(flow.path.begin(), flow.path.end(), device) != flow.path.end())
+        {
+            competing.push_back(id);
+        }
+    }
+    // The flows are stopped in a later event, as their applications may
+    // send packets when they switch back to packet mode, while the stack
+    // is still sending this packet
+    for (auto id : competing)
+    {
+        Simulator::ScheduleNow(&FluidFlowManager::StopFlow, this, id, false);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLUID_FLOW_MANAGER_H
+#define FLUID_FLOW_MANAGER_H
+
+#include "ns3/callback.h"
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/net-device.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ns3
+{
+
+class Ipv4;
+class Node;
+class Packet;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Fluid model of bulk flows over point-to-point paths.
+ *
+ * A fluid flow does not send packets: it transfers its bytes at a rate
+ * computed by max-min fairness over the capacities of the links of its
+ * path, recomputed each time a fluid flow starts or stops. The path of a
+ * flow follows the IPv4 routes from its source node to its destination,
+ * and a flow can only be fluid if all the links of its path are
+ * point-to-point links with a known data rate.
+ *
+ * The fluid flows are not visible to the packets: as soon as an IPv4
+ * packet is sent on a link used by fluid flows, these flows are switched
+ * back to packet mode, and the owner of each flow is notified of the bytes
+ * transferred so far, to send the remaining ones as packets.
+ *
+ * The fluid flows start at their max-min fair rate without a connection
+ * setup or slow start, and their bytes are not received by any socket.
+ */
+class FluidFlowManager : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FluidFlowManager();
+    ~FluidFlowManager() override;
+
+    /**
+     * Callback invoked when a fluid flow stops, with the number of bytes
+     * transferred by the flow and whether the flow has completed. A flow
+     * which has not completed is switched back to packet mode.
+     */
+    typedef Callback<void, uint64_t, bool> FlowStoppedCallback;
+
+    /**
+     * \brief Start a fluid flow.
+     * \param node The source node.
+     * \param destination The destination address.
+     * \param maxBytes The number of bytes to transfer, 0 for no limit.
+     * \param stopped The callback invoked when the flow completes or is
+     *        switched back to packet mode.
+     * \return The identifier of the flow, or 0 if the path to the
+     *         destination is not eligible for a fluid flow.
+     */
+    uint32_t AddFlow(Ptr<Node> node,
+                     Ipv4Address destination,
+                     uint64_t maxBytes,
+                     FlowStoppedCallback stopped);
+
+    /**
+     * \brief Stop a fluid flow, without invoking its callback.
+     * \param id The identifier of the flow.
+     * \return The number of bytes transferred by the flow.
+     */
+    uint64_t RemoveFlow(uint32_t id);
+
+    /**
+     * \brief Switch a fluid flow back to packet mode, and invoke its callback.
+     * \param id The identifier of the flow.
+     */
+    void SwitchToPacketMode(uint32_t id);
+
+    /**
+     * \param id The identifier of the flow.
+     * \return The current rate of the flow.
+     */
+    DataRate GetRate(uint32_t id) const;
+
+    /**
+     * \param id The identifier of the flow.
+     * \return The number of bytes transferred by the flow so far.
+     */
+    uint64_t GetBytesSent(uint32_t id) const;
+
+    /**
+     * \return The number of fluid flows.
+     */
+    uint32_t GetNFlows() const;
+
+    /**
+     * \brief Get the path of the IPv4 packets from a node to a destination.
+     * \param node The source node.
+     * \param destination The destination address.
+     * \return The output devices along the path, or an empty path if the
+     *         path is not eligible for a fluid flow.
+     */
+    std::vector<Ptr<NetDevice>> GetPath(Ptr<Node> node, Ipv4Address destination) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A fluid flow.
+    struct Flow
+    {
+        std::vector<Ptr<NetDevice>> path; //!< Output devices along the path
+        uint64_t maxBytes;                //!< Bytes to transfer, 0 for no limit
+        double sent;                      //!< Bytes transferred so far
+        double rate;                      //!< Current rate, in bit/s
+        FlowStoppedCallback stopped;      //!< Callback invoked when the flow stops
+        EventId completion;               //!< Completion event of the flow
+    };
+
+    /**
+     * \brief Account for the bytes transferred by the flows since the last update.
+     */
+    void Update();
+    /**
+     * \brief Compute the max-min fair rates of the flows, and reschedule
+     * their completion.
+     */
+    void ComputeRates();
+    /**
+     * \brief Remove a flow and invoke its callback.
+     * \param id The identifier of the flow.
+     * \param completed Whether the flow has completed.
+     */
+    void StopFlow(uint32_t id, bool completed);
+    /**
+     * \brief Get the capacity of a link available to the fluid flows.
+     * \param device The output device of the link.
+     * \return The capacity, in bit/s, or 0 if the link is not eligible.
+     */
+    double GetCapacity(Ptr<NetDevice> device) const;
+    /**
+     * \brief Switch the fluid flows of a link back to packet mode when an
+     * IPv4 packet is sent on it, in an event scheduled now.
+     * \param packet The packet.
+     * \param ipv4 The IPv4 protocol sending the packet.
+     * \param interface The output interface.
+     */
+    void PacketSent(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    double m_efficiency;                        //!< Fraction of capacity carried as data
+    std::map<uint32_t, Flow> m_flows;           //!< Fluid flows, by identifier
+    std::map<Ptr<NetDevice>, uint32_t> m_links; //!< Number of fluid flows per link
+    std::set<Ptr<Ipv4>> m_tracedNodes;          //!< IPv4 protocols traced for packets
+    uint32_t m_nextId{1};                       //!< Identifier of the next flow
+    Time m_lastUpdate;                          //!< Time of the last update
+};
+
+} // namespace ns3
+
+#endif /* FLUID_FLOW_MANAGER_H */
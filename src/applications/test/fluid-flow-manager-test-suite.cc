@@ -0,0 +1,287 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/application-container.h"
+#include "ns3/bulk-send-application.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/double.h"
+#include "ns3/fluid-flow-manager.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+/**
+ * \file
+ * \ingroup applications-test
+ * FluidFlowManager test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup applications-test
+ *
+ * Network of a source A and a source B connected at 100 Mbps to a router
+ * R, itself connected at 10 Mbps to a destination D.
+ */
+struct FluidFlowTestNetwork
+{
+    FluidFlowTestNetwork();
+
+    NodeContainer nodes;                //!< Nodes A, B, R and D
+    Ipv4InterfaceContainer rInterfaces; //!< Interfaces of R, towards A, B and D
+    Ipv4Address d;                      //!< Address of D
+};
+
+FluidFlowTestNetwork::FluidFlowTestNetwork()
+{
+    nodes.Create(4);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    SimpleNetDeviceHelper link;
+    link.SetNetDevicePointToPointMode(true);
+    link.SetChannelAttribute("Delay", StringValue("1ms"));
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        link.SetDeviceAttribute("DataRate", StringValue(i < 2 ? "100Mbps" : "10Mbps"));
+        Ipv4InterfaceContainer interfaces =
+            addresses.Assign(link.Install(NodeContainer(nodes.Get(i < 2 ? i : 3), nodes.Get(2))));
+        rInterfaces.Add(interfaces.Get(1));
+        d = interfaces.GetAddress(0);
+        addresses.NewNetwork();
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+}
+
+/**
+ * \ingroup applications-test
+ *
+ * Check the paths and the max-min fair rates of the fluid flows.
+ */
+class FluidFlowRatesTestCase : public TestCase
+{
+  public:
+    FluidFlowRatesTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record the end of a fluid flow.
+     * \param sent the bytes transferred by the flow
+     * \param completed whether the flow has completed
+     */
+    void Stopped(uint64_t sent, bool completed);
+    /**
+     * Check the rates of the flows.
+     * \param rates the expected rates of the flows, in Mbps
+     */
+    void CheckRates(std::vector<double> rates);
+
+    Ptr<FluidFlowManager> m_manager; //!< Manager of the fluid flows
+    std::vector<uint32_t> m_flows;   //!< Identifiers of the flows
+    Time m_completion;               //!< Completion time of the flow
+    uint64_t m_sent{0};              //!< Bytes transferred by the completed flow
+};
+
+FluidFlowRatesTestCase::FluidFlowRatesTestCase()
+    : TestCase("Check the max-min fair rates of the fluid flows")
+{
+}
+
+void
+FluidFlowRatesTestCase::Stopped(uint64_t sent, bool completed)
+{
+    NS_TEST_ASSERT_MSG_EQ(completed, true, "The flow has not completed");
+    m_completion = Simulator::Now();
+    m_sent = sent;
+}
+
+void
+FluidFlowRatesTestCase::CheckRates(std::vector<double> rates)
+{
+    for (size_t i = 0; i < rates.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetRate(m_flows[i]).GetBitRate() / 1e6,
+                                  rates[i],
+                                  1e-6,
+                                  "Wrong rate of flow " << i);
+    }
+}
+
+void
+FluidFlowRatesTestCase::DoRun()
+{
+    FluidFlowTestNetwork network;
+    m_manager = CreateObject<FluidFlowManager>();
+    m_manager->SetAttribute("Efficiency", DoubleValue(1));
+
+    Ptr<Node> a = network.nodes.Get(0);
+    Ptr<Node> b = network.nodes.Get(1);
+    NS_TEST_ASSERT_MSG_EQ(m_manager->GetPath(a, network.d).size(), 2, "Wrong path length");
+    NS_TEST_ASSERT_MSG_EQ(m_manager->GetPath(a, "10.9.9.9").size(), 0, "Path to no address");
+
+    // Flow 0, A to D, and flow 1, B to D, share the 10 Mbps link; flow 2,
+    // A to R, takes the capacity left on the link from A to R
+    m_flows.push_back(m_manager->AddFlow(a,
+                                         network.d,
+                                         1000000,
+                                         MakeCallback(&FluidFlowRatesTestCase::Stopped, this)));
+    m_flows.push_back(
+        m_manager->AddFlow(b, network.d, 0, FluidFlowManager::FlowStoppedCallback()));
+    m_flows.push_back(m_manager->AddFlow(a,
+                                         network.rInterfaces.GetAddress(0),
+                                         0,
+                                         FluidFlowManager::FlowStoppedCallback()));
+    NS_TEST_ASSERT_MSG_EQ(m_manager->GetNFlows(), 3, "Flows not added");
+    CheckRates({5, 5, 95});
+
+    // Flow 0 completes after 1.6 s, and flows 1 and 2 then take the whole links
+    Simulator::Schedule(Seconds(2),
+                        &FluidFlowRatesTestCase::CheckRates,
+                        this,
+                        std::vector<double>{0, 10, 100});
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_completion, Seconds(1.6), "Wrong completion time");
+    NS_TEST_ASSERT_MSG_EQ(m_sent, 1000000, "Wrong number of bytes of the completed flow");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_manager->GetBytesSent(m_flows[1]),
+                              1000000 + 1.4 * 10e6 / 8,
+                              1,
+                              "Wrong number of bytes of flow 1");
+    uint64_t sent = m_manager->RemoveFlow(m_flows[2]);
+    NS_TEST_ASSERT_MSG_EQ_TOL(sent,
+                              (1.6 * 95e6 + 1.4 * 100e6) / 8,
+                              1,
+                              "Wrong number of bytes of flow 2");
+    NS_TEST_ASSERT_MSG_EQ(m_manager->GetNFlows(), 1, "Flow not removed");
+    CheckRates({0, 10});
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup applications-test
+ *
+ * Check that a BulkSendApplication sends its data as a fluid flow, and
+ * switches back to packet mode when a packet flow competes with it.
+ */
+class FluidFlowBulkSendTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param compete whether a packet flow competes with the fluid flow
+     */
+    FluidFlowBulkSendTestCase(bool compete);
+
+  private:
+    void DoRun() override;
+
+    bool m_compete; //!< Whether a packet flow competes with the fluid flow
+};
+
+FluidFlowBulkSendTestCase::FluidFlowBulkSendTestCase(bool compete)
+    : TestCase(compete ? "Check a fluid BulkSendApplication with a competing packet flow"
+                       : "Check a fluid BulkSendApplication"),
+      m_compete(compete)
+{
+}
+
+void
+FluidFlowBulkSendTestCase::DoRun()
+{
+    FluidFlowTestNetwork network;
+    Ptr<FluidFlowManager> manager = CreateObject<FluidFlowManager>();
+
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), 9));
+    ApplicationContainer sinks = sinkHelper.Install(network.nodes.Get(3));
+    sinkHelper.SetAttribute("Local", AddressValue(InetSocketAddress(Ipv4Address::GetAny(), 10)));
+    sinks.Add(sinkHelper.Install(network.nodes.Get(3)));
+
+    BulkSendHelper fluidHelper("ns3::TcpSocketFactory", InetSocketAddress(network.d, 9));
+    fluidHelper.SetAttribute("MaxBytes", UintegerValue(10000000));
+    fluidHelper.SetAttribute("FluidFlowManager", PointerValue(manager));
+    ApplicationContainer apps = fluidHelper.Install(network.nodes.Get(0));
+    apps.Start(Seconds(1));
+    if (m_compete)
+    {
+        BulkSendHelper packetHelper("ns3::TcpSocketFactory", InetSocketAddress(network.d, 10));
+        packetHelper.SetAttribute("MaxBytes", UintegerValue(100000));
+        packetHelper.Install(network.nodes.Get(1)).Start(Seconds(2));
+    }
+
+    uint64_t fluidTx = 0;
+    DynamicCast<BulkSendApplication>(apps.Get(0))->TraceConnectWithoutContext(
+        "Tx",
+        MakeBoundCallback(
+            +[](uint64_t* bytes, Ptr<const Packet> p) { *bytes += p->GetSize(); },
+            &fluidTx));
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+
+    uint64_t fluidRx = DynamicCast<PacketSink>(sinks.Get(0))->GetTotalRx();
+    uint64_t packetRx = DynamicCast<PacketSink>(sinks.Get(1))->GetTotalRx();
+    NS_TEST_ASSERT_MSG_EQ(manager->GetNFlows(), 0, "The fluid flow has not stopped");
+    if (m_compete)
+    {
+        // The fluid flow carries 9.5 Mbps until the competing SYN is sent
+        // from R to D, and the remaining bytes are sent as packets
+        NS_TEST_ASSERT_MSG_EQ(packetRx, 100000, "Wrong number of bytes of the packet flow");
+        NS_TEST_ASSERT_MSG_EQ_TOL(fluidRx,
+                                  10000000 - 9.5e6 / 8,
+                                  2000,
+                                  "Wrong number of bytes received after the switch");
+        NS_TEST_ASSERT_MSG_EQ(fluidTx, fluidRx, "Wrong number of bytes sent after the switch");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(fluidTx, 0, "Packets sent by the fluid flow");
+        NS_TEST_ASSERT_MSG_EQ(fluidRx, 0, "Packets received from the fluid flow");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup applications-test
+ *
+ * FluidFlowManager test suite.
+ */
+class FluidFlowManagerTestSuite : public TestSuite
+{
+  public:
+    FluidFlowManagerTestSuite()
+        : TestSuite("fluid-flow-manager", UNIT)
+    {
+        AddTestCase(new FluidFlowRatesTestCase(), TestCase::QUICK);
+        AddTestCase(new FluidFlowBulkSendTestCase(false), TestCase::QUICK);
+        AddTestCase(new FluidFlowBulkSendTestCase(true), TestCase::QUICK);
+    }
+};
+
+static FluidFlowManagerTestSuite
+    g_fluidFlowManagerTestSuite; //!< Static variable for test initialization
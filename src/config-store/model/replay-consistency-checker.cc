@@ -0,0 +1,388 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replay-consistency-checker.h"
+
+#include "attribute-iterator.h"
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <fstream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplayConsistencyChecker");
+
+namespace
+{
+
+/**
+ * \ingroup configstore
+ * Split a checkpoint line into its keyword and the rest of the line.
+ *
+ * \param [in] line The line.
+ * \param [out] rest The text following the keyword and one space.
+ * \return The keyword.
+ */
+std::string
+SplitKeyword(const std::string& line, std::string& rest)
+{
+    std::string::size_type space = line.find(' ');
+    if (space == std::string::npos)
+    {
+        rest.clear();
+        return line;
+    }
+    rest = line.substr(space + 1);
+    return line.substr(0, space);
+}
+
+/**
+ * \ingroup configstore
+ * Split a \c name "value" pair, as written by ConfigStore.
+ *
+ * \param [in] text The text to split.
+ * \param [out] name The name.
+ * \param [out] value The value, without the quotes.
+ */
+void
+SplitNameValue(const std::string& text, std::string& name, std::string& value)
+{
+    std::string::size_type space = text.find(' ');
+    NS_ABORT_MSG_IF(space == std::string::npos || text.size() < space + 3 ||
+                        text[space + 1] != '"' || text.back() != '"',
+                    "Ill-formed checkpoint entry: " << text);
+    name = text.substr(0, space);
+    value = text.substr(space + 2, text.size() - space - 3);
+}
+
+/**
+ * \ingroup configstore
+ * Content of a checkpoint file.
+ */
+struct Checkpoint
+{
+    /// Simulation time step
+    int64_t time{0};
+    /// Number of events executed
+    uint64_t events{0};
+    /// Names and values of the global values
+    std::vector<std::pair<std::string, std::string>> globals;
+    /// Next automatically assigned stream index
+    uint64_t nextStream{0};
+    /// Numbers and RngStream states of the random variable streams
+    std::vector<std::pair<int64_t, std::vector<double>>> rngs;
+    /// Attribute values, by path
+    std::map<std::string, std::string> values;
+};
+
+/**
+ * \ingroup configstore
+ * Read a checkpoint file written by ReplayConsistencyChecker::Save().
+ *
+ * \param [in] filename The checkpoint file name.
+ * \return The content of the checkpoint.
+ */
+Checkpoint
+ReadCheckpoint(const std::string& filename)
+{
+    std::ifstream is(filename);
+    NS_ABORT_MSG_UNLESS(is.is_open(), "Cannot open checkpoint file " << filename);
+
+    Checkpoint checkpoint;
+    for (std::string line; std::getline(is, line);)
+    {
+        std::string rest;
+        std::string keyword = SplitKeyword(line, rest);
+        std::string name;
+        std::string value;
+        if (keyword == "time")
+        {
+            checkpoint.time = std::stoll(rest);
+        }
+        else if (keyword == "events")
+        {
+            checkpoint.events = std::stoull(rest);
+        }
+        else if (keyword == "global")
+        {
+            SplitNameValue(rest, name, value);
+            checkpoint.globals.emplace_back(name, value);
+        }
+        else if (keyword == "nextstream")
+        {
+            checkpoint.nextStream = std::stoull(rest);
+        }
+        else if (keyword == "rng")
+        {
+            std::istringstream iss(rest);
+            int64_t number;
+            iss >> number;
+            std::vector<double> state(6);
+            for (auto& component : state)
+            {
+                uint64_t integer;
+                iss >> integer;
+                component = static_cast<double>(integer);
+            }
+            NS_ABORT_MSG_IF(iss.fail(), "Ill-formed checkpoint entry: " << line);
+            checkpoint.rngs.emplace_back(number, state);
+        }
+        else if (keyword == "value")
+        {
+            SplitNameValue(rest, name, value);
+            checkpoint.values[name] = value;
+        }
+        else if (!keyword.empty())
+        {
+            NS_ABORT_MSG("Unknown checkpoint entry: " << line);
+        }
+    }
+    return checkpoint;
+}
+
+} // namespace
+
+void
+ReplayConsistencyChecker::Save(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ofstream os(filename);
+    NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open checkpoint file " << filename);
+
+    os << "time " << Simulator::Now().GetTimeStep() << std::endl;
+    os << "events " << Simulator::GetEventCount() << std::endl;
+
+    for (auto i = GlobalValue::Begin(); i != GlobalValue::End(); ++i)
+    {
+        StringValue value;
+        (*i)->GetValue(value);
+        os << "global " << (*i)->GetName() << " \"" << value.Get() << "\"" << std::endl;
+    }
+    os << "nextstream " << RngSeedManager::PeekNextStreamIndex() << std::endl;
+
+    for (const auto stream : RandomVariableStream::GetAllStreams())
+    {
+        double state[6];
+        stream->GetRngState(state);
+        os << "rng " << stream->GetStream();
+        for (int i = 0; i < 6; ++i)
+        {
+            // The MRG32k3a state components are integers smaller than 2^32
+            os << " " << static_cast<uint64_t>(state[i]);
+        }
+        os << std::endl;
+    }
+
+    class CheckpointSaveIterator : public AttributeIterator
+    {
+      public:
+        CheckpointSaveIterator(std::ostream& os)
+            : m_os(os)
+        {
+        }
+
+      private:
+        void DoVisitAttribute(Ptr<Object> object, std::string name) override
+        {
+            StringValue str;
+            object->GetAttribute(name, str);
+            m_os << "value " << GetCurrentPath() << " \"" << str.Get() << "\"" << std::endl;
+        }
+
+        std::ostream& m_os;
+    };
+
+    CheckpointSaveIterator iterator(os);
+    iterator.Iterate();
+}
+
+uint32_t
+ReplayConsistencyChecker::Check(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+    Checkpoint checkpoint = ReadCheckpoint(filename);
+
+    uint32_t differences = 0;
+    if (checkpoint.time != Simulator::Now().GetTimeStep())
+    {
+        NS_LOG_WARN("Checkpoint taken at " << TimeStep(checkpoint.time).As(Time::S)
+                                           << ", checked at " << Simulator::Now().As(Time::S));
+        differences++;
+    }
+    if (checkpoint.events != Simulator::GetEventCount())
+    {
+        NS_LOG_WARN("Checkpoint taken after " << checkpoint.events << " events, checked after "
+                                              << Simulator::GetEventCount());
+        differences++;
+    }
+    for (const auto& [name, value] : checkpoint.globals)
+    {
+        StringValue current;
+        if (!GlobalValue::GetValueByNameFailSafe(name, current) || current.Get() != value)
+        {
+            NS_LOG_WARN("Global value " << name << " differs from the checkpoint");
+            differences++;
+        }
+    }
+    if (checkpoint.nextStream != RngSeedManager::PeekNextStreamIndex())
+    {
+        NS_LOG_WARN("Next stream index differs from the checkpoint");
+        differences++;
+    }
+
+    std::list<RandomVariableStream*> streams = RandomVariableStream::GetAllStreams();
+    if (streams.size() != checkpoint.rngs.size())
+    {
+        NS_LOG_WARN("Checkpoint has " << checkpoint.rngs.size()
+                                      << " random variable streams, simulation has "
+                                      << streams.size());
+        differences++;
+    }
+    auto stream = streams.begin();
+    for (auto rng = checkpoint.rngs.begin();
+         rng != checkpoint.rngs.end() && stream != streams.end();
+         ++rng, ++stream)
+    {
+        std::vector<double> state(6);
+        (*stream)->GetRngState(state.data());
+        if (rng->first != (*stream)->GetStream() || rng->second != state)
+        {
+            NS_LOG_WARN("Random variable stream " << (*stream)->GetStream()
+                                                  << " differs from the checkpoint");
+            differences++;
+        }
+    }
+
+    class CheckpointCheckIterator : public AttributeIterator
+    {
+      public:
+        CheckpointCheckIterator(const std::map<std::string, std::string>& values,
+                                uint32_t& differences)
+            : m_values(values),
+              m_differences(differences)
+        {
+        }
+
+      private:
+        void DoVisitAttribute(Ptr<Object> object, std::string name) override
+        {
+            auto it = m_values.find(GetCurrentPath());
+            StringValue str;
+            object->GetAttribute(name, str);
+            if (it == m_values.end() || str.Get() != it->second)
+            {
+                NS_LOG_WARN("Attribute " << GetCurrentPath() << " differs from the checkpoint");
+                m_differences++;
+            }
+        }
+
+        const std::map<std::string, std::string>& m_values;
+        uint32_t& m_differences;
+    };
+
+    CheckpointCheckIterator iterator(checkpoint.values, differences);
+    iterator.Iterate();
+    return differences;
+}
+
+void
+ReplayConsistencyChecker::Apply(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+    Checkpoint checkpoint = ReadCheckpoint(filename);
+
+    NS_ABORT_MSG_IF(checkpoint.time != Simulator::Now().GetTimeStep(),
+                    "Checkpoint taken at " << TimeStep(checkpoint.time).As(Time::S)
+                                           << " cannot be applied at "
+                                           << Simulator::Now().As(Time::S));
+    if (checkpoint.events != Simulator::GetEventCount())
+    {
+        NS_LOG_WARN("Checkpoint taken after " << checkpoint.events << " events, applied after "
+                                              << Simulator::GetEventCount());
+    }
+    for (const auto& [name, value] : checkpoint.globals)
+    {
+        Config::SetGlobalFailSafe(name, StringValue(value));
+    }
+    RngSeedManager::SetNextStreamIndex(checkpoint.nextStream);
+
+    // Attributes are applied first, since setting some of them (e.g.,
+    // RandomVariableStream::Stream) reinitializes the RNG state.
+    class CheckpointApplyIterator : public AttributeIterator
+    {
+      public:
+        CheckpointApplyIterator(const std::map<std::string, std::string>& values)
+            : m_values(values)
+        {
+        }
+
+      private:
+        void DoVisitAttribute(Ptr<Object> object, std::string name) override
+        {
+            auto it = m_values.find(GetCurrentPath());
+            if (it == m_values.end())
+            {
+                NS_LOG_WARN("Attribute " << GetCurrentPath() << " not found in checkpoint");
+                return;
+            }
+            StringValue str;
+            object->GetAttribute(name, str);
+            if (str.Get() != it->second)
+            {
+                NS_LOG_DEBUG("Setting " << GetCurrentPath() << " to " << it->second);
+                if (!object->SetAttributeFailSafe(name, StringValue(it->second)))
+                {
+                    NS_LOG_WARN("Could not set " << GetCurrentPath());
+                }
+            }
+        }
+
+        const std::map<std::string, std::string>& m_values;
+    };
+
+    CheckpointApplyIterator iterator(checkpoint.values);
+    iterator.Iterate();
+
+    std::list<RandomVariableStream*> streams = RandomVariableStream::GetAllStreams();
+    NS_ABORT_MSG_IF(streams.size() != checkpoint.rngs.size(),
+                    "Checkpoint has " << checkpoint.rngs.size()
+                                      << " random variable streams, simulation has "
+                                      << streams.size());
+    auto stream = streams.begin();
+    for (const auto& [number, state] : checkpoint.rngs)
+    {
+        NS_ABORT_MSG_IF(number != (*stream)->GetStream(),
+                        "Checkpoint random variable stream " << number << " does not match stream "
+                                                             << (*stream)->GetStream());
+        (*stream)->SetRngState(state.data());
+        ++stream;
+    }
+}
+
+} // namespace ns3
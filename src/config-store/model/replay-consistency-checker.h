@@ -0,0 +1,103 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLAY_CONSISTENCY_CHECKER_H
+#define REPLAY_CONSISTENCY_CHECKER_H
+
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup configstore
+ *
+ * \brief Check that a replayed simulation reaches the state of a saved one.
+ *
+ * A checkpoint is a raw text file which records, one item per line:
+ *   - the simulation time and the number of events executed so far;
+ *   - the global values, including \c RngSeed and \c RngRun, and the
+ *     next automatically assigned stream index of RngSeedManager;
+ *   - the state of the RngStream of every RandomVariableStream in
+ *     existence, in order of creation;
+ *   - the value of every attribute of every object reachable from the
+ *     root namespace objects (e.g., the NodeList), as saved by ConfigStore.
+ *
+ * Scheduled events are type-erased callbacks which cannot be written to
+ * a file, so a checkpoint does not contain the event queue, and it cannot
+ * resume a simulation in a fresh process, e.g., after a crash.  It is
+ * instead compared with a scenario which has been rebuilt by the same
+ * program and run again up to the checkpoint time, for instance until a
+ * Simulator::Stop() at that time.  Check() reports the entries of the
+ * checkpoint which differ in the replayed simulation, e.g., to find where
+ * a simulation stops being reproducible.  Apply() overwrites the random
+ * number generator state and the attribute values of the replayed
+ * simulation with those of the checkpoint, so that the simulation
+ * continues as the one which was saved, or as a what-if branch of it if
+ * the checkpoint file has been edited.  Apply() aborts if the simulation
+ * time differs from the one of the checkpoint, or if the set of random
+ * variable streams does not match; the events scheduled by the replay
+ * are kept as they are.
+ *
+ * \code
+ *   Simulator::Stop(Seconds(100));
+ *   Simulator::Run();
+ *   ReplayConsistencyChecker::Save("checkpoint.txt");
+ * \endcode
+ *
+ * and, in a later run of the same program:
+ *
+ * \code
+ *   Simulator::Stop(Seconds(100));
+ *   Simulator::Run();
+ *   NS_ABORT_IF(ReplayConsistencyChecker::Check("checkpoint.txt") > 0);
+ *   Simulator::Run();
+ * \endcode
+ */
+class ReplayConsistencyChecker
+{
+  public:
+    /**
+     * Write the state of the simulation to a file.
+     *
+     * \param [in] filename The checkpoint file name.
+     */
+    static void Save(std::string filename);
+
+    /**
+     * Compare the state of the simulation with a file written by Save(),
+     * once the scenario has been rebuilt and replayed up to the time of
+     * the checkpoint.  Each difference is logged as a warning.
+     *
+     * \param [in] filename The checkpoint file name.
+     * \return The number of entries of the checkpoint which differ.
+     */
+    static uint32_t Check(std::string filename);
+
+    /**
+     * Set the global values, random number generator state and attribute
+     * values of the simulation to those of a file written by Save(), once
+     * the scenario has been rebuilt and replayed up to the time of the
+     * checkpoint.
+     *
+     * \param [in] filename The checkpoint file name.
+     */
+    static void Apply(std::string filename);
+};
+
+} // namespace ns3
+
+#endif /* REPLAY_CONSISTENCY_CHECKER_H */
@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/replay-consistency-checker.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup configstore
+ * \defgroup configstore-tests Configuration Store tests
+ */
+
+/**
+ * \ingroup configstore-tests
+ *
+ * \brief Save a checkpoint in a simulation, then replay the simulation,
+ * identically and with a different run number and attribute value, and
+ * check that the differences with the checkpoint are found, and that
+ * applying the checkpoint brings back the random variable streams, the
+ * global values and the attributes.
+ */
+class ReplayConsistencyCheckerTestCase : public TestCase
+{
+  public:
+    ReplayConsistencyCheckerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a scenario which draws a value every second from a random
+     * variable, and save a checkpoint at 1.25 s, or check and apply it.
+     *
+     * \param save whether the checkpoint is saved, or checked and applied
+     * \param max the maximum of the random variable
+     * \param differences the expected number of differences with the checkpoint
+     * \return the values drawn after the checkpoint
+     */
+    std::vector<double> RunScenario(bool save, double max, uint32_t differences = 0);
+
+    /**
+     * Draw a value from the random variable.
+     */
+    void Draw();
+
+    Ptr<UniformRandomVariable> m_variable; //!< The random variable
+    std::vector<double> m_values;          //!< The values drawn
+    std::string m_filename;                //!< The checkpoint file
+    uint64_t m_nextStream;                 //!< The next stream index at the start of the runs
+};
+
+ReplayConsistencyCheckerTestCase::ReplayConsistencyCheckerTestCase()
+    : TestCase("Check the differences with a checkpoint, and that applying it sets the random "
+               "variables and the attributes")
+{
+}
+
+void
+ReplayConsistencyCheckerTestCase::Draw()
+{
+    m_values.push_back(m_variable->GetValue());
+}
+
+std::vector<double>
+ReplayConsistencyCheckerTestCase::RunScenario(bool save, double max, uint32_t differences)
+{
+    // Start each run with the stream indices of a new process
+    RngSeedManager::SetNextStreamIndex(m_nextStream);
+    m_variable = CreateObject<UniformRandomVariable>();
+    m_variable->SetAttribute("Max", DoubleValue(max));
+    m_variable->SetStream(5);
+    Config::RegisterRootNamespaceObject(m_variable);
+    m_values.clear();
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Simulator::Schedule(Seconds(i + 0.5), &ReplayConsistencyCheckerTestCase::Draw, this);
+    }
+
+    Simulator::Stop(Seconds(1.25));
+    Simulator::Run();
+    if (save)
+    {
+        ReplayConsistencyChecker::Save(m_filename);
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(ReplayConsistencyChecker::Check(m_filename),
+                              differences,
+                              "Wrong number of differences with the checkpoint");
+        ReplayConsistencyChecker::Apply(m_filename);
+    }
+    std::size_t drawn = m_values.size();
+    Simulator::Run();
+
+    DoubleValue value;
+    m_variable->GetAttribute("Max", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), 10, "Wrong Max attribute after the checkpoint");
+    Config::UnregisterRootNamespaceObject(m_variable);
+    m_variable = nullptr;
+    Simulator::Destroy();
+    return std::vector<double>(m_values.begin() + drawn, m_values.end());
+}
+
+void
+ReplayConsistencyCheckerTestCase::DoRun()
+{
+    m_filename = CreateTempDirFilename("replay-consistency-checker.txt");
+    uint64_t run = RngSeedManager::GetRun();
+    m_nextStream = RngSeedManager::PeekNextStreamIndex();
+
+    std::vector<double> saved = RunScenario(true, 10);
+    NS_TEST_ASSERT_MSG_EQ(saved.size(), 3, "Wrong number of values drawn after the checkpoint");
+
+    // An identical replay does not differ from the checkpoint
+    std::vector<double> replayed = RunScenario(false, 10);
+    NS_TEST_EXPECT_MSG_EQ((replayed == saved), true, "Wrong values drawn by the replay");
+
+    // This replay draws other values before the checkpoint, and differs by
+    // the run number, the attribute and the state of the random variable,
+    // which are then set by the checkpoint
+    RngSeedManager::SetRun(run + 1);
+    std::vector<double> applied = RunScenario(false, 20, 3);
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), run, "Wrong run number after the checkpoint");
+    NS_TEST_ASSERT_MSG_EQ(applied.size(), saved.size(), "Wrong number of values drawn");
+    for (std::size_t i = 0; i < saved.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(applied[i], saved[i], "Wrong value " << i << " after applying");
+    }
+    RngSeedManager::SetRun(run);
+}
+
+/**
+ * \ingroup configstore-tests
+ *
+ * \brief ReplayConsistencyChecker TestSuite
+ */
+class ReplayConsistencyCheckerTestSuite : public TestSuite
+{
+  public:
+    ReplayConsistencyCheckerTestSuite();
+};
+
+ReplayConsistencyCheckerTestSuite::ReplayConsistencyCheckerTestSuite()
+    : TestSuite("replay-consistency-checker", UNIT)
+{
+    AddTestCase(new ReplayConsistencyCheckerTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static ReplayConsistencyCheckerTestSuite g_replayConsistencyCheckerTestSuite;
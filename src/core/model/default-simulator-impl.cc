@@ -19,12 +19,18 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "boolean.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
+#include <iostream>
 
 /**
  * \file
@@ -48,7 +54,27 @@ DefaultSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("EventProfiling",
+                                          "Measure the wall-clock cost of the executed events, "
+                                          "by event type and context, and report it when "
+                                          "the simulator is destroyed.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_profiling),
+                                          MakeBooleanChecker())
+                            .AddAttribute("EventProfilingSampleInterval",
+                                          "Measure one event out of every this many events; "
+                                          "all the events are counted.",
+                                          UintegerValue(1),
+                                          MakeUintegerAccessor(
+                                              &DefaultSimulatorImpl::m_profilingSampleInterval),
+                                          MakeUintegerChecker<uint32_t>(1))
+                            .AddAttribute("EventProfilingFile",
+                                          "The file the event profiling report is written to. "
+                                          "If empty, the report is written to standard output.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::m_profilingFile),
+                                          MakeStringChecker());
     return tid;
 }
 
@@ -64,6 +90,8 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_eventCount = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
+    m_profiling = false;
+    m_profilingSampleInterval = 1;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
@@ -100,6 +128,21 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        if (m_profilingFile.empty())
+        {
+            m_profiler->Report(std::cout);
+        }
+        else
+        {
+            std::ofstream os(m_profilingFile);
+            NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open event profiling file " << m_profilingFile);
+            m_profiler->Report(os);
+        }
+        m_profiler = nullptr;
+    }
 }
 
 void
@@ -141,7 +184,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, m_currentContext);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -192,6 +242,11 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
+    if (m_profiling && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profilingSampleInterval);
+    }
+
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
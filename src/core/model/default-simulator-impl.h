@@ -20,9 +20,11 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -42,6 +44,10 @@ class Scheduler;
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the \c EventProfiling attribute is set, the wall-clock cost of
+ * the executed events is measured by an EventProfiler and reported
+ * when the simulator is destroyed.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -136,6 +142,15 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Flag \c true if the executed events should be profiled. */
+    bool m_profiling;
+    /** Measure one event out of every m_profilingSampleInterval. */
+    uint32_t m_profilingSampleInterval;
+    /** File the profiling report is written to, or empty for standard output. */
+    std::string m_profilingFile;
+    /** The event profiler, created by Run() when profiling is enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
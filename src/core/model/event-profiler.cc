@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+EventProfiler::EventProfiler(uint32_t sampleInterval)
+    : m_sampleInterval(sampleInterval),
+      m_untilSample(1)
+{
+    NS_ASSERT_MSG(sampleInterval > 0, "The sample interval must be strictly positive");
+}
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    Stats& byType = m_byType[std::type_index(typeid(*event))];
+    Stats& byContext = m_byContext[context];
+    m_total.count++;
+    byType.count++;
+    byContext.count++;
+
+    if (--m_untilSample > 0)
+    {
+        event->Invoke();
+        return;
+    }
+    m_untilSample = m_sampleInterval;
+
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto end = std::chrono::steady_clock::now();
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    m_total.samples++;
+    m_total.wallNs += ns;
+    byType.samples++;
+    byType.wallNs += ns;
+    byContext.samples++;
+    byContext.wallNs += ns;
+}
+
+uint64_t
+EventProfiler::GetEventCount() const
+{
+    return m_total.count;
+}
+
+uint64_t
+EventProfiler::GetSampleCount() const
+{
+    return m_total.samples;
+}
+
+void
+EventProfiler::Report(std::ostream& os) const
+{
+    std::unordered_map<std::string, Stats> byType;
+    for (const auto& [type, stats] : m_byType)
+    {
+        byType[Demangle(type.name())] = stats;
+    }
+    std::unordered_map<std::string, Stats> byContext;
+    for (const auto& [context, stats] : m_byContext)
+    {
+        byContext[context == Simulator::NO_CONTEXT ? "none" : std::to_string(context)] = stats;
+    }
+
+    os << "Event profile: " << m_total.count << " events, " << m_total.samples
+       << " sampled, sampled wall-clock time " << std::fixed << std::setprecision(6)
+       << m_total.wallNs * 1e-9 << " s" << std::endl;
+    ReportTable(os, "event type", byType);
+    ReportTable(os, "context", byContext);
+}
+
+void
+EventProfiler::ReportTable(std::ostream& os,
+                           const std::string& title,
+                           const std::unordered_map<std::string, Stats>& rows) const
+{
+    // Events which were not sampled are assumed to cost the mean of the
+    // sampled events of the same row.
+    auto estimate = [](const Stats& stats) {
+        return stats.samples == 0 ? 0.0
+                                  : static_cast<double>(stats.wallNs) / stats.samples * stats.count;
+    };
+
+    std::vector<std::pair<std::string, Stats>> sorted(rows.begin(), rows.end());
+    std::sort(sorted.begin(), sorted.end(), [&estimate](const auto& a, const auto& b) {
+        double ea = estimate(a.second);
+        double eb = estimate(b.second);
+        return ea != eb ? ea > eb : a.first < b.first;
+    });
+
+    double total = 0;
+    for (const auto& row : sorted)
+    {
+        total += estimate(row.second);
+    }
+
+    os << std::setw(8) << "share" << std::setw(14) << "mean [ns]" << std::setw(14) << "count"
+       << std::setw(14) << "samples"
+       << "  " << title << std::endl;
+    for (const auto& [label, stats] : sorted)
+    {
+        double mean = stats.samples == 0 ? 0.0 : static_cast<double>(stats.wallNs) / stats.samples;
+        double share = total > 0 ? 100 * estimate(stats) / total : 0.0;
+        os << std::fixed << std::setprecision(2) << std::setw(7) << share << "%" << std::setw(14)
+           << std::setprecision(0) << mean << std::setw(14) << stats.count << std::setw(14)
+           << stats.samples << "  " << label << std::endl;
+    }
+}
+
+std::string
+EventProfiler::Demangle(const char* mangled)
+{
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        std::string ret = demangled;
+        std::free(demangled);
+        return ret;
+    }
+#endif
+    return mangled;
+}
+
+} // namespace ns3
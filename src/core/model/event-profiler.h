@@ -0,0 +1,136 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Wall-clock profiler for the events executed by a simulator.
+ *
+ * Each event is invoked through EventProfiler::Invoke(), which counts
+ * it and, for one event out of every \c sampleInterval, measures the
+ * wall-clock time spent in EventImpl::Invoke().  The measurements are
+ * aggregated by the dynamic type of the event implementation (which,
+ * for events built with MakeEvent(), identifies the scheduled function
+ * or method signature) and by event context (normally the node id).
+ *
+ * Whereas DesMetrics records the graph of scheduled events in
+ * simulated time, this class tells where the wall-clock time of a run
+ * is spent.  DefaultSimulatorImpl creates an instance when its
+ * \c EventProfiling attribute is set, and prints the report from
+ * Simulator::Destroy():
+ *
+ * \code
+ *   Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfiling", BooleanValue(true));
+ * \endcode
+ *
+ * The report lists, for each event type and each context, the number
+ * of events executed and sampled, the sampled wall-clock time, the mean
+ * cost of one event and the estimated share of the total run time.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] sampleInterval Measure one event out of every \p sampleInterval.
+     */
+    EventProfiler(uint32_t sampleInterval);
+
+    /**
+     * Invoke an event, accounting for its cost.
+     *
+     * \param [in] event The event to invoke.
+     * \param [in] context The context the event executes in.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /**
+     * \return The number of events invoked through this profiler.
+     */
+    uint64_t GetEventCount() const;
+
+    /**
+     * \return The number of events whose cost was measured.
+     */
+    uint64_t GetSampleCount() const;
+
+    /**
+     * Print the profiling report.
+     *
+     * \param [in,out] os The output stream.
+     */
+    void Report(std::ostream& os) const;
+
+  private:
+    /** Statistics accumulated for one event type or context. */
+    struct Stats
+    {
+        uint64_t count{0};   //!< Events executed.
+        uint64_t samples{0}; //!< Events measured.
+        int64_t wallNs{0};   //!< Wall-clock time of the measured events [ns].
+    };
+
+    /**
+     * Print one table of the report, sorted by decreasing estimated cost.
+     *
+     * \param [in,out] os The output stream.
+     * \param [in] title The key column title.
+     * \param [in] rows The labelled statistics.
+     */
+    void ReportTable(std::ostream& os,
+                     const std::string& title,
+                     const std::unordered_map<std::string, Stats>& rows) const;
+
+    /**
+     * Demangle a type name.
+     *
+     * \param [in] mangled The mangled name.
+     * \return The demangled name, or \p mangled if it cannot be demangled.
+     */
+    static std::string Demangle(const char* mangled);
+
+    uint32_t m_sampleInterval; //!< Measure one event out of every m_sampleInterval.
+    uint32_t m_untilSample;    //!< Events left until the next measured one.
+    Stats m_total;             //!< Statistics over all the events.
+    /** Statistics by event implementation type. */
+    std::unordered_map<std::type_index, Stats> m_byType;
+    /** Statistics by event context. */
+    std::unordered_map<uint32_t, Stats> m_byContext;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
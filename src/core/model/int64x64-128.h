@@ -315,7 +315,14 @@ class int64x64_t
      *
      * \see Invert()
      */
-    void MulByInvert(const int64x64_t& o);
+    inline void MulByInvert(const int64x64_t& o)
+    {
+        // Inline, since this completes most Time unit conversions
+        const bool negResult = _v < 0;
+        const uint128_t a = negResult ? -_v : _v;
+        const uint128_t result = UmulByInvert(a, o._v);
+        _v = negResult ? -result : result;
+    }
 
     /**
      * Compute the inverse of an integer value.
@@ -467,7 +474,17 @@ class int64x64_t
      *
      * \see Invert()
      */
-    static uint128_t UmulByInvert(const uint128_t a, const uint128_t b);
+    static inline uint128_t UmulByInvert(const uint128_t a, const uint128_t b)
+    {
+        const uint128_t ah = a >> 64;
+        const uint128_t bh = b >> 64;
+        const uint128_t al = a & HP_MASK_LO;
+        const uint128_t bl = b & HP_MASK_LO;
+        const uint128_t hi = ah * bh;
+        uint128_t mid = ah * bl + al * bh;
+        mid >>= 64;
+        return hi + mid;
+    }
 
     int128_t _v; //!< The Q64.64 value.
 
@@ -0,0 +1,224 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::LruCache declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ *
+ * \brief A bounded map which evicts its least recently used entries.
+ *
+ * The cache holds at most GetCapacity() entries.  Looking up an entry
+ * with Find() or replacing it with Insert() makes it the most recently
+ * used one; inserting a new entry into a full cache evicts the least
+ * recently used one.  A cache with a zero capacity holds nothing, so
+ * that models can disable their cache by setting its capacity to 0.
+ *
+ * The cache counts the lookups which found their entry (hits) or not
+ * (misses), and the entries evicted to make room for others, so that
+ * models can report how effective their cache is.
+ *
+ * All the operations take constant time on average.
+ *
+ * \tparam K \deduced The key type.
+ * \tparam V \deduced The value type.
+ * \tparam Hash \deduced The hash function of the keys.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] capacity The maximum number of entries.
+     */
+    explicit LruCache(std::size_t capacity = 0)
+        : m_capacity(capacity)
+    {
+    }
+
+    /**
+     * Set the maximum number of entries, evicting the least recently
+     * used entries in excess.
+     *
+     * \param [in] capacity The maximum number of entries.
+     */
+    void SetCapacity(std::size_t capacity)
+    {
+        m_capacity = capacity;
+        while (m_entries.size() > m_capacity)
+        {
+            Evict();
+        }
+    }
+
+    /**
+     * \return The maximum number of entries.
+     */
+    std::size_t GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * \return The number of entries.
+     */
+    std::size_t GetSize() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * Look up an entry, making it the most recently used one.
+     *
+     * \param [in] key The entry key.
+     * \return A pointer to the entry value, valid until the cache is
+     * next modified, or nullptr if the key is not cached.
+     */
+    V* Find(const K& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            m_misses++;
+            return nullptr;
+        }
+        m_hits++;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * Insert or replace an entry, making it the most recently used one.
+     * Nothing is inserted into a cache with a zero capacity.
+     *
+     * \param [in] key The entry key.
+     * \param [in] value The entry value.
+     * \return A pointer to the cached value, valid until the cache is next
+     * modified, or nullptr if the capacity is zero.
+     */
+    V* Insert(const K& key, const V& value)
+    {
+        if (m_capacity == 0)
+        {
+            return nullptr;
+        }
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            it->second->second = value;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return &it->second->second;
+        }
+        if (m_entries.size() == m_capacity)
+        {
+            Evict();
+        }
+        m_entries.emplace_front(key, value);
+        m_index.emplace(key, m_entries.begin());
+        return &m_entries.front().second;
+    }
+
+    /**
+     * Remove an entry.
+     *
+     * \param [in] key The entry key.
+     * \return true if the entry was cached.
+     */
+    bool Erase(const K& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            return false;
+        }
+        m_entries.erase(it->second);
+        m_index.erase(it);
+        return true;
+    }
+
+    /** Remove all the entries, without resetting the statistics. */
+    void Clear()
+    {
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    /**
+     * \return The number of lookups which found their entry.
+     */
+    uint64_t GetHits() const
+    {
+        return m_hits;
+    }
+
+    /**
+     * \return The number of lookups which did not find their entry.
+     */
+    uint64_t GetMisses() const
+    {
+        return m_misses;
+    }
+
+    /**
+     * \return The number of entries evicted because the cache was full.
+     */
+    uint64_t GetEvictions() const
+    {
+        return m_evictions;
+    }
+
+  private:
+    /** Remove the least recently used entry. */
+    void Evict()
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+
+    /** Container of the entries, from the most to the least recently used. */
+    typedef std::list<std::pair<K, V>> Entries;
+
+    std::size_t m_capacity;  //!< The maximum number of entries.
+    Entries m_entries;       //!< The entries, by recency of use.
+    uint64_t m_hits{0};      //!< The number of lookups which found their entry.
+    uint64_t m_misses{0};    //!< The number of lookups which did not find their entry.
+    uint64_t m_evictions{0}; //!< The number of evicted entries.
+    /** The entries by key. */
+    std::unordered_map<K, typename Entries::iterator, Hash> m_index;
+};
+
+} // namespace ns3
+
+#endif /* LRU_CACHE_H */
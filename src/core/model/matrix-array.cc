@@ -190,19 +190,18 @@ MatrixArray<T>::MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
         size_t matrixOffset = page * m_numRows * m_numCols;
         for (size_t resRow = 0; resRow < res.m_numRows; ++resRow)
         {
+            // create intermediate row result, a multiply of resRow row of lMatrix and each
+            // column of this matrix, shared by all the columns of the result
+            std::valarray<T> interRes(m_numCols);
+            for (size_t thisCol = 0; thisCol < m_numCols; ++thisCol)
+            {
+                interRes[thisCol] =
+                    (lMatrix.m_values[std::slice(resRow, lMatrix.m_numCols, lMatrix.m_numRows)] *
+                     m_values[std::slice(matrixOffset + thisCol * m_numRows, m_numRows, 1)])
+                        .sum();
+            }
             for (size_t resCol = 0; resCol < res.m_numCols; ++resCol)
             {
-                // create intermediate row result, a multiply of resRow row of lMatrix and each
-                // column of this matrix
-                std::valarray<T> interRes(m_numCols);
-                for (size_t thisCol = 0; thisCol < m_numCols; ++thisCol)
-                {
-                    interRes[thisCol] =
-                        (lMatrix
-                             .m_values[std::slice(resRow, lMatrix.m_numCols, lMatrix.m_numRows)] *
-                         m_values[std::slice(matrixOffset + thisCol * m_numRows, m_numRows, 1)])
-                            .sum();
-                }
                 // multiply intermediate results and resCol column of the rMatrix
                 res(resRow, resCol, page) =
                     (interRes *
@@ -215,6 +214,52 @@ MatrixArray<T>::MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
     return res;
 }
 
+template <class T>
+MatrixArray<T>
+MatrixArray<T>::CombinePages(const MatrixArray<T>& coefficients) const
+{
+    NS_ASSERT_MSG(coefficients.m_numPages == 1, "The coefficients should have only one page.");
+    NS_ASSERT_MSG(coefficients.m_numRows == m_numPages,
+                  "Coefficients numRows and this MatrixArray numPages mismatch.");
+
+    MatrixArray<T> res{m_numRows, m_numCols, coefficients.m_numCols};
+    size_t pageSize = m_numRows * m_numCols;
+    if (res.GetSize() == 0 || m_numPages == 0)
+    {
+        return res;
+    }
+
+#ifdef HAVE_EIGEN3 // Eigen found and Eigen optimizations enabled
+
+    ConstEigenMatrix<T> pagesEigen(GetPagePtr(0), pageSize, m_numPages);
+    ConstEigenMatrix<T> coefficientsEigen(coefficients.GetPagePtr(0),
+                                          coefficients.m_numRows,
+                                          coefficients.m_numCols);
+    EigenMatrix<T> resEigenMap(res.GetPagePtr(0), pageSize, res.m_numPages);
+    resEigenMap.noalias() = pagesEigen * coefficientsEigen;
+
+#else // Eigen not found or Eigen optimizations not enabled
+
+    // accumulate the pages weighted by each column of coefficients, so that
+    // the innermost loop runs over contiguous elements
+    for (size_t resPage = 0; resPage < res.m_numPages; ++resPage)
+    {
+        T* resPtr = res.GetPagePtr(resPage);
+        for (size_t page = 0; page < m_numPages; ++page)
+        {
+            T coefficient = coefficients(page, resPage);
+            const T* pagePtr = GetPagePtr(page);
+            for (size_t i = 0; i < pageSize; ++i)
+            {
+                resPtr[i] += coefficient * pagePtr[i];
+            }
+        }
+    }
+
+#endif
+    return res;
+}
+
 template <class T>
 template <bool EnableBool, typename>
 MatrixArray<T>
@@ -213,6 +213,23 @@ class MatrixArray : public ValArray<T>
      */
     MatrixArray MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
                                              const MatrixArray<T>& rMatrix) const;
+    /**
+     * \brief Compute linear combinations of the matrices in the array.
+     * Page k of the result is the sum over the pages p of this MatrixArray of
+     * coefficients(p, k) * matrix(p). If "this" has dimensions M x N x P,
+     * coefficients must have P rows and a single page:
+     *
+     * this (MxNxP), coefficients(PxKx1) -> result(MxNxK)
+     *
+     * Since the pages are stored contiguously, all the combinations are
+     * computed by a single matrix multiplication of the (M*N) x P matrix whose
+     * columns are the pages by the coefficients, e.g., to apply the frequency
+     * response of each cluster of a channel to all the frequency bands at once.
+     *
+     * \param coefficients the coefficients of the linear combinations
+     * \returns the MatrixArray of the linear combinations, with dimensions M x N x K
+     */
+    MatrixArray CombinePages(const MatrixArray<T>& coefficients) const;
 
     using ValArray<T>::GetPagePtr;
     using ValArray<T>::EqualDims;
@@ -572,6 +572,16 @@ class Time
 
     inline double ToDouble(Unit unit) const
     {
+        Information* info = PeekInformation(unit);
+
+        NS_ASSERT_MSG(info->isValid, "Attempted a conversion to an unavailable unit.");
+
+        // An integer value converts to the same double as its
+        // int64x64_t representation
+        if (info->toMul && m_data <= info->maxToMul && m_data >= -info->maxToMul)
+        {
+            return static_cast<double>(m_data * info->factor);
+        }
         return To(unit).GetDouble();
     }
 
@@ -581,6 +591,12 @@ class Time
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion to an unavailable unit.");
 
+        // Multiplying by an integer factor is exact, unless it overflows
+        if (info->toMul && m_data <= info->maxToMul && m_data >= -info->maxToMul)
+        {
+            return int64x64_t(m_data * info->factor);
+        }
+
         int64x64_t retval(m_data);
         if (info->toMul)
         {
@@ -635,6 +651,7 @@ class Time
         bool toMul;          //!< Multiply when converting To, otherwise divide
         bool fromMul;        //!< Multiple when converting From, otherwise divide
         int64_t factor;      //!< Ratio of this unit / current unit
+        int64_t maxToMul;    //!< Largest value which can be multiplied by factor
         int64x64_t timeTo;   //!< Multiplier to convert to this unit
         int64x64_t timeFrom; //!< Multiplier to convert from this unit
         bool isValid;        //!< True if the current unit can be used
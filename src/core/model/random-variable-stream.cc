@@ -37,6 +37,7 @@
 #include <algorithm> // upper_bound
 #include <cmath>
 #include <iostream>
+#include <mutex>
 
 /**
  * \file
@@ -51,6 +52,30 @@ NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
+/**
+ * \ingroup randomvariable
+ * The list of all the RandomVariableStream instances, and the mutex which
+ * protects it, since streams may be created and destroyed in several threads.
+ */
+struct RandomVariableStreamInstances
+{
+    std::mutex mutex;                      //!< Protects the list
+    std::list<RandomVariableStream*> list; //!< The instances, in order of creation
+};
+
+/**
+ * \ingroup randomvariable
+ * Get the list of all the RandomVariableStream instances.
+ * \return The list of instances and its mutex.
+ */
+static RandomVariableStreamInstances&
+GetInstances()
+{
+    // Never destroyed, since instances may outlive static destruction
+    static auto instances = new RandomVariableStreamInstances;
+    return *instances;
+}
+
 TypeId
 RandomVariableStream::GetTypeId()
 {
@@ -77,14 +102,23 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_rngIndex(0)
 {
     NS_LOG_FUNCTION(this);
+    auto& instances = GetInstances();
+    std::unique_lock lock{instances.mutex};
+    m_instance = instances.list.insert(instances.list.end(), this);
 }
 
 RandomVariableStream::~RandomVariableStream()
 {
     NS_LOG_FUNCTION(this);
+    {
+        auto& instances = GetInstances();
+        std::unique_lock lock{instances.mutex};
+        instances.list.erase(m_instance);
+    }
     delete m_rng;
 }
 
@@ -123,6 +157,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rngIndex = nextStream;
     }
     else
     {
@@ -131,6 +166,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rngIndex = target;
     }
     m_stream = stream;
 }
@@ -149,6 +185,65 @@ RandomVariableStream::Peek() const
     return m_rng;
 }
 
+void
+RandomVariableStream::GetRngState(double state[6]) const
+{
+    NS_LOG_FUNCTION(this);
+    m_rng->GetState(state);
+}
+
+void
+RandomVariableStream::SetRngState(const double state[6])
+{
+    NS_LOG_FUNCTION(this);
+    m_rng->SetState(state);
+}
+
+void
+RandomVariableStream::SetSubstream(uint64_t substream)
+{
+    NS_LOG_FUNCTION(this << substream);
+    NS_ASSERT_MSG(substream < (uint64_t{1} << 51),
+                  "The substream " << substream << " overlaps the following streams");
+    delete m_rng;
+    m_rng = new RngStream(RngSeedManager::GetSeed(), m_rngIndex, substream);
+    DiscardCachedValues();
+}
+
+void
+RandomVariableStream::DiscardCachedValues()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::list<RandomVariableStream*>
+RandomVariableStream::GetAllStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    auto& instances = GetInstances();
+    std::unique_lock lock{instances.mutex};
+    return instances.list;
+}
+
+void
+RandomVariableStream::ResetAllStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    auto& instances = GetInstances();
+    std::unique_lock lock{instances.mutex};
+    for (auto stream : instances.list)
+    {
+        if (stream->m_rng == nullptr)
+        {
+            continue;
+        }
+        delete stream->m_rng;
+        stream->m_rng = new RngStream(RngSeedManager::GetSeed(),
+                                      stream->m_rngIndex,
+                                      RngSeedManager::GetRun());
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId
@@ -711,6 +806,13 @@ NormalRandomVariable::GetBound() const
     return m_bound;
 }
 
+void
+NormalRandomVariable::DiscardCachedValues()
+{
+    NS_LOG_FUNCTION(this);
+    m_nextValid = false;
+}
+
 double
 NormalRandomVariable::GetValue(double mean, double variance, double bound)
 {
@@ -823,6 +925,13 @@ LogNormalRandomVariable::GetSigma() const
     return m_sigma;
 }
 
+void
+LogNormalRandomVariable::DiscardCachedValues()
+{
+    NS_LOG_FUNCTION(this);
+    m_nextValid = false;
+}
+
 // The code from this function was adapted from the GNU Scientific
 // Library 1.8:
 /* randist/lognormal.c
@@ -956,6 +1065,13 @@ GammaRandomVariable::GetBeta() const
     return m_beta;
 }
 
+void
+GammaRandomVariable::DiscardCachedValues()
+{
+    NS_LOG_FUNCTION(this);
+    m_nextValid = false;
+}
+
 /*
   The code for the following generator functions was adapted from ns-2
   tools/ranvar.cc
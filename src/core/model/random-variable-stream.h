@@ -30,6 +30,7 @@
 #include "object.h"
 #include "type-id.h"
 
+#include <list>
 #include <map>
 #include <stdint.h>
 
@@ -154,6 +155,64 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * \brief Get the state of the underlying RngStream.
+     * \param [out] state The RNG state vector.
+     * \see RngStream::GetState()
+     */
+    void GetRngState(double state[6]) const;
+
+    /**
+     * \brief Set the state of the underlying RngStream.
+     * \param [in] state The RNG state vector.
+     * \see RngStream::SetState()
+     */
+    void SetRngState(const double state[6]);
+
+    /**
+     * \brief Restart the underlying RngStream at the beginning of a substream.
+     *
+     * The values are normally drawn from the substream numbered by the
+     * run number (see RngSeedManager::SetRun()).  A model can instead draw
+     * the values of an item, such as the channel between two nodes, from a
+     * substream numbered after the run and the item, to draw the same
+     * values each time it generates the item again, whatever it generated
+     * in between.  The values cached by the distribution, such as the
+     * second value of a NormalRandomVariable pair, are discarded.
+     *
+     * A stream holds 2^51 substreams: a larger substream number would
+     * overlap the values of the following streams.  The substreams from
+     * 2^50 are not used by the run numbers in practice, and are left to
+     * the items.
+     *
+     * \param [in] substream The substream number, lower than 2^51.
+     */
+    void SetSubstream(uint64_t substream);
+
+    /**
+     * \brief Get all the RandomVariableStream instances in existence.
+     *
+     * This is used to save and restore the state of all the random
+     * number generators of a simulation.  Instances may be created and
+     * destroyed in any thread, but the returned pointers are only valid
+     * as long as no other thread destroys the instances.
+     * \return The instances, in order of creation.
+     */
+    static std::list<RandomVariableStream*> GetAllStreams();
+
+    /**
+     * \brief Restart all the RandomVariableStream instances in existence
+     * from the beginning of their stream, for the current seed and run.
+     *
+     * Each instance keeps its stream index, so the values drawn next
+     * are those of a new instance created with the same stream number
+     * after RngSeedManager::SetSeed() or RngSeedManager::SetRun().
+     * Values cached by the distributions (such as the second value of
+     * a NormalRandomVariable pair) are not discarded.
+     * \see WarmStart
+     */
+    static void ResetAllStreams();
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -161,6 +220,14 @@ class RandomVariableStream : public Object
      */
     RngStream* Peek() const;
 
+    /**
+     * \brief Discard the values cached by the distribution, which were
+     * drawn from the previous state of the underlying RngStream.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void DiscardCachedValues();
+
   private:
     /** Pointer to the underlying RngStream. */
     RngStream* m_rng;
@@ -171,6 +238,12 @@ class RandomVariableStream : public Object
     /** The stream number for the RngStream. */
     int64_t m_stream;
 
+    /** The index of the underlying RngStream, derived from m_stream. */
+    uint64_t m_rngIndex;
+
+    /** The position of this instance in the list of all instances. */
+    std::list<RandomVariableStream*>::iterator m_instance;
+
 }; // class RandomVariableStream
 
 /**
@@ -1019,6 +1092,10 @@ class NormalRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    // Inherited
+    void DiscardCachedValues() override;
+
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
     double m_mean;
@@ -1170,6 +1247,10 @@ class LogNormalRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    // Inherited
+    void DiscardCachedValues() override;
+
   private:
     /** The mu value for the log-normal distribution returned by this RNG stream. */
     double m_mu;
@@ -1283,6 +1364,10 @@ class GammaRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    // Inherited
+    void DiscardCachedValues() override;
+
   private:
     /**
      * \brief Returns a random double from a normal distribution with the specified mean, variance,
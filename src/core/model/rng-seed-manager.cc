@@ -112,4 +112,18 @@ RngSeedManager::GetNextStreamIndex()
     return next;
 }
 
+uint64_t
+RngSeedManager::PeekNextStreamIndex()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return g_nextStreamIndex;
+}
+
+void
+RngSeedManager::SetNextStreamIndex(uint64_t next)
+{
+    NS_LOG_FUNCTION(next);
+    g_nextStreamIndex = next;
+}
+
 } // namespace ns3
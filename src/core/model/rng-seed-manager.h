@@ -104,6 +104,22 @@ class RngSeedManager
      * \returns The next stream index.
      */
     static uint64_t GetNextStreamIndex();
+
+    /**
+     * Get the next automatically assigned stream index, without
+     * assigning it.
+     * \returns The next stream index.
+     */
+    static uint64_t PeekNextStreamIndex();
+
+    /**
+     * Set the next automatically assigned stream index.
+     *
+     * This is only meant to restore a value previously obtained with
+     * PeekNextStreamIndex(), for example when restoring a checkpoint.
+     * \param [in] next The next stream index.
+     */
+    static void SetNextStreamIndex(uint64_t next);
 };
 
 /** Alias for compatibility. */
@@ -71,6 +71,20 @@ class RngStream
      */
     double RandU01();
 
+    /**
+     * Get the current state of this stream.
+     *
+     * \param [out] state The RNG state vector.
+     */
+    void GetState(double state[6]) const;
+
+    /**
+     * Set the current state of this stream, as returned by GetState().
+     *
+     * \param [in] state The RNG state vector.
+     */
+    void SetState(const double state[6]);
+
   private:
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
@@ -260,6 +260,7 @@ Time::SetResolution(Unit unit, Resolution* resolution, const bool convert /* = t
                             UNIT_COEFF[(int)unit];
         NS_LOG_DEBUG("SetResolution factor " << factor << " real factor " << realFactor);
         info->factor = factor;
+        info->maxToMul = std::numeric_limits<int64_t>::max() / factor;
         // here we could equivalently check for realFactor == 1.0 but it's better
         // to avoid checking equality of doubles
         if (shift == 0 && quotient == 1)
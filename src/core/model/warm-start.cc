@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "warm-start.h"
+
+#include "fatal-error.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::WarmStart implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WarmStart");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Write a buffer to a file descriptor, retrying on short writes.
+ * \param [in] fd The file descriptor.
+ * \param [in] data The buffer.
+ * \return \c true if the whole buffer was written.
+ */
+bool
+WriteAll(int fd, const std::string& data)
+{
+    std::size_t written = 0;
+    while (written < data.size())
+    {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
+
+} // unnamed namespace
+
+std::vector<std::string>
+WarmStart::Fork(const std::vector<uint64_t>& runs, Replication replication, uint32_t maxProcesses)
+{
+    NS_LOG_FUNCTION(runs.size() << maxProcesses);
+    NS_ABORT_MSG_IF(Simulator::Now().IsStrictlyPositive(),
+                    "WarmStart::Fork() must be called before the simulation starts");
+
+    if (maxProcesses == 0)
+    {
+        maxProcesses = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    /** A running replication. */
+    struct Child
+    {
+        std::size_t index; //!< Index of the replication in runs.
+        int fd;            //!< Read end of the results pipe.
+    };
+
+    std::map<pid_t, Child> children;
+    std::vector<std::string> results(runs.size());
+    std::vector<std::string> failures;
+    std::size_t next = 0;
+
+    while (next < runs.size() || !children.empty())
+    {
+        // Start replications up to the process limit
+        while (next < runs.size() && children.size() < maxProcesses)
+        {
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed: " << std::strerror(errno));
+            // Buffered output would otherwise be written by both processes
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "fork() failed: " << std::strerror(errno));
+            if (pid == 0)
+            {
+                close(fds[0]);
+                RngSeedManager::SetRun(runs[next]);
+                RandomVariableStream::ResetAllStreams();
+                std::string result = replication(runs[next]);
+                Simulator::Destroy();
+                bool ok = WriteAll(fds[1], result);
+                close(fds[1]);
+                std::cout.flush();
+                std::cerr.flush();
+                std::fflush(nullptr);
+                // Skip the static destructors, which belong to the parent
+                _exit(ok ? 0 : 1);
+            }
+            NS_LOG_LOGIC("Run " << runs[next] << " started in process " << pid);
+            close(fds[1]);
+            children[pid] = {next, fds[0]};
+            next++;
+        }
+
+        // Read the results of the running replications until one ends
+        std::vector<pollfd> fds;
+        std::vector<pid_t> pids;
+        for (const auto& [pid, child] : children)
+        {
+            fds.push_back({child.fd, POLLIN, 0});
+            pids.push_back(pid);
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "poll() failed: " << std::strerror(errno));
+            continue;
+        }
+        for (std::size_t i = 0; i < fds.size(); i++)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            Child& child = children[pids[i]];
+            char buffer[4096];
+            ssize_t n = read(child.fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                results[child.index].append(buffer, n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            // End of file: the replication is over
+            close(child.fd);
+            int status;
+            while (waitpid(pids[i], &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            uint64_t run = runs[child.index];
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                failures.push_back(std::to_string(run));
+            }
+            NS_LOG_LOGIC("Run " << run << " ended with status " << status);
+            children.erase(pids[i]);
+        }
+    }
+
+    if (!failures.empty())
+    {
+        std::string list;
+        for (const auto& run : failures)
+        {
+            list += (list.empty() ? "" : ", ") + run;
+        }
+        NS_FATAL_ERROR("WarmStart::Fork(): replications failed for RngRun " << list);
+    }
+    return results;
+}
+
+} // namespace ns3
@@ -0,0 +1,103 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include "callback.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::WarmStart declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Run independent replications of a scenario built only once.
+ *
+ * Building a large scenario (creating the nodes, installing the
+ * protocol stacks and applications, populating the routing tables,
+ * connecting the traces) can take longer than a short simulation.
+ * When the same scenario is run for many values of \c RngRun, Fork()
+ * lets the scenario be built once, and then forks one process per
+ * replication.  Each child process sets \c RngRun to the value of its
+ * replication, resets all the existing random variable streams for the
+ * new run (see RandomVariableStream::ResetAllStreams()), and calls the
+ * replication callback, which typically calls Simulator::Run() and
+ * returns a summary of the results.  The parent gathers these strings,
+ * in the order of the runs.
+ *
+ * \code
+ *   // build the scenario, without drawing random numbers
+ *   ...
+ *   auto replication = [&sink](uint64_t run) {
+ *       Simulator::Stop(Seconds(10));
+ *       Simulator::Run();
+ *       return std::to_string(sink->GetTotalRx());
+ *   };
+ *   std::vector<std::string> results =
+ *       WarmStart::Fork({1, 2, 3, 4}, MakeCallback<std::string, uint64_t>(replication));
+ * \endcode
+ *
+ * A replication is identical to a run of the same program with the same
+ * \c RngRun only if no random number was drawn while building the
+ * scenario; values drawn before Fork() are common to all the replications.
+ * The process must not have other threads running when Fork() is called,
+ * and the simulation must not have been started yet.
+ *
+ * Fork() is only available on POSIX systems.
+ */
+class WarmStart
+{
+  public:
+    /**
+     * Callback which runs one replication in a child process.
+     * Its argument is the \c RngRun value of the replication, and it
+     * returns the results of the replication.
+     */
+    typedef Callback<std::string, uint64_t> Replication;
+
+    /**
+     * Run one replication of the simulation per \c RngRun value, each in
+     * a child process.
+     *
+     * Simulator::Destroy() is called in the child process after the
+     * replication callback returns.  The function aborts if a child
+     * process does not terminate normally.
+     *
+     * \param [in] runs The \c RngRun values of the replications.
+     * \param [in] replication The callback running one replication.
+     * \param [in] maxProcesses The maximum number of child processes
+     *             running at the same time, or zero for the number of
+     *             hardware threads.
+     * \return The results of the replications, in the order of \p runs.
+     */
+    static std::vector<std::string> Fork(const std::vector<uint64_t>& runs,
+                                         Replication replication,
+                                         uint32_t maxProcesses = 0);
+};
+
+} // namespace ns3
+
+#endif /* WARM_START_H */
@@ -0,0 +1,128 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/lru-cache.h"
+#include "ns3/test.h"
+
+#include <string>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * LruCache test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup core-tests
+ * Check the lookups, replacements and evictions of LruCache.
+ */
+class LruCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LruCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LruCacheTestCase::LruCacheTestCase()
+    : TestCase("Check the least recently used entries are evicted")
+{
+}
+
+void
+LruCacheTestCase::DoRun()
+{
+    LruCache<int, std::string> cache;
+    NS_TEST_ASSERT_MSG_EQ((cache.Insert(1, "one") == nullptr),
+                          true,
+                          "A zero capacity cache must not return an entry");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 0, "A zero capacity cache must stay empty");
+
+    cache.SetCapacity(3);
+    cache.Insert(1, "one");
+    cache.Insert(2, "two");
+    NS_TEST_ASSERT_MSG_EQ(*cache.Insert(3, "three"), "three", "Wrong inserted value");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 3, "Wrong size");
+
+    // 1 becomes the most recently used entry, so 2 is evicted by 4
+    NS_TEST_ASSERT_MSG_EQ(*cache.Find(1), "one", "Wrong value");
+    cache.Insert(4, "four");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 3, "Wrong size after eviction");
+    NS_TEST_ASSERT_MSG_EQ((cache.Find(2) == nullptr),
+                          true,
+                          "The least recently used entry is not evicted");
+    NS_TEST_ASSERT_MSG_EQ(*cache.Find(3), "three", "Wrong value");
+
+    // Replacing 1 makes it the most recently used entry, so 4 is evicted by 5
+    cache.Insert(1, "uno");
+    cache.Insert(5, "five");
+    NS_TEST_ASSERT_MSG_EQ((cache.Find(4) == nullptr),
+                          true,
+                          "The least recently used entry is not evicted");
+    NS_TEST_ASSERT_MSG_EQ(*cache.Find(1), "uno", "The value is not replaced");
+
+    NS_TEST_ASSERT_MSG_EQ(cache.Erase(3), true, "The entry is not erased");
+    NS_TEST_ASSERT_MSG_EQ(cache.Erase(3), false, "The entry is erased twice");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 2, "Wrong size after erasure");
+
+    // Shrinking keeps the most recently used entry, 1
+    cache.SetCapacity(1);
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 1, "Wrong size after shrinking");
+    NS_TEST_ASSERT_MSG_EQ((cache.Find(5) == nullptr),
+                          true,
+                          "The least recently used entry is kept");
+    NS_TEST_ASSERT_MSG_EQ(*cache.Find(1), "uno", "The most recently used entry is evicted");
+
+    NS_TEST_ASSERT_MSG_EQ(cache.GetHits(), 4, "Wrong number of hits");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetMisses(), 3, "Wrong number of misses");
+    NS_TEST_ASSERT_MSG_EQ(cache.GetEvictions(), 3, "Wrong number of evictions");
+
+    cache.Clear();
+    NS_TEST_ASSERT_MSG_EQ(cache.GetSize(), 0, "The cache is not cleared");
+    NS_TEST_ASSERT_MSG_EQ((cache.Find(1) == nullptr), true, "The cache is not cleared");
+}
+
+/**
+ * \ingroup core-tests
+ * LruCache test suite.
+ */
+class LruCacheTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    LruCacheTestSuite()
+        : TestSuite("lru-cache", UNIT)
+    {
+        AddTestCase(new LruCacheTestCase());
+    }
+};
+
+/**
+ * \ingroup core-tests
+ * LruCacheTestSuite instance variable.
+ */
+static LruCacheTestSuite g_lruCacheTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
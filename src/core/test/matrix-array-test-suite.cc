@@ -425,6 +425,32 @@ MatrixArrayTestCase<T>::DoRun()
     NS_LOG_INFO("m22:" << m22);
     NS_LOG_INFO("m24 = m20 * m22 * m21" << m24);
 
+    // test CombinePages: each page of the result is a linear combination of
+    // the pages of m22, weighted by a column of the coefficients
+    std::valarray<int> coefficients{1, 2, 0, 1, 3, 1};
+    std::valarray<T> coefficientsCasted(coefficients.size());
+    for (size_t i = 0; i < coefficients.size(); ++i)
+    {
+        coefficientsCasted[i] = static_cast<T>(coefficients[i]);
+    }
+    MatrixArray<T> m28 = MatrixArray<T>(2, 3, coefficientsCasted);
+    MatrixArray<T> m29 = m22.CombinePages(m28);
+    MatrixArray<T> m30 = MatrixArray<T>(3, 4, 3);
+    for (size_t page = 0; page < m30.GetNumPages(); ++page)
+    {
+        for (size_t row = 0; row < m30.GetNumRows(); ++row)
+        {
+            for (size_t col = 0; col < m30.GetNumCols(); ++col)
+            {
+                m30(row, col, page) = m28(0, page) * m22(row, col, 0) +
+                                      m28(1, page) * m22(row, col, 1);
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(m29, m30, "The matrices should be equal.");
+    NS_LOG_INFO("m28:" << m28);
+    NS_LOG_INFO("m29 = m22 combined by m28" << m29);
+
     // test initialization with moving
     size_t lCastedSize = lCasted.size();
     NS_LOG_INFO("size() of lCasted before move: " << lCasted.size());
@@ -2566,6 +2566,53 @@ NormalCachingTestCase::DoRun()
     NS_TEST_ASSERT_MSG_GT(v2, 0, "Incorrect value returned, expected > 0");
 }
 
+/**
+ * \ingroup rng-tests
+ * Test case for restarting random variable streams at a substream
+ */
+class SubstreamTestCase : public TestCaseBase
+{
+  public:
+    // Constructor
+    SubstreamTestCase();
+
+  private:
+    // Inherited
+    void DoRun() override;
+};
+
+SubstreamTestCase::SubstreamTestCase()
+    : TestCaseBase("RandomVariableStream restart at a substream")
+{
+}
+
+void
+SubstreamTestCase::DoRun()
+{
+    NS_LOG_FUNCTION(this);
+    SetTestSuiteSeed();
+
+    Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable>();
+    Ptr<NormalRandomVariable> n = CreateObject<NormalRandomVariable>();
+    u->SetSubstream(12345);
+    n->SetSubstream(12345);
+    double u1 = u->GetValue();
+    double n1 = n->GetValue(); // the second value of the pair is cached
+
+    // Draw other values from another substream, then restart the first one
+    u->SetSubstream(54321);
+    n->SetSubstream(54321);
+    double u2 = u->GetValue();
+    double n2 = n->GetValue();
+    NS_TEST_ASSERT_MSG_NE(u1, u2, "The substreams are not independent");
+    NS_TEST_ASSERT_MSG_NE(n1, n2, "The substreams are not independent");
+
+    u->SetSubstream(12345);
+    n->SetSubstream(12345);
+    NS_TEST_ASSERT_MSG_EQ(u->GetValue(), u1, "The substream did not restart");
+    NS_TEST_ASSERT_MSG_EQ(n->GetValue(), n1, "The cached normal value was not discarded");
+}
+
 /**
  * \ingroup rng-tests
  * Test case for bernoulli distribution random variable stream generator
@@ -2924,6 +2971,7 @@ RandomVariableSuite::RandomVariableSuite()
     AddTestCase(new EmpiricalAntitheticTestCase);
     /// Issue #302:  NormalRandomVariable produces stale values
     AddTestCase(new NormalCachingTestCase);
+    AddTestCase(new SubstreamTestCase);
     AddTestCase(new BernoulliTestCase);
     AddTestCase(new BernoulliAntitheticTestCase);
     AddTestCase(new BinomialTestCase);
@@ -16,14 +16,21 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <fstream>
+#include <sstream>
+
 using namespace ns3;
 
 /**
@@ -707,6 +714,82 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the EventProfiler accounting and report.
+ */
+class SimulatorEventProfilerTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfilerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Test event. */
+    void Event();
+
+    uint32_t m_invoked; //!< Number of test events invoked.
+};
+
+SimulatorEventProfilerTestCase::SimulatorEventProfilerTestCase()
+    : TestCase("Check the event profiler"),
+      m_invoked(0)
+{
+}
+
+void
+SimulatorEventProfilerTestCase::Event()
+{
+    m_invoked++;
+}
+
+void
+SimulatorEventProfilerTestCase::DoRun()
+{
+    EventProfiler profiler(2);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        EventImpl* event = MakeEvent(&SimulatorEventProfilerTestCase::Event, this);
+        profiler.Invoke(event, i < 3 ? 7 : Simulator::NO_CONTEXT);
+        event->Unref();
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_invoked, 5, "Not all the events were invoked");
+    NS_TEST_EXPECT_MSG_EQ(profiler.GetEventCount(), 5, "Wrong number of events counted");
+    NS_TEST_EXPECT_MSG_EQ(profiler.GetSampleCount(), 3, "Wrong number of events sampled");
+
+    std::ostringstream oss;
+    profiler.Report(oss);
+    std::string report = oss.str();
+    NS_TEST_EXPECT_MSG_NE(report.find("SimulatorEventProfilerTestCase"),
+                          std::string::npos,
+                          "Event type missing from the report");
+    NS_TEST_EXPECT_MSG_NE(report.find("  7\n"), std::string::npos, "Context missing");
+    NS_TEST_EXPECT_MSG_NE(report.find("  none\n"), std::string::npos, "No context missing");
+
+    // Profile a run of the default simulator implementation
+    std::string file = CreateTempDirFilename("event-profile.txt");
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfiling", BooleanValue(true));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfilingFile", StringValue(file));
+    m_invoked = 0;
+    Simulator::Schedule(Seconds(1), &SimulatorEventProfilerTestCase::Event, this);
+    Simulator::ScheduleWithContext(3, Seconds(2), &SimulatorEventProfilerTestCase::Event, this);
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfiling", BooleanValue(false));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfilingFile", StringValue(""));
+    NS_TEST_EXPECT_MSG_EQ(m_invoked, 2, "Not all the events were invoked");
+
+    std::ifstream is(file);
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), true, "Profiling report not written");
+    std::string header;
+    std::getline(is, header);
+    NS_TEST_EXPECT_MSG_EQ(header.find("Event profile: 2 events, 2 sampled"),
+                          0,
+                          "Unexpected report header " << header);
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +813,7 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new SimulatorEventProfilerTestCase(), TestCase::QUICK);
     }
 };
 
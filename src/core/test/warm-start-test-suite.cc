@@ -0,0 +1,145 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/warm-start.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * WarmStart test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup core-tests
+ * Check that forked replications match cold runs with the same RngRun.
+ */
+class WarmStartTestCase : public TestCase
+{
+  public:
+    WarmStartTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run one replication: draw values from the stream during the simulation.
+     * \param [in] run The RngRun value.
+     * \return The values drawn.
+     */
+    std::string Replication(uint64_t run);
+
+    /** Draw one value from the stream. */
+    void Draw();
+
+    Ptr<UniformRandomVariable> m_random; //!< The random variable stream.
+    std::ostringstream m_values;         //!< The values drawn.
+};
+
+WarmStartTestCase::WarmStartTestCase()
+    : TestCase("Check forked replications")
+{
+}
+
+void
+WarmStartTestCase::Draw()
+{
+    m_values << m_random->GetInteger() << " ";
+}
+
+std::string
+WarmStartTestCase::Replication(uint64_t /* run */)
+{
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), &WarmStartTestCase::Draw, this);
+    }
+    Simulator::Run();
+    return m_values.str();
+}
+
+void
+WarmStartTestCase::DoRun()
+{
+    uint64_t savedRun = RngSeedManager::GetRun();
+
+    // The scenario is built once, without drawing any value
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(11);
+    m_random->SetAttribute("Max", DoubleValue(1000000));
+
+    std::vector<std::string> results =
+        WarmStart::Fork({1, 2, 1},
+                        MakeCallback(&WarmStartTestCase::Replication, this),
+                        2);
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 3, "One result per replication");
+    NS_TEST_EXPECT_MSG_EQ(results[0], results[2], "Same run, same values");
+    NS_TEST_EXPECT_MSG_NE(results[0], results[1], "Different runs, different values");
+
+    // The parent process is unaffected by the replications
+    NS_TEST_EXPECT_MSG_EQ(m_values.str(), "", "The parent did not draw any value");
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), savedRun, "The parent run is unchanged");
+
+    // A cold run with the same RngRun draws the same values
+    RngSeedManager::SetRun(2);
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(11);
+    m_random->SetAttribute("Max", DoubleValue(1000000));
+    NS_TEST_EXPECT_MSG_EQ(Replication(2), results[1], "The replication matches a cold run");
+    Simulator::Destroy();
+
+    RngSeedManager::SetRun(savedRun);
+    m_random = nullptr;
+}
+
+/**
+ * \ingroup core-tests
+ * WarmStart test suite.
+ */
+class WarmStartTestSuite : public TestSuite
+{
+  public:
+    WarmStartTestSuite();
+};
+
+WarmStartTestSuite::WarmStartTestSuite()
+    : TestSuite("warm-start", UNIT)
+{
+    AddTestCase(new WarmStartTestCase);
+}
+
+/**
+ * \ingroup core-tests
+ * WarmStartTestSuite instance variable.
+ */
+static WarmStartTestSuite g_warmStartTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
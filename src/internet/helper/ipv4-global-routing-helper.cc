@@ -67,9 +67,7 @@ Ipv4GlobalRoutingHelper::PopulateRoutingTables()
 void
 Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
 {
-    GlobalRouteManager::DeleteGlobalRoutes();
-    GlobalRouteManager::BuildGlobalRoutingDatabase();
-    GlobalRouteManager::InitializeRoutes();
+    GlobalRouteManager::UpdateRoutes();
 }
 
 } // namespace ns3
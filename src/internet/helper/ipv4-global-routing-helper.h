@@ -87,6 +87,8 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * Only the routes of the routers connected to a link whose state changed
+     * are recomputed; the other routers keep their routes.
      */
     static void RecomputeRoutingTables();
 };
@@ -30,6 +30,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -199,9 +202,11 @@ ArpCache::HandleWaitReplyTimeout()
     NS_LOG_FUNCTION(this);
     ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // Only the entries in WaitReply state are visited, in address order
+    std::vector<Ipv4Address> waitReply(m_waitReply.begin(), m_waitReply.end());
+    for (const auto& address : waitReply)
     {
-        entry = (*i).second;
+        entry = Lookup(address);
         if (entry != nullptr && entry->IsWaitReply())
         {
             if (entry->GetRetries() < m_maxRetries)
@@ -250,6 +255,7 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_waitReply.clear();
     if (m_waitReplyTimer.IsRunning())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -264,7 +270,9 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // Print the entries in address order
+    std::map<Ipv4Address, ArpCache::Entry*> sorted(m_arpCache.begin(), m_arpCache.end());
+    for (auto i = sorted.begin(); i != sorted.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -333,6 +341,10 @@ ArpCache::LookupInverse(Address to)
             entryList.push_back(entry);
         }
     }
+    // Return the entries in address order, whatever the hash table order
+    entryList.sort([](const ArpCache::Entry* a, const ArpCache::Entry* b) {
+        return a->GetIpv4Address() < b->GetIpv4Address();
+    });
     return entryList;
 }
 
@@ -365,15 +377,14 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
-        }
+        m_arpCache.erase(i);
+        m_waitReply.erase(entry->GetIpv4Address());
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
     }
     NS_LOG_WARN("Entry not found in this ARP Cache");
 }
@@ -426,6 +437,7 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
+    m_arp->m_waitReply.erase(m_ipv4Address);
     m_state = DEAD;
     ClearRetries();
     UpdateSeen();
@@ -436,6 +448,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
+    m_arp->m_waitReply.erase(m_ipv4Address);
     m_macAddress = macAddress;
     m_state = ALIVE;
     ClearRetries();
@@ -448,6 +461,7 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
+    m_arp->m_waitReply.erase(m_ipv4Address);
     m_state = PERMANENT;
     ClearRetries();
     UpdateSeen();
@@ -459,6 +473,7 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
+    m_arp->m_waitReply.erase(m_ipv4Address);
     m_state = STATIC_AUTOGENERATED;
     ClearRetries();
     UpdateSeen();
@@ -490,6 +505,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
     m_state = WAIT_REPLY;
+    m_arp->m_waitReply.insert(m_ipv4Address);
     m_pending.push_back(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
@@ -32,8 +32,9 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
-#include <map>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -321,11 +322,11 @@ class ArpCache : public Object
     /**
      * \brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * \brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash>::iterator CacheI;
 
     void DoDispose() override;
 
@@ -347,6 +348,8 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    /// Addresses of the entries in WaitReply state, in the order they are retried
+    std::set<Ipv4Address> m_waitReply;
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
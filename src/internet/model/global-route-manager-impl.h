@@ -30,7 +30,9 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -569,7 +571,9 @@ class SPFVertex
  * also export their own LSAs.
  *
  * This class implements a searchable database of LSAs gathered from every
- * router in the simulation.
+ * router in the simulation.  The LSAs are indexed both by link state ID and
+ * by the link data of their transit network link records, so that the SPF
+ * calculation looks them up in logarithmic time.
  */
 class GlobalRouteManagerLSDB
 {
@@ -672,13 +676,52 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Copy the Link State Database.
+     *
+     * The Link State Advertisements are copied, so that the SPF status flags
+     * of the copy are independent of the ones of this database.
+     *
+     * @returns A new Link State Database, owned by the caller.
+     */
+    GlobalRouteManagerLSDB* Copy() const;
+
+    /**
+     * @brief Find the routers whose routes may differ between a previous Link
+     * State Database and this one.
+     *
+     * A router is affected when it is connected, in either database, to an
+     * LSA which was added, removed or modified.  If the External LSAs differ,
+     * all the routers are affected.
+     *
+     * @param previous The previous Link State Database.
+     * @returns The router IDs of the affected routers.
+     */
+    std::set<Ipv4Address> GetAffectedRouters(const GlobalRouteManagerLSDB* previous) const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
     typedef std::pair<Ipv4Address, GlobalRoutingLSA*>
         LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
+    /// container of neighbor link state IDs, by link state ID
+    typedef std::map<Ipv4Address, std::vector<Ipv4Address>> AdjacencyMap_t;
+
+    /**
+     * @brief Add the links between the LSAs of this database to an adjacency map.
+     *
+     * Point-to-point and transit network link records link a router to its
+     * neighbor router or network, and the attached routers of a network LSA
+     * link the network to these routers.  Stub network link records do not
+     * link the router to any other LSA.
+     *
+     * @param adjacency The adjacency map, by link state ID.
+     */
+    void AddAdjacencies(AdjacencyMap_t& adjacency) const;
 
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+    /// index of the LSAs by the link data of their transit network link records
+    std::map<Ipv4Address, LSDBMap_t::const_iterator> m_linkDataIndex;
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
 };
@@ -725,6 +768,16 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and recompute the routes of the
+     * routers affected by the changes since the database was last built.
+     *
+     * The routes of the other routers, which cannot differ from the ones a
+     * full computation would produce, are left untouched.  Nothing is
+     * recomputed if the Link State Advertisements did not change.
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -738,9 +791,42 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /// container of routers whose routes are computed, with their nodes
+    typedef std::vector<std::pair<Ipv4Address, Ptr<Node>>> SPFRoots_t;
+
     SPFVertex* m_spfroot;           //!< the root node
+    Ptr<Node> m_spfrootNode;        //!< the node of the root router, if any
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
 
+    /**
+     * \brief Delete the routes of a router.
+     *
+     * \param node the node of the router
+     * \param router the GlobalRouter of the node
+     */
+    void DeleteRoutes(Ptr<Node> node, Ptr<GlobalRouter> router);
+
+    /**
+     * \brief Find the node of a router.
+     *
+     * \param routerId the router ID
+     * \returns the node, or nullptr if no node has this router ID
+     */
+    Ptr<Node> FindRouterNode(Ipv4Address routerId) const;
+
+    /**
+     * \brief Calculate the SPF trees of several routers and populate their
+     * forwarding tables.
+     *
+     * The calculations are spread over the number of threads set by the
+     * "GlobalRoutingThreads" GlobalValue.  Each thread uses its own copy of
+     * the Link State Database and only writes the forwarding tables of its
+     * root nodes, so the routes do not depend on the number of threads.
+     *
+     * \param roots the router IDs and nodes of the roots
+     */
+    void SPFCalculate(const SPFRoots_t& roots);
+
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
      *
@@ -758,8 +844,9 @@ class GlobalRouteManagerImpl
      *
      * Equivalent to quagga ospf_spf_calculate
      * \param root the root node
+     * \param node the node whose forwarding table is populated, if any
      */
-    void SPFCalculate(Ipv4Address root);
+    void SPFCalculate(Ipv4Address root, Ptr<Node> node);
 
     /**
      * \brief Process Stub nodes
@@ -70,6 +70,17 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and recompute the routes of the
+     * routers affected by the changes since the database was last built.
+     *
+     * This is equivalent to calling DeleteGlobalRoutes (),
+     * BuildGlobalRoutingDatabase () and InitializeRoutes (), except that the
+     * routes of the routers which are not connected to a changed Link State
+     * Advertisement are kept.
+     */
+    static void UpdateRoutes();
 };
 
 } // namespace ns3
@@ -24,11 +24,30 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv4EndPointDemux");
 
+bool
+Ipv4EndPointDemux::EndPointKey::operator==(const EndPointKey& other) const
+{
+    return localAddress == other.localAddress && localPort == other.localPort &&
+           peerAddress == other.peerAddress && peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv4EndPointDemux::EndPointKeyHash::operator()(const EndPointKey& key) const
+{
+    uint64_t h = (static_cast<uint64_t>(key.localAddress.Get()) << 32) | key.peerAddress.Get();
+    h ^= ((static_cast<uint64_t>(key.localPort) << 16) | key.peerPort) * 0x9e3779b97f4a7c15ULL;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
 Ipv4EndPointDemux::Ipv4EndPointDemux()
     : m_ephemeral(49152),
       m_portLast(65535),
@@ -40,26 +59,97 @@ Ipv4EndPointDemux::Ipv4EndPointDemux()
 Ipv4EndPointDemux::~Ipv4EndPointDemux()
 {
     NS_LOG_FUNCTION(this);
+    m_index.clear();
+    m_localPorts.clear();
+    m_endPointsPositions.clear();
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
 }
 
-bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    m_endPoints.push_back(endPoint);
+    m_endPointsPositions[endPoint] = std::prev(m_endPoints.end());
+    endPoint->m_demux = this;
+    Index(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint)
+{
+    EndPointKey key{endPoint->GetLocalAddress(),
+                    endPoint->GetLocalPort(),
+                    endPoint->GetPeerAddress(),
+                    endPoint->GetPeerPort()};
+    m_index[key].push_back(endPoint);
+    m_localPorts[key.localPort]++;
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint)
+{
+    EndPointKey key{endPoint->GetLocalAddress(),
+                    endPoint->GetLocalPort(),
+                    endPoint->GetPeerAddress(),
+                    endPoint->GetPeerPort()};
+    auto it = m_index.find(key);
+    NS_ASSERT_MSG(it != m_index.end(), "Endpoint " << endPoint << " is not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        m_index.erase(it);
+    }
+    auto port = m_localPorts.find(key.localPort);
+    if (--port->second == 0)
+    {
+        m_localPorts.erase(port);
+    }
+}
+
+void
+Ipv4EndPointDemux::LookupIndex(EndPoints& endPoints,
+                               const EndPointKey& key,
+                               Ptr<Ipv4Interface> incomingInterface) const
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return;
+    }
+    for (auto endP : it->second)
     {
-        if ((*i)->GetLocalPort() == port)
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint can not receive packets");
+            continue;
+        }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << endP << " because endpoint is bound to specific device "
+                         << endP->GetBoundNetDevice() << " which does not match packet device");
+            continue;
         }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
@@ -87,10 +177,7 @@ Ipv4EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(Ipv4Address::GetAny(), port));
 }
 
 Ipv4EndPoint*
@@ -103,10 +190,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -126,10 +210,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -140,38 +221,37 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find({localAddress, localPort, peerAddress, peerPort});
+    if (it != m_index.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : it->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_endPointsPositions.find(endPoint);
+    if (it == m_endPointsPositions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint);
+    m_endPoints.erase(it->second);
+    m_endPointsPositions.erase(it);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -204,158 +284,59 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
                           Ptr<Ipv4Interface> incomingInterface)
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv4EndPoint* endP = *i;
 
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
+    // The endpoints match the local address of a packet in 3 ways:
+    // 1) Exact local / destination address match
+    // 2) Local endpoint bound to Any -> matches anything
+    // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+    // x.y.z.255 in a /24 net) and direct destination match.
+    // and the most exact match is looked up first:
+    // case 4) All 4 match - this is the case of an open TCP connection, for example.
+    // case 3) All but local address (wildcard).
+    // case 2) Only local port and local address matches exactly - Not yet opened connection
+    // case 1) Only local port matches exactly - Endpoint open to "any" connection
+    EndPoints retval;
+    LookupIndex(retval, {daddr, dport, saddr, sport}, incomingInterface);
 
-        if (endP->GetLocalPort() != dport)
+    if (retval.empty())
+    {
+        // Wildcard local addresses matching the destination address
+        std::vector<Ipv4Address> wildcards;
+        if (daddr != Ipv4Address::GetAny())
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
+            wildcards.push_back(Ipv4Address::GetAny());
         }
-        if (endP->GetBoundNetDevice())
+        for (uint32_t i = 0; incomingInterface && i < incomingInterface->GetNAddresses(); i++)
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (addrNetpart != daddr && daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+                std::find(wildcards.begin(), wildcards.end(), addrNetpart) == wildcards.end())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                NS_LOG_LOGIC("Destination matches SubnetDirectedAny "
+                             << addrNetpart << "/" << addr.GetMask().GetPrefixLength());
+                wildcards.push_back(addrNetpart);
             }
         }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
-
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
-
-        if (endP->GetLocalAddress() == daddr)
+        for (const auto& wildcard : wildcards)
         {
-            // Case 1:
-            localAddressMatchesExact = true;
+            LookupIndex(retval, {wildcard, dport, saddr, sport}, incomingInterface);
         }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+        if (retval.empty())
         {
-            // Case 2:
-            localAddressIsAny = true;
+            LookupIndex(retval, {daddr, dport, Ipv4Address::GetAny(), 0}, incomingInterface);
         }
-        else
+        if (retval.empty())
         {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
-            {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
-                {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
-                }
-            }
-
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
+            for (const auto& wildcard : wildcards)
             {
-                continue;
+                LookupIndex(retval,
+                            {wildcard, dport, Ipv4Address::GetAny(), 0},
+                            incomingInterface);
             }
         }
-
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
-        }
-    }
-
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
-    {
-        retval = retval3;
-    }
-    else if (!retval2.empty())
-    {
-        retval = retval2;
-    }
-    else
-    {
-        retval = retval1;
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -372,6 +353,13 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    auto exact = m_index.find({daddr, dport, saddr, sport});
+    if (exact != m_index.end())
+    {
+        /* this is an exact match. */
+        return exact->second.front();
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
@@ -382,12 +370,6 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
         {
             continue;
         }
-        if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == saddr)
-        {
-            /* this is an exact match. */
-            return *i;
-        }
         uint32_t tmp = 0;
         if ((*i)->GetLocalAddress() == Ipv4Address::GetAny())
         {
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -42,6 +44,12 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed in a hash table by their four-tuple, so that
+ * Lookup () finds the endpoints of each match class (exact match, then
+ * local address and port, then local port only) with a few hash lookups
+ * instead of scanning every endpoint.  The endpoints notify the demux when
+ * their local address or peer change.
  */
 
 class Ipv4EndPointDemux
@@ -171,6 +179,70 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * \brief Four-tuple of an endpoint: local address and port, peer
+     * address and port.
+     */
+    struct EndPointKey
+    {
+        Ipv4Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv4Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the other key
+         * \returns true if the keys are equal
+         */
+        bool operator==(const EndPointKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of the endpoint four-tuples.
+     */
+    struct EndPointKeyHash
+    {
+        /**
+         * \brief Hash a four-tuple.
+         * \param key the four-tuple
+         * \returns the hash
+         */
+        std::size_t operator()(const EndPointKey& key) const;
+    };
+
+    /**
+     * \brief Add an endpoint to the list and to the index.
+     * \param endPoint the endpoint
+     * \returns the endpoint
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add an endpoint to the index, under its current four-tuple.
+     * \param endPoint the endpoint
+     */
+    void Index(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the index.
+     * \param endPoint the endpoint
+     */
+    void Unindex(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Append the endpoints of a four-tuple which can receive packets
+     * from an interface.
+     * \param endPoints the list to append the endpoints to
+     * \param key the four-tuple
+     * \param incomingInterface the incoming interface
+     */
+    void LookupIndex(EndPoints& endPoints,
+                     const EndPointKey& key,
+                     Ptr<Ipv4Interface> incomingInterface) const;
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -196,6 +268,21 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The position of the IPv4 end points in the list.
+     */
+    std::unordered_map<Ipv4EndPoint*, EndPointsI> m_endPointsPositions;
+
+    /**
+     * \brief The IPv4 end points, by four-tuple.
+     */
+    std::unordered_map<EndPointKey, std::vector<Ipv4EndPoint*>, EndPointKeyHash> m_index;
+
+    /**
+     * \brief The number of IPv4 end points, by local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
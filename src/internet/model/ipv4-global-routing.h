@@ -22,6 +22,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "lpm-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -29,6 +30,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -274,10 +276,17 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /// Index of routes by destination prefix; the routes sharing a prefix form an ECMP group
+    typedef LpmTrie<4, Ipv4RoutingTableEntry*> RouteIndex;
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    RouteIndex m_hostIndex;     //!< Index of m_hostRoutes
+    RouteIndex m_networkIndex;  //!< Index of m_networkRoutes
+    RouteIndex m_externalIndex; //!< Index of m_ASexternalRoutes
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -78,8 +78,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -95,9 +94,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -152,7 +149,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendRoute(route, 0);
 }
 
 uint32_t
@@ -224,7 +221,9 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    std::vector<NetworkRoutesI> candidates;
+    m_networkRoutesIndex.LookupInOrder(route.GetDest(), candidates);
+    for (auto j : candidates)
     {
         Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -239,6 +238,26 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::AppendRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesIndex.InsertNetwork(route->GetDestNetwork(),
+                                       route->GetDestNetworkMask(),
+                                       std::prev(m_networkRoutes.end()));
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseRoute(NetworkRoutesI it)
+{
+    Ipv4RoutingTableEntry* route = it->first;
+    bool found =
+        m_networkRoutesIndex.RemoveNetwork(route->GetDestNetwork(), route->GetDestNetworkMask(), it);
+    NS_ASSERT_MSG(found, "Route missing from the index");
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
@@ -261,7 +280,10 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    // Only the routes which may match are scanned, in table order
+    std::vector<NetworkRoutesI> candidates;
+    m_networkRoutesIndex.LookupInOrder(dest, candidates);
+    for (auto i : candidates)
     {
         Ipv4RoutingTableEntry* j = i->first;
         uint32_t metric = i->second;
@@ -457,8 +479,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseRoute(j);
             return;
         }
         tmp++;
@@ -592,6 +613,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRoutesIndex.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -631,8 +653,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
@@ -676,8 +697,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
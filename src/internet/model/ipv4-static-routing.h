@@ -24,6 +24,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "lpm-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -32,6 +33,7 @@
 #include <list>
 #include <stdint.h>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -372,6 +374,9 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<Ipv4RoutingTableEntry*, uint32_t>>::iterator NetworkRoutesI;
 
+    /// Index of the network routes by destination prefix
+    typedef LpmTrie<4, NetworkRoutesI> NetworkRoutesIndex;
+
     /// Container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*> MulticastRoutes;
 
@@ -389,6 +394,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a network route at the end of the forwarding table.
+     * \param route route, now owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AppendRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a network route from the forwarding table and delete it.
+     * \param it the route
+     * \return the route following the removed one
+     */
+    NetworkRoutesI EraseRoute(NetworkRoutesI it);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -411,6 +430,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of m_networkRoutes, by destination prefix.
+     */
+    NetworkRoutesIndex m_networkRoutesIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
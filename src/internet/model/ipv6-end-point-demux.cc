@@ -23,11 +23,32 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPointDemux");
 
+bool
+Ipv6EndPointDemux::EndPointKey::operator==(const EndPointKey& other) const
+{
+    return localAddress == other.localAddress && localPort == other.localPort &&
+           peerAddress == other.peerAddress && peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv6EndPointDemux::EndPointKeyHash::operator()(const EndPointKey& key) const
+{
+    Ipv6AddressHash addressHash;
+    uint64_t h = addressHash(key.localAddress);
+    h = h * 0x9e3779b97f4a7c15ULL + addressHash(key.peerAddress);
+    h ^= ((static_cast<uint64_t>(key.localPort) << 16) | key.peerPort) * 0x9e3779b97f4a7c15ULL;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
 Ipv6EndPointDemux::Ipv6EndPointDemux()
     : m_ephemeral(49152),
       m_portFirst(49152),
@@ -39,26 +60,97 @@ Ipv6EndPointDemux::Ipv6EndPointDemux()
 Ipv6EndPointDemux::~Ipv6EndPointDemux()
 {
     NS_LOG_FUNCTION(this);
+    m_index.clear();
+    m_localPorts.clear();
+    m_endPointsPositions.clear();
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
 }
 
-bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    m_endPoints.push_back(endPoint);
+    m_endPointsPositions[endPoint] = std::prev(m_endPoints.end());
+    endPoint->m_demux = this;
+    Index(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint)
+{
+    EndPointKey key{endPoint->GetLocalAddress(),
+                    endPoint->GetLocalPort(),
+                    endPoint->GetPeerAddress(),
+                    endPoint->GetPeerPort()};
+    m_index[key].push_back(endPoint);
+    m_localPorts[key.localPort]++;
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint)
+{
+    EndPointKey key{endPoint->GetLocalAddress(),
+                    endPoint->GetLocalPort(),
+                    endPoint->GetPeerAddress(),
+                    endPoint->GetPeerPort()};
+    auto it = m_index.find(key);
+    NS_ASSERT_MSG(it != m_index.end(), "Endpoint " << endPoint << " is not indexed");
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        m_index.erase(it);
+    }
+    auto port = m_localPorts.find(key.localPort);
+    if (--port->second == 0)
+    {
+        m_localPorts.erase(port);
+    }
+}
+
+void
+Ipv6EndPointDemux::LookupIndex(EndPoints& endPoints,
+                               const EndPointKey& key,
+                               Ptr<Ipv6Interface> incomingInterface) const
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return;
+    }
+    for (auto endP : it->second)
     {
-        if ((*i)->GetLocalPort() == port)
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint can not receive packets");
+            continue;
+        }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << endP << " because endpoint is bound to specific device "
+                         << endP->GetBoundNetDevice() << " which does not match packet device");
+            continue;
         }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
@@ -86,10 +178,7 @@ Ipv6EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(Ipv6Address::GetAny(), port));
 }
 
 Ipv6EndPoint*
@@ -102,10 +191,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -125,10 +211,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -139,38 +222,37 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find({localAddress, localPort, peerAddress, peerPort});
+    if (it != m_index.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : it->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_endPointsPositions.find(endPoint);
+    if (it == m_endPointsPositions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint);
+    m_endPoints.erase(it->second);
+    m_endPointsPositions.erase(it);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -187,118 +269,28 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
 
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
-            {
-                continue;
-            }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
-            {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
-            }
-        }
-
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
-
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
-        }
-    }
-
-    // Here we find the most exact match
+    /* Look up the most exact match first:
+     * 4) All 4 match
+     * 3) All but local address, bound to Any
+     * 2) Only local port and local address matches exactly
+     * 1) Only local port matches exactly, local address bound to Any
+     */
+    Ipv6Address any = Ipv6Address::GetAny();
     EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
+    LookupIndex(retval, {daddr, dport, saddr, sport}, incomingInterface);
+    if (retval.empty() && daddr != any)
     {
-        retval = retval3;
+        LookupIndex(retval, {any, dport, saddr, sport}, incomingInterface);
     }
-    else if (!retval2.empty())
+    if (retval.empty())
     {
-        retval = retval2;
+        LookupIndex(retval, {daddr, dport, any, 0}, incomingInterface);
     }
-    else
+    if (retval.empty() && daddr != any)
     {
-        retval = retval1;
+        LookupIndex(retval, {any, dport, any, 0}, incomingInterface);
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -310,6 +302,13 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    auto exact = m_index.find({dst, dport, src, sport});
+    if (exact != m_index.end())
+    {
+        /* this is an exact match. */
+        return exact->second.front();
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
@@ -322,13 +321,6 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
             continue;
         }
 
-        if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
-            (*i)->GetPeerAddress() == src)
-        {
-            /* this is an exact match. */
-            return *i;
-        }
-
         if ((*i)->GetLocalAddress() == Ipv6Address::GetAny())
         {
             tmp++;
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -36,6 +38,11 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * The endpoints are indexed in a hash table by their four-tuple, so that
+ * Lookup () finds the endpoints of each match class with a few hash
+ * lookups instead of scanning every endpoint.  The endpoints notify the
+ * demux when their local address, local port or peer change.
  */
 class Ipv6EndPointDemux
 {
@@ -161,6 +168,70 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * \brief Four-tuple of an endpoint: local address and port, peer
+     * address and port.
+     */
+    struct EndPointKey
+    {
+        Ipv6Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv6Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the other key
+         * \returns true if the keys are equal
+         */
+        bool operator==(const EndPointKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of the endpoint four-tuples.
+     */
+    struct EndPointKeyHash
+    {
+        /**
+         * \brief Hash a four-tuple.
+         * \param key the four-tuple
+         * \returns the hash
+         */
+        std::size_t operator()(const EndPointKey& key) const;
+    };
+
+    /**
+     * \brief Add an endpoint to the list and to the index.
+     * \param endPoint the endpoint
+     * \returns the endpoint
+     */
+    Ipv6EndPoint* Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Add an endpoint to the index, under its current four-tuple.
+     * \param endPoint the endpoint
+     */
+    void Index(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the index.
+     * \param endPoint the endpoint
+     */
+    void Unindex(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Append the endpoints of a four-tuple which can receive packets
+     * from an interface.
+     * \param endPoints the list to append the endpoints to
+     * \param key the four-tuple
+     * \param incomingInterface the incoming interface
+     */
+    void LookupIndex(EndPoints& endPoints,
+                     const EndPointKey& key,
+                     Ptr<Ipv6Interface> incomingInterface) const;
+
     /**
      * \brief Allocate a ephemeral port.
      * \return a port
@@ -186,6 +257,21 @@ class Ipv6EndPointDemux
      * \brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The position of the IPv6 end points in the list.
+     */
+    std::unordered_map<Ipv6EndPoint*, EndPointsI> m_endPointsPositions;
+
+    /**
+     * \brief The IPv6 end points, by four-tuple.
+     */
+    std::unordered_map<EndPointKey, std::vector<Ipv6EndPoint*>, EndPointKeyHash> m_index;
+
+    /**
+     * \brief The number of IPv6 end points, by local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
@@ -19,6 +19,8 @@
 
 #include "ipv6-end-point.h"
 
+#include "ipv6-end-point-demux.h"
+
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -29,7 +31,8 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPoint");
 
 Ipv6EndPoint::Ipv6EndPoint(Ipv6Address addr, uint16_t port)
-    : m_localAddr(addr),
+    : m_demux(nullptr),
+      m_localAddr(addr),
       m_localPort(port),
       m_peerAddr(Ipv6Address::GetAny()),
       m_peerPort(0),
@@ -57,7 +60,15 @@ Ipv6EndPoint::GetLocalAddress() const
 void
 Ipv6EndPoint::SetLocalAddress(Ipv6Address addr)
 {
+    if (m_demux)
+    {
+        m_demux->Unindex(this);
+    }
     m_localAddr = addr;
+    if (m_demux)
+    {
+        m_demux->Index(this);
+    }
 }
 
 uint16_t
@@ -69,7 +80,15 @@ Ipv6EndPoint::GetLocalPort() const
 void
 Ipv6EndPoint::SetLocalPort(uint16_t port)
 {
+    if (m_demux)
+    {
+        m_demux->Unindex(this);
+    }
     m_localPort = port;
+    if (m_demux)
+    {
+        m_demux->Index(this);
+    }
 }
 
 Ipv6Address
@@ -99,8 +118,16 @@ Ipv6EndPoint::GetBoundNetDevice() const
 void
 Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
+    if (m_demux)
+    {
+        m_demux->Unindex(this);
+    }
     m_peerAddr = addr;
     m_peerPort = port;
+    if (m_demux)
+    {
+        m_demux->Index(this);
+    }
 }
 
 void
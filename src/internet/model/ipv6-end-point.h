@@ -33,6 +33,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -195,6 +196,14 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
+    /**
+     * \brief The demux indexing this endpoint (if any), notified when
+     * the local address or the peer changes.
+     */
+    Ipv6EndPointDemux* m_demux;
+
     /**
      * \brief The local address.
      */
@@ -19,11 +19,13 @@
 #include "ipv6-list-routing.h"
 
 #include "ipv6-route.h"
+#include "ipv6-static-routing.h"
 #include "ipv6.h"
 
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -35,13 +37,29 @@ NS_OBJECT_ENSURE_REGISTERED(Ipv6ListRouting);
 TypeId
 Ipv6ListRouting::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::Ipv6ListRouting")
-                            .SetParent<Ipv6RoutingProtocol>()
-                            .SetGroupName("Internet")
-                            .AddConstructor<Ipv6ListRouting>();
+    static TypeId tid =
+        TypeId("ns3::Ipv6ListRouting")
+            .SetParent<Ipv6RoutingProtocol>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv6ListRouting>()
+            .AddAttribute("RouteCacheSize",
+                          "The maximum number of destinations whose output route is cached "
+                          "(0 disables the cache).  The cache is flushed by the notifications "
+                          "only, so it must only be enabled if the routes of the routing "
+                          "protocols change through notifications.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv6ListRouting::SetRouteCacheSize,
+                                               &Ipv6ListRouting::GetRouteCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
+std::size_t
+Ipv6ListRouting::RouteCacheKeyHash::operator()(const RouteCacheKey& key) const
+{
+    return Ipv6AddressHash()(key.first) ^ std::hash<const NetDevice*>()(key.second);
+}
+
 Ipv6ListRouting::Ipv6ListRouting()
     : m_ipv6(nullptr)
 {
@@ -63,9 +81,14 @@ Ipv6ListRouting::DoDispose()
         // Note:  Calling dispose on these protocols causes memory leak
         //        The routing protocols should not maintain a pointer to
         //        this object, so Dispose () shouldn't be necessary.
+        if (auto staticRouting = DynamicCast<Ipv6StaticRouting>((*rprotoIter).second))
+        {
+            staticRouting->SetRoutesChangedCallback(MakeNullCallback<void>());
+        }
         (*rprotoIter).second = nullptr;
     }
     m_routingProtocols.clear();
+    m_routeCache.Clear();
     m_ipv6 = nullptr;
 }
 
@@ -78,6 +101,15 @@ Ipv6ListRouting::RouteOutput(Ptr<Packet> p,
     NS_LOG_FUNCTION(this << header.GetDestination() << header.GetSource() << oif);
     Ptr<Ipv6Route> route;
 
+    RouteCacheKey cacheKey(header.GetDestination(), PeekPointer(oif));
+    if (Ptr<Ipv6Route>* cached = m_routeCache.Find(cacheKey))
+    {
+        NS_LOG_LOGIC("Found cached route " << *cached);
+        sockerr = Socket::ERROR_NOTERROR;
+        // The cached route is copied, as the caller may modify it
+        return Create<Ipv6Route>(**cached);
+    }
+
     for (auto i = m_routingProtocols.begin(); i != m_routingProtocols.end(); i++)
     {
         NS_LOG_LOGIC("Checking protocol " << (*i).second->GetInstanceTypeId() << " with priority "
@@ -88,6 +120,12 @@ Ipv6ListRouting::RouteOutput(Ptr<Packet> p,
         {
             NS_LOG_LOGIC("Found route " << route);
             sockerr = Socket::ERROR_NOTERROR;
+            // Only the routes found are cached: a protocol may still be
+            // looking for a route to the destination (e.g., on demand)
+            if (m_routeCache.GetCapacity() > 0)
+            {
+                m_routeCache.Insert(cacheKey, Create<Ipv6Route>(*route));
+            }
             return route;
         }
     }
@@ -146,6 +184,7 @@ void
 Ipv6ListRouting::NotifyInterfaceUp(uint32_t interface)
 {
     NS_LOG_FUNCTION(this << interface);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -157,6 +196,7 @@ void
 Ipv6ListRouting::NotifyInterfaceDown(uint32_t interface)
 {
     NS_LOG_FUNCTION(this << interface);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -168,6 +208,7 @@ void
 Ipv6ListRouting::NotifyAddAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << address);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -179,6 +220,7 @@ void
 Ipv6ListRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
     NS_LOG_FUNCTION(this << interface << address);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -194,6 +236,7 @@ Ipv6ListRouting::NotifyAddRoute(Ipv6Address dst,
                                 Ipv6Address prefixToUse)
 {
     NS_LOG_FUNCTION(this << dst << mask << nextHop << interface);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -209,6 +252,7 @@ Ipv6ListRouting::NotifyRemoveRoute(Ipv6Address dst,
                                    Ipv6Address prefixToUse)
 {
     NS_LOG_FUNCTION(this << dst << mask << nextHop << interface);
+    m_routeCache.Clear();
     for (auto rprotoIter = m_routingProtocols.begin(); rprotoIter != m_routingProtocols.end();
          rprotoIter++)
     {
@@ -252,6 +296,13 @@ Ipv6ListRouting::AddRoutingProtocol(Ptr<Ipv6RoutingProtocol> routingProtocol, in
     NS_LOG_FUNCTION(this << routingProtocol->GetInstanceTypeId() << priority);
     m_routingProtocols.emplace_back(priority, routingProtocol);
     m_routingProtocols.sort(Compare);
+    m_routeCache.Clear();
+    // The static routes can change without notification
+    if (auto staticRouting = DynamicCast<Ipv6StaticRouting>(routingProtocol))
+    {
+        staticRouting->SetRoutesChangedCallback(
+            MakeCallback(&Ipv6ListRouting::FlushRouteCache, this));
+    }
     if (m_ipv6)
     {
         routingProtocol->SetIpv6(m_ipv6);
@@ -287,6 +338,26 @@ Ipv6ListRouting::GetRoutingProtocol(uint32_t index, int16_t& priority) const
     return nullptr;
 }
 
+void
+Ipv6ListRouting::FlushRouteCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_routeCache.Clear();
+}
+
+void
+Ipv6ListRouting::SetRouteCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_routeCache.SetCapacity(size);
+}
+
+uint32_t
+Ipv6ListRouting::GetRouteCacheSize() const
+{
+    return m_routeCache.GetCapacity();
+}
+
 bool
 Ipv6ListRouting::Compare(const Ipv6RoutingProtocolEntry& a, const Ipv6RoutingProtocolEntry& b)
 {
@@ -20,7 +20,10 @@
 
 #include "ipv6-routing-protocol.h"
 
+#include "ns3/lru-cache.h"
+
 #include <list>
+#include <utility>
 
 namespace ns3
 {
@@ -39,6 +42,16 @@ namespace ns3
  * The order by which routing protocols with the same priority value
  * are consulted is undefined.
  *
+ * The routes returned by RouteOutput can be kept in a cache of at most
+ * \c RouteCacheSize destinations, which is flushed by the Notify methods
+ * (including the routes added by ICMPv6 redirects), by FlushRouteCache, and
+ * when a unicast route of an Ipv6StaticRouting in the list is added or
+ * removed.  As a route of another protocol in the list can change without
+ * a notification (e.g., when a dynamic routing protocol learns a new
+ * route), the cache must only be enabled when the routes change through
+ * the notifications, or when FlushRouteCache is called after they change.
+ * Each protocol must also select its routes by destination and output
+ * device only.
  */
 class Ipv6ListRouting : public Ipv6RoutingProtocol
 {
@@ -86,6 +99,14 @@ class Ipv6ListRouting : public Ipv6RoutingProtocol
      */
     virtual Ptr<Ipv6RoutingProtocol> GetRoutingProtocol(uint32_t index, int16_t& priority) const;
 
+    /**
+     * \brief Remove all the routes from the route cache.
+     *
+     * This must be called when a route of a protocol in the list changes
+     * without a notification, if the route cache is enabled.
+     */
+    void FlushRouteCache();
+
     // Below are from Ipv6RoutingProtocol
     Ptr<Ipv6Route> RouteOutput(Ptr<Packet> p,
                                const Ipv6Header& header,
@@ -134,6 +155,32 @@ class Ipv6ListRouting : public Ipv6RoutingProtocol
      */
     typedef std::list<Ipv6RoutingProtocolEntry> Ipv6RoutingProtocolList;
 
+    /// Key of the route cache: the destination and the output device, if any
+    typedef std::pair<Ipv6Address, const NetDevice*> RouteCacheKey;
+
+    /// Hash function of the route cache keys
+    struct RouteCacheKeyHash
+    {
+        /**
+         * \brief Returns the hash of a route cache key.
+         * \param key the key
+         * \returns the hash of the key
+         */
+        std::size_t operator()(const RouteCacheKey& key) const;
+    };
+
+    /**
+     * \brief Set the maximum number of destinations in the route cache.
+     * \param size the maximum number of destinations, 0 to disable the cache
+     */
+    void SetRouteCacheSize(uint32_t size);
+
+    /**
+     * \brief Get the maximum number of destinations in the route cache.
+     * \return the maximum number of destinations
+     */
+    uint32_t GetRouteCacheSize() const;
+
     /**
      * \brief Compare two routing protocols.
      * \param a first object to compare
@@ -144,6 +191,8 @@ class Ipv6ListRouting : public Ipv6RoutingProtocol
 
     Ipv6RoutingProtocolList m_routingProtocols; //!<  List of routing protocols.
     Ptr<Ipv6> m_ipv6;                           //!< Ipv6 this protocol is associated with.
+    /// The routes recently returned by RouteOutput.
+    LruCache<RouteCacheKey, Ptr<Ipv6Route>, RouteCacheKeyHash> m_routeCache;
 };
 
 } // namespace ns3
@@ -28,6 +28,7 @@
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
 
@@ -41,13 +42,27 @@ NS_OBJECT_ENSURE_REGISTERED(Ipv6StaticRouting);
 TypeId
 Ipv6StaticRouting::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::Ipv6StaticRouting")
-                            .SetParent<Ipv6RoutingProtocol>()
-                            .SetGroupName("Internet")
-                            .AddConstructor<Ipv6StaticRouting>();
+    static TypeId tid =
+        TypeId("ns3::Ipv6StaticRouting")
+            .SetParent<Ipv6RoutingProtocol>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv6StaticRouting>()
+            .AddAttribute("RouteCacheSize",
+                          "The maximum number of destinations whose unicast route is cached "
+                          "(0 disables the cache).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv6StaticRouting::SetRouteCacheSize,
+                                               &Ipv6StaticRouting::GetRouteCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
+std::size_t
+Ipv6StaticRouting::RouteCacheKeyHash::operator()(const RouteCacheKey& key) const
+{
+    return Ipv6AddressHash()(key.first) ^ std::hash<const NetDevice*>()(key.second);
+}
+
 Ipv6StaticRouting::Ipv6StaticRouting()
     : m_ipv6(nullptr)
 {
@@ -181,8 +196,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -208,8 +222,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -225,8 +238,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -268,7 +280,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendRoute(route, 0);
 }
 
 uint32_t
@@ -344,7 +356,9 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
     NS_LOG_FUNCTION(this << network << interfaceIndex);
 
     /* in the network table */
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    std::vector<NetworkRoutesI> candidates;
+    m_networkRoutesIndex.LookupInOrder(network, candidates);
+    for (auto j : candidates)
     {
         Ipv6RoutingTableEntry* rtentry = j->first;
         Ipv6Prefix prefix = rtentry->GetDestNetworkPrefix();
@@ -363,7 +377,9 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    std::vector<NetworkRoutesI> candidates;
+    m_networkRoutesIndex.LookupInOrder(route.GetDest(), candidates);
+    for (auto j : candidates)
     {
         Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -379,6 +395,57 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::AppendRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesIndex.InsertNetwork(route->GetDestNetwork(),
+                                       route->GetDestNetworkPrefix(),
+                                       std::prev(m_networkRoutes.end()));
+    m_routeCache.Clear();
+    if (!m_routesChanged.IsNull())
+    {
+        m_routesChanged();
+    }
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseRoute(NetworkRoutesI it)
+{
+    Ipv6RoutingTableEntry* route = it->first;
+    bool found = m_networkRoutesIndex.RemoveNetwork(route->GetDestNetwork(),
+                                                    route->GetDestNetworkPrefix(),
+                                                    it);
+    NS_ASSERT_MSG(found, "Route missing from the index");
+    m_routeCache.Clear();
+    if (!m_routesChanged.IsNull())
+    {
+        m_routesChanged();
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
+void
+Ipv6StaticRouting::SetRoutesChangedCallback(Callback<void> cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_routesChanged = cb;
+}
+
+void
+Ipv6StaticRouting::SetRouteCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_routeCache.SetCapacity(size);
+}
+
+uint32_t
+Ipv6StaticRouting::GetRouteCacheSize() const
+{
+    return m_routeCache.GetCapacity();
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
@@ -402,7 +469,18 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
+    RouteCacheKey cacheKey(dst, PeekPointer(interface));
+    if (Ptr<Ipv6Route>* cached = m_routeCache.Find(cacheKey))
+    {
+        NS_LOG_LOGIC("Found cached route to " << dst);
+        // The cached route is copied, as the caller may modify it
+        return *cached ? Create<Ipv6Route>(**cached) : nullptr;
+    }
+
+    // Only the routes which may match are scanned, in table order
+    std::vector<NetworkRoutesI> candidates;
+    m_networkRoutesIndex.LookupInOrder(dst, candidates);
+    for (auto it : candidates)
     {
         Ipv6RoutingTableEntry* j = it->first;
         uint32_t metric = it->second;
@@ -477,6 +555,10 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         NS_LOG_LOGIC("Matching route via " << rtentry->GetDestination() << " (Through "
                                            << rtentry->GetGateway() << ") at the end");
     }
+    if (m_routeCache.GetCapacity() > 0)
+    {
+        m_routeCache.Insert(cacheKey, rtentry ? Create<Ipv6Route>(*rtentry) : nullptr);
+    }
     return rtentry;
 }
 
@@ -490,6 +572,9 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRoutesIndex.Clear();
+    m_routeCache.Clear();
+    m_routesChanged = MakeNullCallback<void>();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -647,8 +732,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseRoute(it);
             return;
         }
         tmp++;
@@ -670,8 +754,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseRoute(it);
             return;
         }
     }
@@ -778,6 +861,7 @@ Ipv6StaticRouting::RouteInput(Ptr<const Packet> p,
 void
 Ipv6StaticRouting::NotifyInterfaceUp(uint32_t i)
 {
+    m_routeCache.Clear();
     for (uint32_t j = 0; j < m_ipv6->GetNAddresses(i); j++)
     {
         Ipv6InterfaceAddress addr = m_ipv6->GetAddress(i, j);
@@ -806,14 +890,14 @@ void
 Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
+    m_routeCache.Clear();
 
     /* remove all static routes that are going through this interface */
     for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end();)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
@@ -825,6 +909,8 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
 void
 Ipv6StaticRouting::NotifyAddAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
+    // The source address of the cached routes may change
+    m_routeCache.Clear();
     if (!m_ipv6->IsUp(interface))
     {
         return;
@@ -834,6 +920,8 @@ Ipv6StaticRouting::NotifyAddAddress(uint32_t interface, Ipv6InterfaceAddress add
 void
 Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
+    // The source address of the cached routes may change
+    m_routeCache.Clear();
     if (!m_ipv6->IsUp(interface))
     {
         return;
@@ -850,8 +938,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
@@ -908,8 +995,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseRoute(j);
             }
             else
             {
@@ -23,12 +23,16 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "lpm-trie.h"
 
 #include "ns3/ipv6-address.h"
+#include "ns3/lru-cache.h"
 #include "ns3/ptr.h"
 
 #include <list>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -56,6 +60,12 @@ class Ipv6MulticastRoutingTableEntry;
  * Ipv6RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The network routes are indexed by destination prefix, so that a lookup
+ * only examines the routes matching the destination.  In addition, the
+ * results of the unicast lookups can be kept in a cache of at most
+ * \c RouteCacheSize destinations, which is flushed whenever a route, an
+ * interface or an address changes.
+ *
  * \see Ipv6RoutingProtocol
  * \see Ipv6ListRouting
  * \see Ipv6ListRouting::AddRoutingProtocol
@@ -250,6 +260,16 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool HasNetworkDest(Ipv6Address dest, uint32_t interfaceIndex);
 
+    /**
+     * \brief Set the callback invoked when a unicast route is added or removed.
+     *
+     * Ipv6ListRouting sets it to flush its route cache, as the routes can be
+     * changed directly, e.g. with AddHostRouteTo, without any notification.
+     *
+     * \param cb the callback
+     */
+    void SetRoutesChangedCallback(Callback<void> cb);
+
     Ptr<Ipv6Route> RouteOutput(Ptr<Packet> p,
                                const Ipv6Header& header,
                                Ptr<NetDevice> oif,
@@ -297,6 +317,23 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<Ipv6RoutingTableEntry*, uint32_t>>::iterator NetworkRoutesI;
 
+    /// Index of the network routes by destination prefix
+    typedef LpmTrie<16, NetworkRoutesI> NetworkRoutesIndex;
+
+    /// Key of the route cache: the destination and the output device, if any
+    typedef std::pair<Ipv6Address, const NetDevice*> RouteCacheKey;
+
+    /// Hash function of the route cache keys
+    struct RouteCacheKeyHash
+    {
+        /**
+         * \brief Returns the hash of a route cache key.
+         * \param key the key
+         * \returns the hash of the key
+         */
+        std::size_t operator()(const RouteCacheKey& key) const;
+    };
+
     /// Container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*> MulticastRoutes;
 
@@ -314,6 +351,32 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a network route at the end of the forwarding table.
+     * \param route route, now owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AppendRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a network route from the forwarding table and delete it.
+     * \param it the route
+     * \return the route following the removed one
+     */
+    NetworkRoutesI EraseRoute(NetworkRoutesI it);
+
+    /**
+     * \brief Set the maximum number of destinations in the route cache.
+     * \param size the maximum number of destinations, 0 to disable the cache
+     */
+    void SetRouteCacheSize(uint32_t size);
+
+    /**
+     * \brief Get the maximum number of destinations in the route cache.
+     * \return the maximum number of destinations
+     */
+    uint32_t GetRouteCacheSize() const;
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -336,6 +399,21 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of m_networkRoutes, by destination prefix.
+     */
+    NetworkRoutesIndex m_networkRoutesIndex;
+
+    /**
+     * \brief the routes recently looked up, or nullptr when there was none.
+     */
+    LruCache<RouteCacheKey, Ptr<Ipv6Route>, RouteCacheKeyHash> m_routeCache;
+
+    /**
+     * \brief the callback invoked when a unicast route is added or removed.
+     */
+    Callback<void> m_routesChanged;
+
     /**
      * \brief the forwarding table for multicast.
      */
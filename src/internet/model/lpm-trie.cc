@@ -0,0 +1,71 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lpm-trie.h"
+
+/**
+ * \file
+ * \ingroup internet
+ * ns3::LpmTrie keys of IPv4 and IPv6 addresses and networks.
+ */
+
+namespace ns3
+{
+
+std::array<uint8_t, 4>
+GetLpmTrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
+std::array<uint8_t, 16>
+GetLpmTrieKey(Ipv6Address address)
+{
+    std::array<uint8_t, 16> key;
+    address.GetBytes(key.data());
+    return key;
+}
+
+std::array<uint8_t, 4>
+GetLpmTrieKey(Ipv4Address network, Ipv4Mask mask, uint8_t& length)
+{
+    length = mask.GetPrefixLength();
+    if (Ipv4Mask(length == 0 ? 0 : 0xffffffff << (32 - length)) != mask)
+    {
+        length = 0;
+    }
+    return GetLpmTrieKey(network.CombineMask(mask));
+}
+
+std::array<uint8_t, 16>
+GetLpmTrieKey(Ipv6Address network, Ipv6Prefix mask, uint8_t& length)
+{
+    uint8_t bytes[16];
+    mask.GetBytes(bytes);
+    length = 0;
+    while (length < 128 && (bytes[length / 8] & (0x80 >> (length % 8))))
+    {
+        length++;
+    }
+    if (Ipv6Prefix(length) != mask)
+    {
+        length = 0;
+    }
+    return GetLpmTrieKey(network.CombinePrefix(mask));
+}
+
+} // namespace ns3
@@ -0,0 +1,512 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LPM_TRIE_H
+#define LPM_TRIE_H
+
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet
+ * ns3::LpmTrie declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ * \brief Get the LpmTrie key of an address.
+ *
+ * \param [in] address The address.
+ * \return The address bytes, in network byte order.
+ */
+std::array<uint8_t, 4> GetLpmTrieKey(Ipv4Address address);
+
+/**
+ * \ingroup internet
+ * \copydoc GetLpmTrieKey(Ipv4Address)
+ */
+std::array<uint8_t, 16> GetLpmTrieKey(Ipv6Address address);
+
+/**
+ * \ingroup internet
+ * \brief Get the LpmTrie key and prefix length of a destination network.
+ *
+ * Non-contiguous masks are indexed with a zero length, so that their
+ * routes are always looked up and then checked against their mask.
+ *
+ * \param [in] network The destination network.
+ * \param [in] mask The destination mask.
+ * \param [out] length The prefix length.
+ * \return The masked network bytes, in network byte order.
+ */
+std::array<uint8_t, 4> GetLpmTrieKey(Ipv4Address network, Ipv4Mask mask, uint8_t& length);
+
+/**
+ * \ingroup internet
+ * \copydoc GetLpmTrieKey(Ipv4Address,Ipv4Mask,uint8_t&)
+ */
+std::array<uint8_t, 16> GetLpmTrieKey(Ipv6Address network, Ipv6Prefix mask, uint8_t& length);
+
+/**
+ * \ingroup internet
+ *
+ * \brief Path-compressed binary trie for longest prefix matching.
+ *
+ * The trie stores values under address prefixes of \p N bytes (4 for
+ * IPv4, 16 for IPv6).  All the values stored under the same prefix form
+ * a group, such as the next hops of equal-cost routes, kept in insertion
+ * order.  Only the prefixes holding values and the branching points
+ * between them are represented, so a lookup visits at most one node
+ * per distinct prefix on the path to the destination, whatever the
+ * number of routes.
+ *
+ * Each value is tagged with its insertion order over the whole trie, so
+ * that the routing protocols, which historically scanned their routes
+ * in insertion order, can break ties exactly as before.
+ *
+ * \tparam N The number of bytes of an address.
+ * \tparam T The type of the values, which must be equality comparable.
+ */
+template <std::size_t N, class T>
+class LpmTrie
+{
+  public:
+    /** An address, in network byte order. */
+    typedef std::array<uint8_t, N> Key;
+
+    /** A value stored in the trie. */
+    struct Item
+    {
+        uint64_t order; //!< Insertion order of the value.
+        uint8_t length; //!< Length of the prefix of the value.
+        T value;        //!< The value.
+    };
+
+    LpmTrie();
+
+    /**
+     * Add a value to the group of a prefix.
+     *
+     * \param [in] key The prefix address; the bits beyond \p length are ignored.
+     * \param [in] length The prefix length, in bits.
+     * \param [in] value The value.
+     */
+    void Insert(const Key& key, uint8_t length, const T& value);
+
+    /**
+     * Remove the first value equal to \p value from the group of a prefix.
+     *
+     * \param [in] key The prefix address; the bits beyond \p length are ignored.
+     * \param [in] length The prefix length, in bits.
+     * \param [in] value The value.
+     * \return \c true if the value was found and removed.
+     */
+    bool Remove(const Key& key, uint8_t length, const T& value);
+
+    /**
+     * Add a value to the group of a destination network, such as a route.
+     *
+     * \tparam Address \c Ipv4Address or \c Ipv6Address.
+     * \tparam Prefix \c Ipv4Mask or \c Ipv6Prefix.
+     * \param [in] network The destination network.
+     * \param [in] mask The destination mask, which may be non-contiguous.
+     * \param [in] value The value.
+     */
+    template <class Address, class Prefix>
+    void InsertNetwork(Address network, Prefix mask, const T& value);
+
+    /**
+     * Remove the first value equal to \p value from the group of a
+     * destination network.
+     *
+     * \tparam Address \c Ipv4Address or \c Ipv6Address.
+     * \tparam Prefix \c Ipv4Mask or \c Ipv6Prefix.
+     * \param [in] network The destination network.
+     * \param [in] mask The destination mask, which may be non-contiguous.
+     * \param [in] value The value.
+     * \return \c true if the value was found and removed.
+     */
+    template <class Address, class Prefix>
+    bool RemoveNetwork(Address network, Prefix mask, const T& value);
+
+    /** Remove all the values. */
+    void Clear();
+
+    /**
+     * \return The number of values in the trie.
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * Get the values of all the prefixes matching an address.
+     *
+     * The items are appended to \p items from the longest to the shortest
+     * prefix, and in insertion order within a prefix.
+     *
+     * \param [in] key The address.
+     * \param [out] items The items matching \p key.
+     */
+    void Lookup(const Key& key, std::vector<Item>& items) const;
+
+    /**
+     * Get the values of the longest prefix matching an address.
+     *
+     * \param [in] key The address.
+     * \return The items of the longest matching prefix, in insertion
+     *         order, or \c nullptr if no prefix matches.
+     */
+    const std::vector<Item>* LookupLongest(const Key& key) const;
+
+    /**
+     * Get the values of all the prefixes matching an address, in insertion
+     * order, which is the order of the route lists of the routing protocols.
+     *
+     * \tparam Address \c Ipv4Address or \c Ipv6Address.
+     * \param [in] address The address.
+     * \param [out] values The values matching \p address.
+     */
+    template <class Address>
+    void LookupInOrder(Address address, std::vector<T>& values) const;
+
+  private:
+    /** A trie node: a prefix, and its values if it is not only a branching point. */
+    struct Node
+    {
+        Key key;                          //!< The prefix, with the bits beyond length cleared.
+        uint8_t length;                   //!< The prefix length.
+        std::vector<Item> items;          //!< The values of this prefix.
+        std::unique_ptr<Node> child[2];   //!< Longer prefixes, by the bit following the prefix.
+    };
+
+    /**
+     * \param [in] key An address.
+     * \param [in] bit A bit index, from the most significant bit.
+     * \return The value of the bit.
+     */
+    static uint8_t GetBit(const Key& key, uint8_t bit);
+
+    /**
+     * \param [in] key An address.
+     * \param [in] length A prefix length.
+     * \return The address with the bits beyond \p length cleared.
+     */
+    static Key Mask(const Key& key, uint8_t length);
+
+    /**
+     * \param [in] a An address.
+     * \param [in] b Another address.
+     * \param [in] max The maximum length to compare.
+     * \return The length of the common prefix of \p a and \p b, up to \p max.
+     */
+    static uint8_t CommonLength(const Key& a, const Key& b, uint8_t max);
+
+    /**
+     * Remove a value from the subtree rooted at \p node, and remove the
+     * nodes left useless.
+     *
+     * \param [in,out] node The subtree root.
+     * \param [in] key The masked prefix address.
+     * \param [in] length The prefix length.
+     * \param [in] value The value.
+     * \return \c true if the value was found and removed.
+     */
+    static bool Remove(std::unique_ptr<Node>& node, const Key& key, uint8_t length, const T& value);
+
+    std::unique_ptr<Node> m_root; //!< The root of the trie.
+    std::size_t m_size;           //!< The number of values.
+    uint64_t m_order;             //!< The insertion order of the next value.
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <std::size_t N, class T>
+LpmTrie<N, T>::LpmTrie()
+    : m_size(0),
+      m_order(0)
+{
+}
+
+template <std::size_t N, class T>
+uint8_t
+LpmTrie<N, T>::GetBit(const Key& key, uint8_t bit)
+{
+    return (key[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+template <std::size_t N, class T>
+typename LpmTrie<N, T>::Key
+LpmTrie<N, T>::Mask(const Key& key, uint8_t length)
+{
+    Key masked{};
+    for (std::size_t i = 0; i < N && length > 0; i++)
+    {
+        if (length >= 8)
+        {
+            masked[i] = key[i];
+            length -= 8;
+        }
+        else
+        {
+            masked[i] = key[i] & static_cast<uint8_t>(0xff << (8 - length));
+            length = 0;
+        }
+    }
+    return masked;
+}
+
+template <std::size_t N, class T>
+uint8_t
+LpmTrie<N, T>::CommonLength(const Key& a, const Key& b, uint8_t max)
+{
+    uint8_t length = 0;
+    std::size_t i = 0;
+    while (i < N && a[i] == b[i])
+    {
+        i++;
+        length += 8;
+    }
+    if (i < N)
+    {
+        uint8_t diff = a[i] ^ b[i];
+        while (!(diff & 0x80))
+        {
+            diff <<= 1;
+            length++;
+        }
+    }
+    return std::min(length, max);
+}
+
+template <std::size_t N, class T>
+void
+LpmTrie<N, T>::Insert(const Key& key, uint8_t length, const T& value)
+{
+    NS_ASSERT_MSG(length <= 8 * N, "Prefix length " << +length << " out of range");
+    const Key masked = Mask(key, length);
+    const Item item{m_order++, length, value};
+    m_size++;
+
+    std::unique_ptr<Node>* link = &m_root;
+    while (true)
+    {
+        Node* node = link->get();
+        if (node == nullptr)
+        {
+            *link = std::make_unique<Node>();
+            (*link)->key = masked;
+            (*link)->length = length;
+            (*link)->items.push_back(item);
+            return;
+        }
+        uint8_t common = CommonLength(masked, node->key, std::min(length, node->length));
+        if (common == node->length && common == length)
+        {
+            // Same prefix: add the value to the group
+            node->items.push_back(item);
+            return;
+        }
+        if (common == node->length)
+        {
+            // The node prefix is a prefix of the new one: go down
+            link = &node->child[GetBit(masked, node->length)];
+            continue;
+        }
+        // The prefixes diverge, or the new one is a prefix of the node one
+        auto inserted = std::make_unique<Node>();
+        inserted->key = Mask(masked, common);
+        inserted->length = common;
+        inserted->child[GetBit(node->key, common)] = std::move(*link);
+        if (common == length)
+        {
+            inserted->items.push_back(item);
+        }
+        else
+        {
+            auto leaf = std::make_unique<Node>();
+            leaf->key = masked;
+            leaf->length = length;
+            leaf->items.push_back(item);
+            inserted->child[GetBit(masked, common)] = std::move(leaf);
+        }
+        *link = std::move(inserted);
+        return;
+    }
+}
+
+template <std::size_t N, class T>
+bool
+LpmTrie<N, T>::Remove(const Key& key, uint8_t length, const T& value)
+{
+    if (Remove(m_root, Mask(key, length), length, value))
+    {
+        m_size--;
+        return true;
+    }
+    return false;
+}
+
+template <std::size_t N, class T>
+bool
+LpmTrie<N, T>::Remove(std::unique_ptr<Node>& node,
+                      const Key& key,
+                      uint8_t length,
+                      const T& value)
+{
+    if (!node || node->length > length ||
+        CommonLength(key, node->key, node->length) < node->length)
+    {
+        return false;
+    }
+    bool found = false;
+    if (node->length == length)
+    {
+        auto it = std::find_if(node->items.begin(), node->items.end(), [&value](const Item& item) {
+            return item.value == value;
+        });
+        if (it != node->items.end())
+        {
+            node->items.erase(it);
+            found = true;
+        }
+    }
+    else
+    {
+        found = Remove(node->child[GetBit(key, node->length)], key, length, value);
+    }
+    // A node without values is only needed to branch between two subtrees
+    if (found && node->items.empty() && !(node->child[0] && node->child[1]))
+    {
+        std::unique_ptr<Node> next = std::move(node->child[node->child[0] ? 0 : 1]);
+        node = std::move(next);
+    }
+    return found;
+}
+
+template <std::size_t N, class T>
+template <class Address, class Prefix>
+void
+LpmTrie<N, T>::InsertNetwork(Address network, Prefix mask, const T& value)
+{
+    uint8_t length;
+    const Key key = GetLpmTrieKey(network, mask, length);
+    Insert(key, length, value);
+}
+
+template <std::size_t N, class T>
+template <class Address, class Prefix>
+bool
+LpmTrie<N, T>::RemoveNetwork(Address network, Prefix mask, const T& value)
+{
+    uint8_t length;
+    const Key key = GetLpmTrieKey(network, mask, length);
+    return Remove(key, length, value);
+}
+
+template <std::size_t N, class T>
+void
+LpmTrie<N, T>::Clear()
+{
+    m_root.reset();
+    m_size = 0;
+}
+
+template <std::size_t N, class T>
+std::size_t
+LpmTrie<N, T>::GetSize() const
+{
+    return m_size;
+}
+
+template <std::size_t N, class T>
+void
+LpmTrie<N, T>::Lookup(const Key& key, std::vector<Item>& items) const
+{
+    // The matching nodes, from the shortest to the longest prefix
+    std::array<const Node*, 8 * N + 1> path;
+    std::size_t depth = 0;
+    const Node* node = m_root.get();
+    while (node && CommonLength(key, node->key, node->length) == node->length)
+    {
+        if (!node->items.empty())
+        {
+            path[depth++] = node;
+        }
+        if (node->length == 8 * N)
+        {
+            break;
+        }
+        node = node->child[GetBit(key, node->length)].get();
+    }
+    while (depth > 0)
+    {
+        const Node* match = path[--depth];
+        items.insert(items.end(), match->items.begin(), match->items.end());
+    }
+}
+
+template <std::size_t N, class T>
+const std::vector<typename LpmTrie<N, T>::Item>*
+LpmTrie<N, T>::LookupLongest(const Key& key) const
+{
+    const std::vector<Item>* longest = nullptr;
+    const Node* node = m_root.get();
+    while (node && CommonLength(key, node->key, node->length) == node->length)
+    {
+        if (!node->items.empty())
+        {
+            longest = &node->items;
+        }
+        if (node->length == 8 * N)
+        {
+            break;
+        }
+        node = node->child[GetBit(key, node->length)].get();
+    }
+    return longest;
+}
+
+template <std::size_t N, class T>
+template <class Address>
+void
+LpmTrie<N, T>::LookupInOrder(Address address, std::vector<T>& values) const
+{
+    std::vector<Item> items;
+    Lookup(GetLpmTrieKey(address), items);
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.order < b.order;
+    });
+    values.clear();
+    for (const auto& item : items)
+    {
+        values.push_back(item.value);
+    }
+}
+
+} // namespace ns3
+
+#endif /* LPM_TRIE_H */
@@ -26,8 +26,11 @@
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -101,9 +104,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    auto it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -127,6 +131,10 @@ NdiscCache::LookupInverse(Address dst)
             entryList.push_back(entry);
         }
     }
+    // Return the entries in address order, whatever the hash table order
+    entryList.sort([](const NdiscCache::Entry* a, const NdiscCache::Entry* b) {
+        return a->GetIpv6Address() < b->GetIpv6Address();
+    });
     return entryList;
 }
 
@@ -147,15 +155,12 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -170,6 +175,48 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_nudEvent.Cancel();
+}
+
+void
+NdiscCache::ScheduleNudTimeout()
+{
+    if (m_nudTimers.empty())
+    {
+        m_nudEvent.Cancel();
+        return;
+    }
+    Time next = m_nudTimers.begin()->first;
+    if (m_nudEvent.IsRunning() && Time(m_nudEvent.GetTs()) == next)
+    {
+        return;
+    }
+    m_nudEvent.Cancel();
+    m_nudEvent = Simulator::Schedule(next - Simulator::Now(), &NdiscCache::HandleNudTimeout, this);
+}
+
+void
+NdiscCache::HandleNudTimeout()
+{
+    NS_LOG_FUNCTION(this);
+
+    Time now = Simulator::Now();
+    while (!m_nudTimers.empty() && m_nudTimers.begin()->first <= now)
+    {
+        Entry* entry = m_nudTimers.begin()->second;
+        m_nudTimers.erase(m_nudTimers.begin());
+        if (entry->m_nudDeadline > now)
+        {
+            // The reachable timer has been updated since it was queued
+            entry->m_nudQueued = m_nudTimers.emplace(entry->m_nudDeadline, entry);
+            continue;
+        }
+        // The function may rearm the timer or delete the entry
+        auto function = entry->m_nudFunction;
+        entry->m_nudFunction = nullptr;
+        (entry->*function)();
+    }
+    ScheduleNudTimeout();
 }
 
 void
@@ -192,7 +239,9 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // Print the entries in address order
+    std::map<Ipv6Address, NdiscCache::Entry*> sorted(m_ndCache.begin(), m_ndCache.end());
+    for (auto i = sorted.begin(); i != sorted.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -247,13 +296,38 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
       m_lastReachabilityConfirmation(Seconds(0.0)),
       m_nsRetransmit(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
+NdiscCache::Entry::~Entry()
+{
+    CancelNudTimer();
+}
+
+void
+NdiscCache::Entry::ScheduleNudTimer(void (Entry::*function)(), Time delay)
+{
+    CancelNudTimer();
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudDeadline = Simulator::Now() + delay;
+    m_nudQueued = m_ndCache->m_nudTimers.emplace(m_nudDeadline, this);
+    m_ndCache->ScheduleNudTimeout();
+}
+
+void
+NdiscCache::Entry::CancelNudTimer()
+{
+    if (m_nudFunction)
+    {
+        m_ndCache->m_nudTimers.erase(m_nudQueued);
+        m_nudFunction = nullptr;
+    }
+}
+
 void
 NdiscCache::Entry::SetRouter(bool router)
 {
@@ -469,15 +543,10 @@ void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
 
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    ScheduleNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                     m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -488,11 +557,16 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
+        if (m_nudFunction)
+        {
+            // Postpone the expiry without moving the entry in the timer
+            // queue: it is moved when its queued time is reached
+            m_nudDeadline = Simulator::Now() + m_nudDelay;
+        }
+        else if (!m_nudDelay.IsZero())
         {
-            m_nudTimer.Cancel();
+            ScheduleNudTimer(&NdiscCache::Entry::FunctionReachableTimeout, m_nudDelay);
         }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -500,49 +574,31 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    ScheduleNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                     m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    ScheduleNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                     m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    ScheduleNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                     m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    CancelNudTimer();
     m_nsRetransmit = 0;
 }
 
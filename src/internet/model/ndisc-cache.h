@@ -20,6 +20,7 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "ns3/event-id.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -31,6 +32,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -172,7 +174,7 @@ class NdiscCache : public Object
          */
         Entry(NdiscCache* nd);
 
-        virtual ~Entry() = default;
+        virtual ~Entry();
 
         /**
          * \brief The Entry state enumeration.
@@ -412,6 +414,20 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        friend class NdiscCache;
+
+        /**
+         * \brief Arm the NUD timer.
+         * \param function the function called when the timer expires
+         * \param delay the delay before the timer expires
+         */
+        void ScheduleNudTimer(void (Entry::*function)(), Time delay);
+
+        /**
+         * \brief Disarm the NUD timer.
+         */
+        void CancelNudTimer();
+
         /**
          * \brief The IPv6 address.
          */
@@ -433,9 +449,29 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * \brief Timer (used for NUD).
+         * \brief Function called when the NUD timer expires, null if the
+         * timer is not running.
+         */
+        void (Entry::*m_nudFunction)(){nullptr};
+
+        /**
+         * \brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * \brief Expiry time of the NUD timer.
+         *
+         * It may be later than the position of the entry in the timer queue
+         * of the cache, when the reachable timer has been updated.
+         */
+        Time m_nudDeadline;
+
+        /**
+         * \brief Position of the entry in the timer queue of the cache, when
+         * the NUD timer is running.
          */
-        Timer m_nudTimer;
+        std::multimap<Time, Entry*>::iterator m_nudQueued;
 
         /**
          * \brief Last time we see a reachability confirmation.
@@ -457,11 +493,11 @@ class NdiscCache : public Object
     /**
      * \brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * \brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash>::iterator CacheI;
 
     /**
      * \brief A list of Entry.
@@ -469,6 +505,29 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * \brief Handle the expiry of the NUD timers of the entries.
+     */
+    void HandleNudTimeout();
+
+    /**
+     * \brief Schedule the expiry of the earliest NUD timer, if not already.
+     */
+    void ScheduleNudTimeout();
+
+    /**
+     * \brief The NUD timers of the entries, by expiry time.
+     *
+     * A single event is scheduled for the earliest timer, instead of an
+     * event per entry.
+     */
+    std::multimap<Time, Entry*> m_nudTimers;
+
+    /**
+     * \brief The event of the earliest NUD timer.
+     */
+    EventId m_nudEvent;
+
     /**
      * \brief The NetDevice.
      */
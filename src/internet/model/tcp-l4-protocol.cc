@@ -44,7 +44,9 @@
 #include "ns3/nstime.h"
 #include "ns3/object-map.h"
 #include "ns3/packet.h"
+#include "ns3/queue-disc.h"
 #include "ns3/simulator.h"
+#include "ns3/traffic-control-layer.h"
 
 #include <iomanip>
 #include <sstream>
@@ -588,9 +590,10 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
                             const Ipv4Address& saddr,
                             const Ipv4Address& daddr,
-                            Ptr<NetDevice> oif) const
+                            Ptr<NetDevice> oif,
+                            uint32_t segmentSize) const
 {
-    NS_LOG_FUNCTION(this << packet << saddr << daddr << oif);
+    NS_LOG_FUNCTION(this << packet << saddr << daddr << oif << segmentSize);
     NS_LOG_LOGIC("TcpL4Protocol " << this << " sending seq " << outgoing.GetSequenceNumber()
                                   << " ack " << outgoing.GetAckNumber() << " flags "
                                   << TcpHeader::FlagsToString(outgoing.GetFlags()) << " data size "
@@ -606,6 +609,11 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
     }
     outgoingHeader.InitializeChecksum(saddr, daddr, PROT_NUMBER);
 
+    Ptr<Packet> payload;
+    if (packet->GetSize() > segmentSize && segmentSize > 0)
+    {
+        payload = packet->Copy();
+    }
     packet->AddHeader(outgoingHeader);
 
     Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
@@ -626,6 +634,16 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
             NS_LOG_ERROR("No IPV4 Routing Protocol");
             route = nullptr;
         }
+        if (payload && route &&
+            MustSegment(route->GetOutputDevice(),
+                        packet->GetSize() + header.GetSerializedSize()))
+        {
+            for (const auto& segment : Segment(payload, outgoingHeader, segmentSize))
+            {
+                m_downTarget(segment, saddr, daddr, PROT_NUMBER, route);
+            }
+            return;
+        }
         m_downTarget(packet, saddr, daddr, PROT_NUMBER, route);
     }
     else
@@ -639,9 +657,10 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
                             const Ipv6Address& saddr,
                             const Ipv6Address& daddr,
-                            Ptr<NetDevice> oif) const
+                            Ptr<NetDevice> oif,
+                            uint32_t segmentSize) const
 {
-    NS_LOG_FUNCTION(this << packet << saddr << daddr << oif);
+    NS_LOG_FUNCTION(this << packet << saddr << daddr << oif << segmentSize);
     NS_LOG_LOGIC("TcpL4Protocol " << this << " sending seq " << outgoing.GetSequenceNumber()
                                   << " ack " << outgoing.GetAckNumber() << " flags "
                                   << TcpHeader::FlagsToString(outgoing.GetFlags()) << " data size "
@@ -654,7 +673,8 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
                            outgoing,
                            saddr.GetIpv4MappedAddress(),
                            daddr.GetIpv4MappedAddress(),
-                           oif));
+                           oif,
+                           segmentSize));
     }
     TcpHeader outgoingHeader = outgoing;
     /** \todo UrgentPointer */
@@ -665,6 +685,11 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
     }
     outgoingHeader.InitializeChecksum(saddr, daddr, PROT_NUMBER);
 
+    Ptr<Packet> payload;
+    if (packet->GetSize() > segmentSize && segmentSize > 0)
+    {
+        payload = packet->Copy();
+    }
     packet->AddHeader(outgoingHeader);
 
     Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol>();
@@ -685,6 +710,16 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
             NS_LOG_ERROR("No IPV6 Routing Protocol");
             route = nullptr;
         }
+        if (payload && route &&
+            MustSegment(route->GetOutputDevice(),
+                        packet->GetSize() + header.GetSerializedSize()))
+        {
+            for (const auto& segment : Segment(payload, outgoingHeader, segmentSize))
+            {
+                m_downTarget6(segment, saddr, daddr, PROT_NUMBER, route);
+            }
+            return;
+        }
         m_downTarget6(packet, saddr, daddr, PROT_NUMBER, route);
     }
     else
@@ -693,14 +728,57 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
     }
 }
 
+bool
+TcpL4Protocol::MustSegment(Ptr<NetDevice> device, uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << device << size);
+
+    if (!device || size > device->GetMtu())
+    {
+        return true;
+    }
+    Ptr<TrafficControlLayer> tc = m_node->GetObject<TrafficControlLayer>();
+    return tc && tc->GetRootQueueDiscOnDevice(device);
+}
+
+std::vector<Ptr<Packet>>
+TcpL4Protocol::Segment(Ptr<Packet> pkt, const TcpHeader& outgoing, uint32_t segmentSize) const
+{
+    NS_LOG_FUNCTION(this << pkt << outgoing << segmentSize);
+
+    std::vector<Ptr<Packet>> segments;
+    uint32_t size = pkt->GetSize();
+    for (uint32_t offset = 0; offset < size; offset += segmentSize)
+    {
+        uint32_t length = std::min(segmentSize, size - offset);
+        Ptr<Packet> segment = pkt->CreateFragment(offset, length);
+        TcpHeader header = outgoing;
+        header.SetSequenceNumber(outgoing.GetSequenceNumber() + SequenceNumber32(offset));
+        uint8_t flags = outgoing.GetFlags();
+        if (offset > 0)
+        {
+            flags &= ~TcpHeader::CWR;
+        }
+        if (offset + length < size)
+        {
+            flags &= ~(TcpHeader::FIN | TcpHeader::PSH);
+        }
+        header.SetFlags(flags);
+        segment->AddHeader(header);
+        segments.push_back(segment);
+    }
+    return segments;
+}
+
 void
 TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                           const TcpHeader& outgoing,
                           const Address& saddr,
                           const Address& daddr,
-                          Ptr<NetDevice> oif) const
+                          Ptr<NetDevice> oif,
+                          uint32_t segmentSize) const
 {
-    NS_LOG_FUNCTION(this << pkt << outgoing << saddr << daddr << oif);
+    NS_LOG_FUNCTION(this << pkt << outgoing << saddr << daddr << oif << segmentSize);
     if (Ipv4Address::IsMatchingType(saddr))
     {
         NS_ASSERT(Ipv4Address::IsMatchingType(daddr));
@@ -709,7 +787,8 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                      outgoing,
                      Ipv4Address::ConvertFrom(saddr),
                      Ipv4Address::ConvertFrom(daddr),
-                     oif);
+                     oif,
+                     segmentSize);
 
         return;
     }
@@ -721,7 +800,8 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                      outgoing,
                      Ipv6Address::ConvertFrom(saddr),
                      Ipv6Address::ConvertFrom(daddr),
-                     oif);
+                     oif,
+                     segmentSize);
 
         return;
     }
@@ -730,7 +810,7 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
         InetSocketAddress s = InetSocketAddress::ConvertFrom(saddr);
         InetSocketAddress d = InetSocketAddress::ConvertFrom(daddr);
 
-        SendPacketV4(pkt, outgoing, s.GetIpv4(), d.GetIpv4(), oif);
+        SendPacketV4(pkt, outgoing, s.GetIpv4(), d.GetIpv4(), oif, segmentSize);
 
         return;
     }
@@ -739,7 +819,7 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
         Inet6SocketAddress s = Inet6SocketAddress::ConvertFrom(saddr);
         Inet6SocketAddress d = Inet6SocketAddress::ConvertFrom(daddr);
 
-        SendPacketV6(pkt, outgoing, s.GetIpv6(), d.GetIpv6(), oif);
+        SendPacketV6(pkt, outgoing, s.GetIpv6(), d.GetIpv6(), oif, segmentSize);
 
         return;
     }
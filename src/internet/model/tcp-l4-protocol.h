@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -222,12 +223,16 @@ class TcpL4Protocol : public IpL4Protocol
      * \param saddr The source Ipv4Address
      * \param daddr The destination Ipv4Address
      * \param oif The output interface bound. Defaults to null (unspecified).
+     * \param segmentSize When not zero, the packet is a super-segment which
+     *        is split into segments of this size if its output device needs
+     *        them (see MustSegment). Defaults to zero.
      */
     void SendPacket(Ptr<Packet> pkt,
                     const TcpHeader& outgoing,
                     const Address& saddr,
                     const Address& daddr,
-                    Ptr<NetDevice> oif = nullptr) const;
+                    Ptr<NetDevice> oif = nullptr,
+                    uint32_t segmentSize = 0) const;
 
     /**
      * \brief Make a socket fully operational
@@ -355,12 +360,14 @@ class TcpL4Protocol : public IpL4Protocol
      * \param saddr The source Ipv4Address
      * \param daddr The destination Ipv4Address
      * \param oif The output interface bound. Defaults to null (unspecified).
+     * \param segmentSize The size of the segments of a super-segment, or zero.
      */
     void SendPacketV4(Ptr<Packet> pkt,
                       const TcpHeader& outgoing,
                       const Ipv4Address& saddr,
                       const Ipv4Address& daddr,
-                      Ptr<NetDevice> oif = nullptr) const;
+                      Ptr<NetDevice> oif = nullptr,
+                      uint32_t segmentSize = 0) const;
 
     /**
      * \brief Send a packet via TCP (IPv6)
@@ -370,12 +377,44 @@ class TcpL4Protocol : public IpL4Protocol
      * \param saddr The source Ipv4Address
      * \param daddr The destination Ipv4Address
      * \param oif The output interface bound. Defaults to null (unspecified).
+     * \param segmentSize The size of the segments of a super-segment, or zero.
      */
     void SendPacketV6(Ptr<Packet> pkt,
                       const TcpHeader& outgoing,
                       const Ipv6Address& saddr,
                       const Ipv6Address& daddr,
-                      Ptr<NetDevice> oif = nullptr) const;
+                      Ptr<NetDevice> oif = nullptr,
+                      uint32_t segmentSize = 0) const;
+
+    /**
+     * \brief Check whether a super-segment must be split before being sent
+     *
+     * Super-segments are only handed to the IP layer as a whole when the
+     * output device can carry them in a single frame and no queue disc is
+     * installed on it, so that the queue discs and the losses on the links
+     * with a usual MTU still apply to each segment.
+     *
+     * \param device The output device
+     * \param size The size of the super-segment, with its IP and TCP headers
+     * \return true if the super-segment must be split
+     */
+    bool MustSegment(Ptr<NetDevice> device, uint32_t size) const;
+
+    /**
+     * \brief Split a super-segment into segments
+     *
+     * The segments copy the header of the super-segment, with their own
+     * sequence number. The FIN and PSH flags are only kept on the last
+     * segment, and the CWR flag on the first one.
+     *
+     * \param pkt The payload of the super-segment
+     * \param outgoing The header of the super-segment
+     * \param segmentSize The size of the segments
+     * \return The segments, with their header
+     */
+    std::vector<Ptr<Packet>> Segment(Ptr<Packet> pkt,
+                                     const TcpHeader& outgoing,
+                                     uint32_t segmentSize) const;
 };
 
 } // namespace ns3
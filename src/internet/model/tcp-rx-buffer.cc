@@ -52,6 +52,7 @@ TcpRxBuffer::GetTypeId()
  */
 TcpRxBuffer::TcpRxBuffer(uint32_t n)
     : m_nextRxSeq(n),
+      m_headSeq(n),
       m_gotFin(false),
       m_size(0),
       m_maxBuffer(32768),
@@ -117,9 +118,9 @@ TcpRxBuffer::MaxRxSequence() const
     { // No data allowed beyond FIN
         return m_finSeq;
     }
-    else if (!m_data.empty() && m_nextRxSeq > m_data.begin()->first)
+    else if (!m_inOrder.empty())
     { // No data allowed beyond Rx window allowed
-        return m_data.begin()->first + SequenceNumber32(m_maxBuffer);
+        return m_headSeq + SequenceNumber32(m_maxBuffer);
     }
     return m_nextRxSeq + SequenceNumber32(m_maxBuffer);
 }
@@ -159,9 +160,10 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
     {
         headSeq = m_nextRxSeq;
     }
-    if (!m_data.empty())
+    if (!m_inOrder.empty() || !m_data.empty())
     {
-        SequenceNumber32 maxSeq = m_data.begin()->first + SequenceNumber32(m_maxBuffer);
+        SequenceNumber32 firstSeq = m_inOrder.empty() ? m_data.begin()->first : m_headSeq;
+        SequenceNumber32 maxSeq = firstSeq + SequenceNumber32(m_maxBuffer);
         if (maxSeq < tailSeq)
         {
             tailSeq = maxSeq;
@@ -171,8 +173,14 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    auto i = m_data.begin();
+    // Remove overlapped bytes from packet. The in-order data ends before
+    // headSeq, and the out-of-order data do not overlap each other, so only
+    // the data starting from the fragment which may hold headSeq is checked.
+    auto i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
         SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
@@ -201,39 +209,44 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
         NS_LOG_LOGIC("Nothing to buffer");
         return false; // Nothing to buffer anyway
     }
-    else
+    else if (headSeq != tcph.GetSequenceNumber() ||
+             static_cast<uint32_t>(tailSeq - headSeq) != pktSize)
     {
         uint32_t start = static_cast<uint32_t>(headSeq - tcph.GetSequenceNumber());
         auto length = static_cast<uint32_t>(tailSeq - headSeq);
         p = p->CreateFragment(start, length);
         NS_ASSERT(length == p->GetSize());
     }
-    // Insert packet into buffer
-    NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
-    m_data[headSeq] = p;
 
+    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
+    m_size += p->GetSize(); // Occupancy
     if (headSeq > m_nextRxSeq)
     {
-        // Generate a new SACK block
+        // Insert packet into the out-of-order data, and generate a new SACK block
+        NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
+        m_data.emplace(headSeq, p);
         UpdateSackList(headSeq, tailSeq);
     }
-
-    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
-    // Update variables
-    m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    else
     {
-        if (i->first < m_nextRxSeq)
+        // Append the packet, and the out-of-order data it makes contiguous, to
+        // the in-order data
+        if (m_inOrder.empty())
         {
-            continue;
+            m_headSeq = headSeq;
         }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
-        m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
-        m_availBytes += i->second->GetSize();
+        m_inOrder.push_back(p);
+        m_nextRxSeq = tailSeq;
+        m_availBytes += p->GetSize();
         ClearSackList(m_nextRxSeq);
+        for (i = m_data.begin(); i != m_data.end() && i->first == m_nextRxSeq;)
+        {
+            m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
+            m_availBytes += i->second->GetSize();
+            m_inOrder.push_back(i->second);
+            ClearSackList(m_nextRxSeq);
+            i = m_data.erase(i);
+        }
     }
     NS_LOG_LOGIC("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
     if (m_gotFin && m_nextRxSeq == m_finSeq)
@@ -387,41 +400,44 @@ TcpRxBuffer::Extract(uint32_t maxSize)
     {
         return nullptr; // No contiguous block to return
     }
-    NS_ASSERT(!m_data.empty());            // At least we have something to extract
-    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
-    BufIterator i;
+    NS_ASSERT(!m_inOrder.empty()); // At least we have something to extract
+    Ptr<Packet> outPkt;            // The packet that contains all the data to return
+    bool concatenated = false;     // Whether outPkt is a copy owned by this method
     while (extractSize)
     { // Check the buffered data for delivery
-        i = m_data.begin();
-        NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
+        Ptr<Packet> fragment = m_inOrder.front();
         // Check if we send the whole pkt or just a partial
-        uint32_t pktSize = i->second->GetSize();
+        uint32_t pktSize = fragment->GetSize();
+        uint32_t size = std::min(pktSize, extractSize);
         if (pktSize <= extractSize)
         { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
-            m_data.erase(i);
-            m_size -= pktSize;
-            m_availBytes -= pktSize;
-            extractSize -= pktSize;
+            m_inOrder.pop_front();
         }
         else
         { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
-            m_data[i->first + SequenceNumber32(extractSize)] =
-                i->second->CreateFragment(extractSize, pktSize - extractSize);
-            m_data.erase(i);
-            m_size -= extractSize;
-            m_availBytes -= extractSize;
-            extractSize = 0;
+            m_inOrder.front() = fragment->CreateFragment(extractSize, pktSize - extractSize);
+            fragment = fragment->CreateFragment(0, extractSize);
         }
-    }
-    if (outPkt->GetSize() == 0)
-    {
-        NS_LOG_LOGIC("Nothing extracted.");
-        return nullptr;
+        if (!outPkt)
+        { // The first fragment is handed over without copy
+            outPkt = fragment;
+        }
+        else
+        {
+            if (!concatenated)
+            {
+                outPkt = outPkt->Copy();
+                concatenated = true;
+            }
+            outPkt->AddAtEnd(fragment);
+        }
+        m_headSeq += size;
+        m_size -= size;
+        m_availBytes -= size;
+        extractSize -= size;
     }
     NS_LOG_LOGIC("Extracted " << outPkt->GetSize() << " bytes, bufsize=" << m_size
-                              << ", num pkts in buffer=" << m_data.size());
+                              << ", num pkts in buffer=" << m_inOrder.size() + m_data.size());
     return outPkt;
 }
 
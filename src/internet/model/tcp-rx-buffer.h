@@ -28,6 +28,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-value.h"
 
+#include <deque>
 #include <map>
 
 namespace ns3
@@ -55,6 +56,13 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * The in-order data is kept in a FIFO queue of fragments, and the out-of-order
+ * data in a map indexed by the starting sequence number of each fragment. The
+ * segments received are stored without being copied, unless they overlap data
+ * already buffered, and Extract hands the fragments over to the application
+ * as they are, only concatenating them when a single read spans several
+ * fragments.
+ *
  * SACK list
  * ---------
  *
@@ -155,6 +163,9 @@ class TcpRxBuffer : public Object
      * Extract data from the head of the buffer as indicated by nextRxSeq.
      * The extracted data is going to be forwarded to the application.
      *
+     * When the data extracted is exactly one of the buffered fragments, the
+     * packet stored by Add is returned as is.
+     *
      * \param maxSize maximum number of bytes to extract
      * \returns a packet
      */
@@ -222,16 +233,16 @@ class TcpRxBuffer : public Object
 
     TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
-    /// container for data stored in the buffer
-    typedef std::map<SequenceNumber32, Ptr<Packet>>::iterator BufIterator;
     TracedValue<SequenceNumber32>
         m_nextRxSeq;           //!< Seqnum of the first missing byte in data (RCV.NXT)
+    SequenceNumber32 m_headSeq; //!< Seqnum of the first in-order byte not extracted yet
     SequenceNumber32 m_finSeq; //!< Seqnum of the FIN packet
     bool m_gotFin;             //!< Did I received FIN packet?
     uint32_t m_size;       //!< Number of total data bytes in the buffer, not necessarily contiguous
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
-    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    std::deque<Ptr<Packet>> m_inOrder; //!< In-order data, from m_headSeq to m_nextRxSeq
+    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Out-of-order data, by starting seqnum
 };
 
 } // namespace ns3
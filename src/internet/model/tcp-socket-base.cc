@@ -161,6 +161,20 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("SegmentationOffloadSize",
+                          "Maximum size of the super-segments of new data sent at once, which "
+                          "are split into segments down the stack only when the output device "
+                          "needs it (segmentation offload). 0 disables the offload.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ReceiveOffloadTimeout",
+                          "Time during which in-order data segments are held to be coalesced "
+                          "with the following ones before being processed (receive offload). "
+                          "0 disables the offload.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&TcpSocketBase::m_groTimeout),
+                          MakeTimeChecker())
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -331,6 +345,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_delAckCount(0),
       m_delAckMaxCount(sock.m_delAckMaxCount),
       m_noDelay(sock.m_noDelay),
+      m_tsoSize(sock.m_tsoSize),
+      m_groTimeout(sock.m_groTimeout),
       m_synCount(sock.m_synCount),
       m_synRetries(sock.m_synRetries),
       m_dataRetrCount(sock.m_dataRetrCount),
@@ -2621,6 +2637,9 @@ TcpSocketBase::PeerClose(Ptr<Packet> p, const TcpHeader& tcpHeader)
 {
     NS_LOG_FUNCTION(this << tcpHeader);
 
+    // The data held to be coalesced precede the FIN
+    FlushReceivedData();
+
     // Ignore all out of range packets
     if (tcpHeader.GetSequenceNumber() < m_tcb->m_rxBuffer->NextRxSequence() ||
         tcpHeader.GetSequenceNumber() > m_tcb->m_rxBuffer->MaxRxSequence())
@@ -3119,12 +3138,26 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     NS_LOG_FUNCTION(this << seq << maxSize << withAck);
 
     bool isStartOfTransmission = BytesInFlight() == 0U;
-    TcpTxItem* outItem = m_txBuffer->CopyFromSequence(maxSize, seq);
+    bool isSuperSegment = m_tsoSize > m_tcb->m_segmentSize && maxSize > m_tcb->m_segmentSize;
+    TcpTxItem* outItem =
+        m_txBuffer->CopyFromSequence(isSuperSegment ? m_tcb->m_segmentSize : maxSize, seq);
 
     m_rateOps->SkbSent(outItem, isStartOfTransmission);
 
     bool isRetransmission = outItem->IsRetrans();
     Ptr<Packet> p = outItem->GetPacketCopy();
+    // A super-segment is recorded in the TxBuffer as separate segments, so
+    // that the scoreboard and the rate samples still work on segments
+    while (isSuperSegment && !isRetransmission && p->GetSize() < maxSize &&
+           m_txBuffer->SizeFromSequence(seq + SequenceNumber32(p->GetSize())) > 0)
+    {
+        outItem =
+            m_txBuffer->CopyFromSequence(std::min(maxSize - p->GetSize(), m_tcb->m_segmentSize),
+                                         seq + SequenceNumber32(p->GetSize()));
+        m_rateOps->SkbSent(outItem, false);
+        p->AddAtEnd(outItem->GetPacketCopy());
+    }
+    uint32_t segmentSize = p->GetSize() > m_tcb->m_segmentSize ? m_tcb->m_segmentSize : 0;
     uint32_t sz = p->GetSize(); // Size of packet
     uint8_t flags = withAck ? TcpHeader::ACK : 0;
     uint32_t remainingData = m_txBuffer->SizeFromSequence(seq + SequenceNumber32(sz));
@@ -3221,7 +3254,8 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
                           header,
                           m_endPoint->GetLocalAddress(),
                           m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          segmentSize);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint->GetPeerAddress() << ". Header " << header);
@@ -3232,7 +3266,8 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
                           header,
                           m_endPoint6->GetLocalAddress(),
                           m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          segmentSize);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint6->GetPeerAddress() << ". Header " << header);
@@ -3372,6 +3407,17 @@ TcpSocketBase::SendPendingData(bool withAck)
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // With segmentation offload, new data is sent in super-segments
+            // of several full-sized segments, within the windows
+            if (m_tsoSize > m_tcb->m_segmentSize && s == m_tcb->m_segmentSize &&
+                next >= m_tcb->m_highTxMark.Get() && !IsPacingEnabled())
+            {
+                SequenceNumber32 rWndEdge = m_highRxAckMark.Get() + SequenceNumber32(m_rWnd.Get());
+                uint32_t superSize = std::min({availableWindow, availableData, m_tsoSize});
+                superSize = std::min<uint32_t>(superSize, std::max(rWndEdge - next, 0));
+                s = std::max(s, superSize - superSize % m_tcb->m_segmentSize);
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3522,6 +3568,64 @@ void
 TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
 {
     NS_LOG_FUNCTION(this << tcpHeader);
+
+    if (m_groTimeout.IsStrictlyPositive())
+    {
+        // Only in-order data without FIN is coalesced, up to the size of an
+        // IPv4 datagram
+        bool coalesce = m_state == ESTABLISHED &&
+                        (tcpHeader.GetFlags() & (TcpHeader::SYN | TcpHeader::FIN |
+                                                 TcpHeader::RST | TcpHeader::URG)) == 0;
+        if (m_groPacket)
+        {
+            if (coalesce &&
+                tcpHeader.GetSequenceNumber() ==
+                    m_groHeader.GetSequenceNumber() + SequenceNumber32(m_groPacket->GetSize()) &&
+                m_groPacket->GetSize() + p->GetSize() <= 65535)
+            {
+                NS_LOG_DEBUG("Coalesce data segment, seq=" << tcpHeader.GetSequenceNumber()
+                                                           << " pkt size=" << p->GetSize());
+                m_groPacket->AddAtEnd(p);
+                m_groSegments++;
+                return;
+            }
+            FlushReceivedData();
+        }
+        if (coalesce && tcpHeader.GetSequenceNumber() == m_tcb->m_rxBuffer->NextRxSequence())
+        {
+            NS_LOG_DEBUG("Hold data segment, seq=" << tcpHeader.GetSequenceNumber()
+                                                   << " pkt size=" << p->GetSize());
+            m_groPacket = p->Copy();
+            m_groHeader = tcpHeader;
+            m_groSegments = 1;
+            m_groEvent =
+                Simulator::Schedule(m_groTimeout, &TcpSocketBase::FlushReceivedData, this);
+            return;
+        }
+    }
+    ProcessReceivedData(p, tcpHeader);
+}
+
+void
+TcpSocketBase::FlushReceivedData()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_groEvent.Cancel();
+    if (m_groPacket)
+    {
+        Ptr<Packet> p = m_groPacket;
+        m_groPacket = nullptr;
+        ProcessReceivedData(p, m_groHeader, m_groSegments);
+    }
+}
+
+void
+TcpSocketBase::ProcessReceivedData(Ptr<Packet> p,
+                                   const TcpHeader& tcpHeader,
+                                   uint32_t segments)
+{
+    NS_LOG_FUNCTION(this << tcpHeader << segments);
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
@@ -3580,8 +3684,15 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
         }
     }
     else
-    { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+    { // In-sequence packet: ACK if delayed ack count allows. Coalesced
+        // segments count as the segments received and, with the receive
+        // offload, super-segments as the full-sized segments they hold
+        if (m_groTimeout.IsStrictlyPositive())
+        {
+            segments = std::max(segments, p->GetSize() / m_tcb->m_segmentSize);
+        }
+        m_delAckCount += segments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -3999,6 +4110,8 @@ TcpSocketBase::CancelAllTimers()
     m_timewaitEvent.Cancel();
     m_sendPendingDataEvent.Cancel();
     m_pacingTimer.Cancel();
+    m_groEvent.Cancel();
+    m_groPacket = nullptr;
 }
 
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
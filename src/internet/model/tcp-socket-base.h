@@ -803,6 +803,10 @@ class TcpSocketBase : public TcpSocket
      * \brief Extract at most maxSize bytes from the TxBuffer at sequence seq, add the
      *        TCP header, and send to TcpL4Protocol
      *
+     * When maxSize is larger than the segment size, with segmentation
+     * offload enabled, the data is sent as a super-segment but recorded in
+     * the TxBuffer as separate segments.
+     *
      * \param seq the sequence number
      * \param maxSize the maximum data block to be transmitted (in bytes)
      * \param withAck forces an ACK to be sent
@@ -1044,11 +1048,33 @@ class TcpSocketBase : public TcpSocket
 
     /**
      * \brief Recv of a data, put into buffer, call L7 to get it if necessary
+     *
+     * With receive offload enabled, in-order data segments received in the
+     * ESTABLISHED state are held for up to ReceiveOffloadTimeout, and the
+     * contiguous segments received meanwhile are coalesced with them before
+     * being processed.
+     *
      * \param packet the packet
      * \param tcpHeader the packet's TCP header
      */
     virtual void ReceivedData(Ptr<Packet> packet, const TcpHeader& tcpHeader);
 
+    /**
+     * \brief Put received data into buffer, call L7 to get it if necessary,
+     *        and acknowledge it
+     * \param packet the packet
+     * \param tcpHeader the packet's TCP header
+     * \param segments the number of segments coalesced in the packet
+     */
+    void ProcessReceivedData(Ptr<Packet> packet,
+                             const TcpHeader& tcpHeader,
+                             uint32_t segments = 1);
+
+    /**
+     * \brief Process the data held to be coalesced, if any
+     */
+    void FlushReceivedData();
+
     /**
      * \brief Take into account the packet for RTT estimation
      * \param tcpHeader the packet's TCP header
@@ -1290,6 +1316,14 @@ class TcpSocketBase : public TcpSocket
     // Nagle algorithm
     bool m_noDelay{false}; //!< Set to true to disable Nagle's algorithm
 
+    // Segmentation and receive offloads
+    uint32_t m_tsoSize{0};     //!< Max size of the super-segments sent, 0 if disabled
+    Time m_groTimeout{0};      //!< Time in-order data is held to be coalesced, 0 if disabled
+    Ptr<Packet> m_groPacket;   //!< In-order data held to be coalesced
+    TcpHeader m_groHeader;     //!< Header of the first segment held
+    uint32_t m_groSegments{0}; //!< Number of segments held
+    EventId m_groEvent{};      //!< Event processing the data held
+
     // Retries
     uint32_t m_synCount{0};      //!< Count of remaining connection retries
     uint32_t m_synRetries{0};    //!< Number of connection attempts
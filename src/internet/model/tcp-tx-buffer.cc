@@ -61,7 +61,9 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostHigh(n),
+      m_nextSegHint(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -175,6 +177,8 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.empty());
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostHigh = seq;
+    m_nextSegHint = seq;
 }
 
 bool
@@ -295,7 +299,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexItem(m_sentList, m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -309,37 +313,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto found = m_sentIndex.find(seq);
+    if (found != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = found->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -376,6 +377,35 @@ TcpTxBuffer::FindHighestSacked() const
     return ret;
 }
 
+TcpTxBuffer::PacketList::iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    NS_ASSERT_MSG(seq >= m_firstByteSeq && seq < m_firstByteSeq + m_sentSize,
+                  "Sequence " << seq << " is not in the sent list " << *this);
+    auto it = m_sentIndex.upper_bound(seq);
+    NS_ASSERT(it != m_sentIndex.begin());
+    --it;
+    return it->second;
+}
+
+void
+TcpTxBuffer::IndexItem(const PacketList& list, PacketList::iterator it)
+{
+    if (&list == &m_sentList)
+    {
+        m_sentIndex[(*it)->m_startSeq] = it;
+    }
+}
+
+void
+TcpTxBuffer::UnindexItem(const PacketList& list, const TcpTxItem* item)
+{
+    if (&list == &m_sentList)
+    {
+        m_sentIndex.erase(item->m_startSeq);
+    }
+}
+
 void
 TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
 {
@@ -401,7 +431,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -438,11 +468,18 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+    if (&list == &m_sentList && seq >= listStartFrom)
+    {
+        // Start from the item holding seq, instead of walking the list
+        it = FindSentItem(seq);
+        beginOfCurrentPacket = (*it)->m_startSeq;
+    }
+
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(&list != &m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -471,7 +508,8 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                IndexItem(list, list.insert(it, firstPart));
+                IndexItem(list, it);
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -517,6 +555,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     NS_ASSERT(it != list.begin());
                     TcpTxItem* previous = *(--it);
 
+                    UnindexItem(list, previous);
                     list.erase(it);
 
                     MergeItems(previous, currentItem);
@@ -537,7 +576,8 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                IndexItem(list, list.insert(it, firstPart));
+                IndexItem(list, it);
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -566,6 +606,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                      // in the previous if
 
             MergeItems(currentItem, next);
+            UnindexItem(list, next);
             list.erase(it);
 
             delete next;
@@ -650,16 +691,14 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item holding the byte before ack can end at ack
+    if (ack <= m_firstByteSeq || ack > m_firstByteSeq + m_sentSize)
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *FindSentItem(ack - 1);
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -707,6 +746,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            UnindexItem(m_sentList, item);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -725,7 +765,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            UnindexItem(m_sentList, item);
             item->m_startSeq += offset;
+            IndexItem(m_sentList, i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -769,6 +811,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
     {
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
+    // Keep the sequence hints within the window, so that they do not wrap
+    m_lostHigh = std::max(m_lostHigh, m_firstByteSeq.Get());
+    m_nextSegHint = std::max(m_nextSegHint, m_firstByteSeq.Get());
 
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
@@ -788,15 +833,22 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // The items starting before the block cannot be sacked by it: start
+        // from the first item starting at or after the block
+        auto index_it = m_sentIndex.lower_bound((*option_it).first);
+        if (index_it == m_sentIndex.end())
+        {
+            continue;
+        }
+        auto item_it = index_it->second;
+        SequenceNumber32 beginOfCurrentPacket = (*item_it)->m_startSeq;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -876,8 +928,6 @@ void
 TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -889,34 +939,49 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+    // Walk down from the highest sacked item until m_dupAckThresh sacked
+    // items are found: the segments not sacked from there down are lost.
+    uint32_t sacked = 0;
+    auto it = m_highestSack.first;
+    while (true)
     {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
+        if ((*it)->m_sacked && it != m_sentList.begin())
         {
             sacked++;
         }
-
         if (sacked >= m_dupAckThresh)
         {
-            if (!item->m_sacked && !item->m_lost)
-            {
-                item->m_lost = true;
-                m_lostOut += item->m_packet->GetSize();
-            }
+            break;
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
+        if (it == m_sentList.begin())
+        {
+            NS_LOG_INFO("Status after the update: " << *this);
+            ConsistencyCheck();
+            return;
+        }
+        --it;
     }
 
-    if (sacked >= m_dupAckThresh)
+    // Mark them, down to the items already marked by the previous updates
+    SequenceNumber32 lostHigh = (*it)->m_startSeq + (*it)->m_packet->GetSize();
+    while ((*it)->m_startSeq + (*it)->m_packet->GetSize() > m_lostHigh)
     {
-        TcpTxItem* item = *m_sentList.begin();
-        if (!item->m_lost)
+        TcpTxItem* item = *it;
+        // The head is marked even if sacked, see DiscardUpTo
+        if (!item->m_lost && (!item->m_sacked || it == m_sentList.begin()))
         {
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
+            m_nextSegHint = std::min(m_nextSegHint, item->m_startSeq);
+        }
+        if (it == m_sentList.begin())
+        {
+            break;
         }
+        --it;
     }
+    m_lostHigh = std::max(m_lostHigh, lostHigh);
+
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
 }
@@ -931,25 +996,21 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    if (seq < m_firstByteSeq || seq >= m_firstByteSeq + m_sentSize)
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
-        {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+        return false;
+    }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
-        }
+    auto it = FindSentItem(seq);
+    if ((*it)->m_lost)
+    {
+        NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+        return true;
+    }
+
+    if ((*it)->m_sacked)
+    {
+        NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
     }
 
     return false;
@@ -978,31 +1039,42 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     bool isSeqPerRule3Valid = false;
     SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Check the head, then the items from m_nextSegHint: no other item can
+    // meet the three criteria.
+    auto it = m_sentList.begin();
+    while (it != m_sentList.end())
     {
         item = *it;
 
         // Condition 1.a , 1.b , and 1.c
-        if (!item->m_retrans && !item->m_sacked)
+        if (!item->m_retrans && !item->m_sacked && item->m_lost)
         {
-            if (item->m_lost)
+            NS_LOG_INFO("IsLost, returning" << item->m_startSeq);
+            if (it != m_sentList.begin())
             {
-                NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-                *seq = beginOfCurrentPkt;
-                *seqHigh = *seq + m_segmentSize;
-                return true;
-            }
-            else if (seqPerRule3.GetValue() == 0 && isRecovery)
-            {
-                NS_LOG_INFO("Saving for rule 3 the seq " << beginOfCurrentPkt);
-                isSeqPerRule3Valid = true;
-                seqPerRule3 = beginOfCurrentPkt;
+                m_nextSegHint = item->m_startSeq;
             }
+            *seq = item->m_startSeq;
+            *seqHigh = *seq + m_segmentSize;
+            return true;
         }
 
         // Nothing found, iterate
-        beginOfCurrentPkt += item->m_packet->GetSize();
+        SequenceNumber32 endOfCurrentPkt = item->m_startSeq + item->m_packet->GetSize();
+        if (it == m_sentList.begin() && m_nextSegHint > endOfCurrentPkt)
+        {
+            if (m_nextSegHint >= m_firstByteSeq + m_sentSize)
+            {
+                break;
+            }
+            it = FindSentItem(m_nextSegHint);
+        }
+        else
+        {
+            ++it;
+        }
     }
+    m_nextSegHint = m_firstByteSeq + m_sentSize;
 
     /* (2) If no sequence number 'S2' per rule (1) exists but there
      *     exists available unsent data and the receiver's advertised
@@ -1036,6 +1108,22 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
      *     (specifically excluding step (1.c)), then one segment of up to
      *     SMSS octets starting with S3 SHOULD be returned.
      */
+    for (it = m_sentList.begin(); isRecovery && it != m_sentList.end(); ++it)
+    {
+        item = *it;
+
+        // No item meets the criteria of rule (1), so S3 is not lost
+        if (!item->m_retrans && !item->m_sacked && seqPerRule3.GetValue() == 0)
+        {
+            NS_LOG_INFO("Saving for rule 3 the seq " << beginOfCurrentPkt);
+            isSeqPerRule3Valid = true;
+            seqPerRule3 = beginOfCurrentPkt;
+        }
+
+        // Nothing found, iterate
+        beginOfCurrentPkt += item->m_packet->GetSize();
+    }
+
     if (isSeqPerRule3Valid)
     {
         NS_LOG_INFO("Rule3 valid. " << seqPerRule3);
@@ -1217,6 +1305,8 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostHigh = m_firstByteSeq;
+    m_nextSegHint = m_firstByteSeq;
 }
 
 void
@@ -1241,11 +1331,14 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostHigh = m_firstByteSeq;
+    m_nextSegHint = m_firstByteSeq;
 }
 
 void
@@ -1256,6 +1349,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        UnindexItem(m_sentList, item);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1263,6 +1357,11 @@ TcpTxBuffer::ResetLastSegmentSent()
             m_retrans -= item->m_packet->GetSize();
         }
         m_appList.insert(m_appList.begin(), item);
+
+        // The item may be sent again with its flags: keep it above the hints
+        SequenceNumber32 highData = m_firstByteSeq + m_sentSize;
+        m_lostHigh = std::min(m_lostHigh, highData);
+        m_nextSegHint = std::min(m_nextSegHint, highData);
     }
     ConsistencyCheck();
 }
@@ -1309,6 +1408,10 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         (*it)->m_retrans = false;
     }
 
+    // All the items are either sacked or lost, and none is retransmitted
+    m_lostHigh = m_firstByteSeq + m_sentSize;
+    m_nextSegHint = m_firstByteSeq;
+
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
     ConsistencyCheck();
@@ -1419,9 +1522,7 @@ TcpTxBuffer::AddRenoSack()
 void
 TcpTxBuffer::ConsistencyCheck() const
 {
-    static const bool enable = false;
-
-    if (!enable)
+    if (!m_consistencyCheck)
     {
         return;
     }
@@ -1451,6 +1552,26 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed " << m_sentIndex.size() << " of " << m_sentList.size() << " items");
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << **it << " is not indexed");
+        if (it == m_sentList.begin())
+        {
+            // The head is checked apart by NextSeg, and marked by MarkHeadAsLost
+            continue;
+        }
+        NS_ASSERT_MSG(m_nextSegHint <= (*it)->m_startSeq || (*it)->m_retrans ||
+                          (*it)->m_sacked || !(*it)->m_lost,
+                      "Item " << **it << " is below the NextSeg hint " << m_nextSegHint);
+        NS_ASSERT_MSG((*it)->m_startSeq + (*it)->m_packet->GetSize() > m_lostHigh ||
+                          (*it)->m_sacked || (*it)->m_lost,
+                      "Item " << **it << " is below the lost mark " << m_lostHigh);
+    }
 }
 
 std::ostream&
@@ -28,6 +28,10 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <map>
+
+class TcpTxBufferTestCase;
+
 namespace ns3
 {
 class Packet;
@@ -91,6 +95,13 @@ class Packet;
  * segments that can be lost (\see UpdateLostCount), and we set the flags
  * accordingly.
  *
+ * The sent items are also indexed by their starting sequence number, so that
+ * the items covered by a SACK block, or the item holding a sequence number,
+ * are found without walking the list from its head. With large windows (tens
+ * of thousands of segments in flight), the scoreboard updates, the loss
+ * marking and the NextSeg() lookups then cost a number of steps independent
+ * of the window, instead of a walk of the whole sent list per ACK.
+ *
  * Management of bytes in flight
  * -----------------------------
  *
@@ -411,8 +422,38 @@ class TcpTxBuffer : public Object
   private:
     friend std::ostream& operator<<(std::ostream& os, const TcpTxBuffer& tcpTxBuf);
 
+    /**
+     * \brief TcpTxBufferTestCase test case.
+     * \relates TcpTxBufferTestCase
+     */
+    friend class ::TcpTxBufferTestCase;
+
     typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
 
+    /**
+     * \brief Find the sent item holding a sequence number
+     * \param seq sequence number, in [HeadSequence, HeadSequence + sent size)
+     * \return the iterator to the item inside m_sentList
+     */
+    PacketList::iterator FindSentItem(const SequenceNumber32& seq) const;
+
+    /**
+     * \brief Add an item to the sequence index, if it is in the sent list
+     *
+     * The index entry of the item starting sequence is replaced, if any.
+     *
+     * \param list the list of the item
+     * \param it iterator to the item inside the list
+     */
+    void IndexItem(const PacketList& list, PacketList::iterator it);
+
+    /**
+     * \brief Remove an item from the sequence index, if it is in the sent list
+     * \param list the list of the item
+     * \param item the item
+     */
+    void UnindexItem(const PacketList& list, const TcpTxItem* item);
+
     /**
      * \brief Update the lost count
      *
@@ -428,8 +469,8 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. The walk stops at m_lostHigh, below which all
+     * the segments not sacked are already marked as lost.
      *
      */
     void UpdateLostCount();
@@ -564,7 +605,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * \brief Merge two TcpTxItem
@@ -592,7 +633,10 @@ class TcpTxBuffer : public Object
 
     /**
      * \brief Check if the values of sacked, lost, retrans, are in sync
-     * with the sent list.
+     * with the sent list, and if the index and the hints are consistent.
+     *
+     * The check walks the whole sent list, so it only runs when
+     * m_consistencyCheck is set, as done by the tests.
      */
     void ConsistencyCheck() const;
 
@@ -613,6 +657,18 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    /// Items of m_sentList, by starting sequence number
+    std::map<SequenceNumber32, PacketList::iterator> m_sentIndex;
+
+    /// The sent items ending at or below this sequence number are either sacked or lost
+    SequenceNumber32 m_lostHigh;
+
+    /**
+     * Except the head, no sent item starting below this sequence number is
+     * lost, not sacked and not retransmitted (the NextSeg rule 1 criteria).
+     */
+    mutable SequenceNumber32 m_nextSegHint;
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
@@ -622,6 +678,8 @@ class TcpTxBuffer : public Object
     bool m_renoSack{false};     //!< Indicates if AddRenoSack was called
     bool m_sackEnabled{true};   //!< Indicates if SACK is enabled on this connection
 
+    bool m_consistencyCheck{false}; //!< Whether ConsistencyCheck() runs after each change
+
     static Callback<void, TcpTxItem*> m_nullCb; //!< Null callback for an item
 };
 
@@ -0,0 +1,213 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/test.h"
+
+/**
+ * \file
+ * \ingroup internet-test
+ * Ipv4EndPointDemux and Ipv6EndPointDemux test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the match precedence of the Ipv4EndPointDemux lookups, and
+ * that the endpoints are found again after their four-tuple changes.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Check the Ipv4EndPointDemux lookups")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    interface->SetDevice(CreateObject<SimpleNetDevice>());
+    interface->AddAddress(Ipv4InterfaceAddress("10.1.1.1", "255.255.255.0"));
+
+    Ipv4Address local("10.1.1.1");
+    Ipv4Address peer("10.1.2.2");
+    Ipv4Address any = Ipv4Address::GetAny();
+
+    Ipv4EndPointDemux demux;
+    Ipv4EndPoint* listening = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listening, nullptr, "Allocation failed");
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, 80), nullptr, "Duplicated endpoint allocated");
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(80), true, "Local port not found");
+
+    auto found = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Listening endpoint not found");
+    NS_TEST_ASSERT_MSG_EQ(found.front(), listening, "Wrong endpoint");
+
+    Ipv4EndPoint* bound = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Ephemeral allocation failed");
+    uint16_t ephemeral = bound->GetLocalPort();
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(ephemeral), true, "Ephemeral port not found");
+    bound->SetLocalAddress(any);
+    bound->SetLocalAddress(local);
+    found = demux.Lookup(local, ephemeral, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Bound endpoint not found");
+    NS_TEST_ASSERT_MSG_EQ(found.front(), bound, "Wrong endpoint");
+
+    // The endpoint is found again under its new peer, and takes precedence
+    bound->SetLocalAddress(any);
+    bound->SetPeer(peer, 1000);
+    found = demux.Lookup(local, ephemeral, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Endpoint not found under its new peer");
+    Ipv4EndPoint* exact = demux.Allocate(nullptr, local, ephemeral, peer, 1000);
+    NS_TEST_ASSERT_MSG_NE(exact, nullptr, "Allocation failed");
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, local, ephemeral, peer, 1000),
+                          nullptr,
+                          "Duplicated endpoint allocated");
+    found = demux.Lookup(local, ephemeral, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), exact, "The exact match does not take precedence");
+    NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(local, ephemeral, peer, 1000),
+                          exact,
+                          "Wrong simple lookup");
+    found = demux.Lookup(local, ephemeral, peer, 1001, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 0, "Endpoint found for another peer port");
+
+    exact->SetRxEnabled(false);
+    found = demux.Lookup(local, ephemeral, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), bound, "The endpoint not receiving takes precedence");
+    demux.DeAllocate(exact);
+    demux.DeAllocate(bound);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(ephemeral), false, "Endpoint not deallocated");
+    found = demux.Lookup(local, ephemeral, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 0, "Endpoint not deallocated");
+
+    // Subnet-directed broadcasts, with the local address bound to the subnet
+    Ipv4EndPoint* subnet = demux.Allocate(nullptr, "10.1.1.0", 90);
+    found = demux.Lookup("10.1.1.255", 90, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Subnet endpoint not found");
+    NS_TEST_ASSERT_MSG_EQ(found.front(), subnet, "Wrong endpoint");
+    found = demux.Lookup("10.1.3.255", 90, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 0, "Subnet endpoint found for another subnet");
+
+    // Bound devices
+    Ptr<NetDevice> other = CreateObject<SimpleNetDevice>();
+    demux.Allocate(other, 100)->BindToNetDevice(other);
+    found = demux.Lookup(local, 100, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 0, "Endpoint found on another device");
+    Ipv4EndPoint* device = demux.Allocate(interface->GetDevice(), 100);
+    NS_TEST_ASSERT_MSG_NE(device, nullptr, "Allocation failed");
+    device->BindToNetDevice(interface->GetDevice());
+    found = demux.Lookup(local, 100, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Endpoint not found on its device");
+    NS_TEST_ASSERT_MSG_EQ(found.front(), device, "Wrong endpoint");
+    NS_TEST_ASSERT_MSG_EQ(demux.GetAllEndPoints().size(), 4, "Wrong number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the match precedence of the Ipv6EndPointDemux lookups, and
+ * that the endpoints are found again after their four-tuple changes.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Check the Ipv6EndPointDemux lookups")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6Address local("2001:1::1");
+    Ipv6Address peer("2001:2::2");
+    Ipv6Address any = Ipv6Address::GetAny();
+
+    Ipv6EndPointDemux demux;
+    Ipv6EndPoint* listening = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listening, nullptr, "Allocation failed");
+    Ipv6EndPoint* bound = demux.Allocate(nullptr, local, 80);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Allocation failed");
+
+    auto found = demux.Lookup(local, 80, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1, "Endpoint not found");
+    NS_TEST_ASSERT_MSG_EQ(found.front(), bound, "The bound endpoint does not take precedence");
+    found = demux.Lookup("2001:1::3", 80, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), listening, "Listening endpoint not found");
+
+    Ipv6EndPoint* connected = demux.Allocate(nullptr, any, 80, peer, 1000);
+    found = demux.Lookup(local, 80, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), connected, "The peer match does not take precedence");
+    Ipv6EndPoint* exact = demux.Allocate(nullptr, local, 80, peer, 1000);
+    found = demux.Lookup(local, 80, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), exact, "The exact match does not take precedence");
+
+    // The endpoint is found again under its new local port
+    exact->SetLocalPort(81);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(81), true, "New local port not found");
+    found = demux.Lookup(local, 81, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), exact, "Endpoint not found under its new port");
+    found = demux.Lookup(local, 80, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.front(), connected, "Endpoint found under its old port");
+    NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(local, 81, peer, 1000),
+                          exact,
+                          "Wrong simple lookup");
+
+    demux.DeAllocate(exact);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(81), false, "Endpoint not deallocated");
+    found = demux.Lookup(local, 81, peer, 1000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 0, "Endpoint not deallocated");
+    NS_TEST_ASSERT_MSG_EQ(demux.GetEndPoints().size(), 3, "Wrong number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Ipv4EndPointDemux and Ipv6EndPointDemux test suite.
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase(), TestCase::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase(), TestCase::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
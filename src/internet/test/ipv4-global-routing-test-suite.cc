@@ -16,6 +16,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-route-manager.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -41,6 +42,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
+#include <string>
 #include <vector>
 
 using namespace ns3;
@@ -1311,6 +1314,165 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 GlobalRouting parallel and incremental route computation test
+ *
+ * Two separate networks are built: a ring of four routers (n0 to n3) and a
+ * line of three routers (n4 to n6).  The routes computed with several threads
+ * must be the ones computed with one thread, and a link failure in the ring
+ * must only recompute the routes of the ring routers.
+ */
+class Ipv4GlobalRoutingUpdateTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingUpdateTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * \brief Get the routes of a node.
+     * \param node The node index.
+     * \returns The routes, as a string.
+     */
+    std::string GetRoutes(uint32_t node) const;
+
+    /**
+     * \brief Get the routes of all the nodes.
+     * \returns The routes of each node.
+     */
+    std::vector<std::string> GetAllRoutes() const;
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingUpdateTestCase::Ipv4GlobalRoutingUpdateTestCase()
+    : TestCase("Parallel and incremental global route computation")
+{
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoSetup()
+{
+    m_nodes.Create(7);
+
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.0.0", "255.255.255.252");
+    const std::vector<std::pair<uint32_t, uint32_t>> links = {{0, 1},
+                                                              {1, 2},
+                                                              {2, 3},
+                                                              {3, 0},
+                                                              {4, 5},
+                                                              {5, 6}};
+    for (const auto& [a, b] : links)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(a), channel);
+        net.Add(simpleHelper.Install(m_nodes.Get(b), channel));
+        ipv4.Assign(net);
+        ipv4.NewNetwork();
+    }
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoTeardown()
+{
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(1));
+    Simulator::Destroy();
+}
+
+std::string
+Ipv4GlobalRoutingUpdateTestCase::GetRoutes(uint32_t node) const
+{
+    Ptr<Ipv4GlobalRouting> routing =
+        m_nodes.Get(node)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+    std::ostringstream oss;
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        oss << *routing->GetRoute(i) << std::endl;
+    }
+    return oss.str();
+}
+
+std::vector<std::string>
+Ipv4GlobalRoutingUpdateTestCase::GetAllRoutes() const
+{
+    std::vector<std::string> routes;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        routes.push_back(GetRoutes(i));
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::vector<std::string> sequential = GetAllRoutes();
+    NS_TEST_ASSERT_MSG_NE(sequential[0], "", "No route computed");
+
+    // The routes do not depend on the number of threads
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(3));
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    std::vector<std::string> parallel = GetAllRoutes();
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(parallel[i], sequential[i], "Different routes on node " << i);
+    }
+
+    // Mark a router of each network with an extra route, which is only kept
+    // if its routes are not recomputed
+    Ipv4Address marker("192.168.0.1");
+    for (uint32_t i : {1, 5})
+    {
+        m_nodes.Get(i)
+            ->GetObject<Ipv4>()
+            ->GetRoutingProtocol()
+            ->GetObject<Ipv4GlobalRouting>()
+            ->AddHostRouteTo(marker, 1);
+    }
+    std::string marked1 = GetRoutes(1);
+    std::string marked5 = GetRoutes(5);
+
+    // Nothing is recomputed when the topology did not change
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ(GetRoutes(1), marked1, "Routes recomputed without any change");
+    NS_TEST_ASSERT_MSG_EQ(GetRoutes(5), marked5, "Routes recomputed without any change");
+
+    // A link failure in the ring only recomputes the routes of the ring routers
+    m_nodes.Get(0)->GetObject<Ipv4>()->SetDown(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::string> incremental = GetAllRoutes();
+    NS_TEST_ASSERT_MSG_EQ(incremental[5], marked5, "Routes of an unaffected router recomputed");
+    NS_TEST_ASSERT_MSG_NE(incremental[1], marked1, "Routes of an affected router not recomputed");
+    NS_TEST_ASSERT_MSG_NE(incremental[1], sequential[1], "Routes not updated after a failure");
+
+    // The recomputed routes are the ones of a full computation
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    std::vector<std::string> full = GetAllRoutes();
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(incremental[i], full[i], "Different routes on node " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(full[5], sequential[5], "Different routes on node 5");
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1333,6 +1495,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingUpdateTestCase, TestCase::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
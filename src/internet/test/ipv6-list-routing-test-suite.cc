@@ -16,10 +16,17 @@
  *
  */
 
+#include "ns3/internet-stack-helper.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-route.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -156,6 +163,179 @@ class Ipv6BRouting : public Ipv6RoutingProtocol
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const override{};
 };
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv6 dummy routing class, routing every destination and counting its lookups.
+ */
+class Ipv6CountingRouting : public Ipv6ARouting
+{
+  public:
+    Ptr<Ipv6Route> RouteOutput(Ptr<Packet> p,
+                               const Ipv6Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr) override
+    {
+        m_lookups++;
+        Ptr<Ipv6Route> route = Create<Ipv6Route>();
+        route->SetDestination(header.GetDestination());
+        route->SetGateway(Ipv6Address("2001:db8::1"));
+        return route;
+    }
+
+    uint32_t m_lookups{0}; //!< Number of route lookups.
+};
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv6 ListRouting route cache test.
+ */
+class Ipv6ListRoutingCacheTestCase : public TestCase
+{
+  public:
+    Ipv6ListRoutingCacheTestCase();
+    void DoRun() override;
+};
+
+Ipv6ListRoutingCacheTestCase::Ipv6ListRoutingCacheTestCase()
+    : TestCase("Check the route cache")
+{
+}
+
+void
+Ipv6ListRoutingCacheTestCase::DoRun()
+{
+    Ptr<Ipv6ListRouting> lr = CreateObject<Ipv6ListRouting>();
+    Ptr<Ipv6CountingRouting> routing = CreateObject<Ipv6CountingRouting>();
+    lr->AddRoutingProtocol(routing, 0);
+    lr->SetAttribute("RouteCacheSize", UintegerValue(2));
+
+    Ipv6Header header;
+    header.SetDestination(Ipv6Address("2001:db8:1::1"));
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv6Route> route = lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_EQ(routing->m_lookups, 1, "300");
+    // The cached route must be a copy of the route returned
+    route->SetGateway(Ipv6Address("2001:db8::2"));
+    route = lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_EQ(routing->m_lookups, 1, "301");
+    NS_TEST_ASSERT_MSG_EQ(sockerr, Socket::ERROR_NOTERROR, "302");
+    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv6Address("2001:db8::1"), "303");
+
+    // The least recently used destination is evicted
+    header.SetDestination(Ipv6Address("2001:db8:2::1"));
+    lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    header.SetDestination(Ipv6Address("2001:db8:3::1"));
+    lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    header.SetDestination(Ipv6Address("2001:db8:1::1"));
+    lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_EQ(routing->m_lookups, 4, "304");
+
+    // The notifications flush the cache
+    lr->NotifyRemoveRoute(Ipv6Address("2001:db8:1::"), Ipv6Prefix(48), Ipv6Address::GetAny(), 1);
+    lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_EQ(routing->m_lookups, 5, "305");
+    lr->FlushRouteCache();
+    lr->RouteOutput(nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_EQ(routing->m_lookups, 6, "306");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv6 StaticRouting longest prefix match and route cache test.
+ */
+class Ipv6StaticRoutingCacheTestCase : public TestCase
+{
+  public:
+    Ipv6StaticRoutingCacheTestCase();
+    void DoRun() override;
+
+    /**
+     * \brief Look up the gateway to a destination.
+     * \param routing the routing protocol
+     * \param dest the destination
+     * \return the gateway, or the any address if there is no route
+     */
+    Ipv6Address GetGateway(Ptr<Ipv6RoutingProtocol> routing, Ipv6Address dest);
+};
+
+Ipv6StaticRoutingCacheTestCase::Ipv6StaticRoutingCacheTestCase()
+    : TestCase("Check the static routing longest prefix match with the route cache")
+{
+}
+
+Ipv6Address
+Ipv6StaticRoutingCacheTestCase::GetGateway(Ptr<Ipv6RoutingProtocol> routing, Ipv6Address dest)
+{
+    Ipv6Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv6Route> route = routing->RouteOutput(nullptr, header, nullptr, sockerr);
+    return route ? route->GetGateway() : Ipv6Address::GetAny();
+}
+
+void
+Ipv6StaticRoutingCacheTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(node);
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::ConvertFrom(Mac48Address::Allocate()));
+    node->AddDevice(device);
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+    uint32_t ifIndex = ipv6->AddInterface(device);
+    ipv6->AddAddress(ifIndex, Ipv6InterfaceAddress(Ipv6Address("2001:1::1"), Ipv6Prefix(64)));
+    ipv6->SetUp(ifIndex);
+
+    Ipv6StaticRoutingHelper helper;
+    Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting(ipv6);
+    routing->SetAttribute("RouteCacheSize", UintegerValue(16));
+    Ipv6Address dest("2001:2::5");
+
+    routing->AddNetworkRouteTo("2001:2::", Ipv6Prefix(32), "2001:1::2", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address("2001:1::2"), "400");
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address("2001:1::2"), "401");
+
+    // A longer prefix, added after the lookup, must be selected
+    routing->AddNetworkRouteTo("2001:2::", Ipv6Prefix(64), "2001:1::3", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address("2001:1::3"), "402");
+    // A shorter prefix must not
+    routing->AddNetworkRouteTo("2001::", Ipv6Prefix(16), "2001:1::4", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address("2001:1::3"), "403");
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, "2001:3::1"), Ipv6Address("2001:1::4"), "404");
+
+    // A route to a destination without route must be found once it is added
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, "2002::1"), Ipv6Address::GetAny(), "405");
+    routing->SetDefaultRoute("2001:1::5", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, "2002::1"), Ipv6Address("2001:1::5"), "406");
+
+    // The previous route must be selected once the longer prefix is removed
+    routing->NotifyRemoveRoute("2001:2::", Ipv6Prefix(64), "2001:1::3", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address("2001:1::2"), "407");
+
+    // The list routing cache is flushed by the static routes added directly
+    Ptr<Ipv6RoutingProtocol> list = ipv6->GetRoutingProtocol();
+    list->SetAttribute("RouteCacheSize", UintegerValue(16));
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(list, dest), Ipv6Address("2001:1::2"), "408");
+    routing->AddHostRouteTo(dest, "2001:1::6", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(list, dest), Ipv6Address("2001:1::6"), "409");
+    // and by the host routes of the ICMPv6 redirects
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(list, "2001:3::1"), Ipv6Address("2001:1::4"), "410");
+    list->NotifyAddRoute("2001:3::1", Ipv6Prefix(128), "2001:1::7", ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(list, "2001:3::1"), Ipv6Address("2001:1::7"), "411");
+
+    // The routes through the interface are removed when it goes down
+    ipv6->SetDown(ifIndex);
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(routing, dest), Ipv6Address::GetAny(), "412");
+    NS_TEST_ASSERT_MSG_EQ(GetGateway(list, dest), Ipv6Address::GetAny(), "413");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -242,6 +422,8 @@ class Ipv6ListRoutingTestSuite : public TestSuite
     {
         AddTestCase(new Ipv6ListRoutingPositiveTestCase(), TestCase::QUICK);
         AddTestCase(new Ipv6ListRoutingNegativeTestCase(), TestCase::QUICK);
+        AddTestCase(new Ipv6ListRoutingCacheTestCase(), TestCase::QUICK);
+        AddTestCase(new Ipv6StaticRoutingCacheTestCase(), TestCase::QUICK);
     }
 };
 
@@ -0,0 +1,255 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/lpm-trie.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <list>
+#include <tuple>
+
+/**
+ * \file
+ * \ingroup internet-test
+ * LpmTrie test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Compare the LpmTrie lookups with a linear scan of the same prefixes.
+ *
+ * Prefixes are drawn from a small address space, so that they overlap
+ * and share groups, and are then removed in random order.
+ *
+ * \tparam N The number of bytes of an address.
+ */
+template <std::size_t N>
+class LpmTrieTestCase : public TestCase
+{
+  public:
+    LpmTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** The trie under test. */
+    typedef LpmTrie<N, uint32_t> Trie;
+
+    /** A prefix of the reference list: key, length and value. */
+    typedef std::tuple<typename Trie::Key, uint8_t, uint32_t> Prefix;
+
+    /**
+     * Draw an address, from a small set of values in each byte.
+     * \return The address.
+     */
+    typename Trie::Key DrawKey();
+
+    /**
+     * Check the lookups of random addresses against a linear scan.
+     * \param [in] trie The trie.
+     * \param [in] prefixes The reference list of prefixes, in insertion order.
+     */
+    void Check(const Trie& trie, const std::list<Prefix>& prefixes);
+
+    Ptr<UniformRandomVariable> m_random; //!< Random variable.
+};
+
+template <std::size_t N>
+LpmTrieTestCase<N>::LpmTrieTestCase()
+    : TestCase("Check LpmTrie lookups for " + std::to_string(8 * N) + "-bit addresses")
+{
+}
+
+template <std::size_t N>
+typename LpmTrieTestCase<N>::Trie::Key
+LpmTrieTestCase<N>::DrawKey()
+{
+    typename Trie::Key key;
+    for (auto& byte : key)
+    {
+        const uint8_t values[] = {0x00, 0x0a, 0x80, 0xc0, 0xff};
+        byte = values[m_random->GetInteger(0, 4)];
+    }
+    return key;
+}
+
+template <std::size_t N>
+void
+LpmTrieTestCase<N>::Check(const Trie& trie, const std::list<Prefix>& prefixes)
+{
+    NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), prefixes.size(), "Wrong number of values");
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        typename Trie::Key key = DrawKey();
+
+        // Expected: the matching values, longest prefix first, in list order
+        std::vector<std::pair<uint8_t, uint32_t>> expected;
+        for (uint8_t length = 8 * N + 1; length-- > 0;)
+        {
+            for (const auto& [prefix, prefixLength, value] : prefixes)
+            {
+                bool match = prefixLength == length;
+                for (uint8_t bit = 0; match && bit < length; bit++)
+                {
+                    match = ((prefix[bit / 8] ^ key[bit / 8]) & (0x80 >> (bit % 8))) == 0;
+                }
+                if (match)
+                {
+                    expected.emplace_back(length, value);
+                }
+            }
+        }
+
+        std::vector<typename Trie::Item> items;
+        trie.Lookup(key, items);
+        NS_TEST_ASSERT_MSG_EQ(items.size(), expected.size(), "Wrong number of matches");
+        for (std::size_t j = 0; j < items.size(); j++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(+items[j].length, +expected[j].first, "Wrong prefix length");
+            NS_TEST_EXPECT_MSG_EQ(items[j].value, expected[j].second, "Wrong value");
+        }
+
+        const auto* longest = trie.LookupLongest(key);
+        NS_TEST_EXPECT_MSG_EQ((longest != nullptr), !expected.empty(), "Wrong longest match");
+        if (longest)
+        {
+            NS_TEST_EXPECT_MSG_EQ(+longest->front().length,
+                                  +expected.front().first,
+                                  "Wrong longest prefix length");
+        }
+    }
+}
+
+template <std::size_t N>
+void
+LpmTrieTestCase<N>::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(1);
+
+    Trie trie;
+    std::list<Prefix> prefixes;
+    for (uint32_t value = 0; value < 300; value++)
+    {
+        // Favor the lengths multiple of 8, which share prefixes with the addresses
+        uint8_t length = m_random->GetInteger(0, 1) ? 8 * m_random->GetInteger(0, N)
+                                                    : m_random->GetInteger(0, 8 * N);
+        typename Trie::Key key = DrawKey();
+        trie.Insert(key, length, value);
+        // The reference keeps the masked prefix
+        for (uint8_t bit = length; bit < 8 * N; bit++)
+        {
+            key[bit / 8] &= ~(0x80 >> (bit % 8));
+        }
+        prefixes.emplace_back(key, length, value);
+        if (value % 50 == 0)
+        {
+            Check(trie, prefixes);
+        }
+    }
+    Check(trie, prefixes);
+
+    while (!prefixes.empty())
+    {
+        auto it = prefixes.begin();
+        std::advance(it, m_random->GetInteger(0, prefixes.size() - 1));
+        const auto& [key, length, value] = *it;
+        NS_TEST_ASSERT_MSG_EQ(trie.Remove(key, length, value), true, "Value not found");
+        NS_TEST_ASSERT_MSG_EQ(trie.Remove(key, length, value), false, "Value removed twice");
+        prefixes.erase(it);
+        if (prefixes.size() % 50 == 0)
+        {
+            Check(trie, prefixes);
+        }
+    }
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the LpmTrie keys of IPv4 and IPv6 networks, and the lookups
+ * of the values inserted by network, in insertion order.
+ */
+class LpmTrieNetworkTestCase : public TestCase
+{
+  public:
+    LpmTrieNetworkTestCase()
+        : TestCase("Check LpmTrie keys and lookups of IPv4 and IPv6 networks")
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+LpmTrieNetworkTestCase::DoRun()
+{
+    uint8_t length;
+    auto key4 = GetLpmTrieKey(Ipv4Address("10.1.2.3"), Ipv4Mask("255.255.0.0"), length);
+    NS_TEST_EXPECT_MSG_EQ(length, 16, "Wrong IPv4 prefix length");
+    NS_TEST_EXPECT_MSG_EQ((key4 == GetLpmTrieKey(Ipv4Address("10.1.0.0"))), true, "Wrong key");
+    GetLpmTrieKey(Ipv4Address("10.1.2.3"), Ipv4Mask("255.0.255.0"), length);
+    NS_TEST_EXPECT_MSG_EQ(length, 0, "Non-contiguous masks have a zero length");
+
+    auto key6 = GetLpmTrieKey(Ipv6Address("2001:db8::1"), Ipv6Prefix(33), length);
+    NS_TEST_EXPECT_MSG_EQ(length, 33, "Wrong IPv6 prefix length");
+    NS_TEST_EXPECT_MSG_EQ((key6 == GetLpmTrieKey(Ipv6Address("2001:db8::"))), true, "Wrong key");
+    GetLpmTrieKey(Ipv6Address("2001:db8::1"), Ipv6Prefix("ffff:0:ffff::"), length);
+    NS_TEST_EXPECT_MSG_EQ(length, 0, "Non-contiguous prefixes have a zero length");
+
+    // The non-contiguous mask matches every address, and comes first
+    LpmTrie<4, uint32_t> trie;
+    trie.InsertNetwork(Ipv4Address("10.0.0.0"), Ipv4Mask("255.0.255.0"), 1);
+    trie.InsertNetwork(Ipv4Address("10.1.0.0"), Ipv4Mask("255.255.0.0"), 2);
+    trie.InsertNetwork(Ipv4Address("10.0.0.0"), Ipv4Mask("255.0.0.0"), 3);
+    trie.InsertNetwork(Ipv4Address("10.1.2.3"), Ipv4Mask("255.255.255.255"), 4);
+    std::vector<uint32_t> values;
+    trie.LookupInOrder(Ipv4Address("10.1.2.3"), values);
+    NS_TEST_EXPECT_MSG_EQ((values == std::vector<uint32_t>{1, 2, 3, 4}), true, "Wrong order");
+    trie.LookupInOrder(Ipv4Address("192.168.0.1"), values);
+    NS_TEST_EXPECT_MSG_EQ((values == std::vector<uint32_t>{1}), true, "Wrong values");
+
+    NS_TEST_EXPECT_MSG_EQ(trie.RemoveNetwork(Ipv4Address("10.1.9.9"), Ipv4Mask("/16"), 2),
+                          true,
+                          "The network address is masked");
+    NS_TEST_EXPECT_MSG_EQ(trie.RemoveNetwork(Ipv4Address("10.1.0.0"), Ipv4Mask("/16"), 2),
+                          false,
+                          "Value removed twice");
+    trie.LookupInOrder(Ipv4Address("10.1.2.3"), values);
+    NS_TEST_EXPECT_MSG_EQ((values == std::vector<uint32_t>{1, 3, 4}), true, "Wrong values");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief LpmTrie test suite.
+ */
+class LpmTrieTestSuite : public TestSuite
+{
+  public:
+    LpmTrieTestSuite()
+        : TestSuite("lpm-trie", UNIT)
+    {
+        AddTestCase(new LpmTrieTestCase<4>(), TestCase::QUICK);
+        AddTestCase(new LpmTrieTestCase<16>(), TestCase::QUICK);
+        AddTestCase(new LpmTrieNetworkTestCase(), TestCase::QUICK);
+    }
+};
+
+static LpmTrieTestSuite g_lpmTrieTestSuite; //!< Static variable for test initialization
@@ -915,6 +915,114 @@ FlushTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief NDISC Cache NUD Timer Test
+ */
+class NudTimerTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NudTimerTest();
+
+  private:
+    /**
+     * \brief Check the state of the entries.
+     * \param reachable The number of entries which are still reachable.
+     * \param stale The number of entries which are stale.
+     */
+    void CheckStates(uint32_t reachable, uint32_t stale);
+
+    Ptr<NdiscCache> m_ndiscCache;         //!< The NDISC cache under test.
+    std::vector<Ipv6Address> m_addresses; //!< The addresses of the entries.
+};
+
+NudTimerTest::NudTimerTest()
+    : TestCase("The NudTimerTest checks that the reachable timers of the NDISC cache entries "
+               "expire at the right time when they are started, updated or removed.")
+{
+}
+
+void
+NudTimerTest::CheckStates(uint32_t reachable, uint32_t stale)
+{
+    uint32_t nReachable = 0;
+    uint32_t nStale = 0;
+    for (const auto& address : m_addresses)
+    {
+        NdiscCache::Entry* entry = m_ndiscCache->Lookup(address);
+        if (entry && entry->IsReachable())
+        {
+            nReachable++;
+        }
+        else if (entry && entry->IsStale())
+        {
+            nStale++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(nReachable,
+                          reachable,
+                          "Wrong number of reachable entries at " << Simulator::Now().As(Time::S));
+    NS_TEST_EXPECT_MSG_EQ(nStale,
+                          stale,
+                          "Wrong number of stale entries at " << Simulator::Now().As(Time::S));
+}
+
+void
+NudTimerTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(node, CreateObject<SimpleChannel>());
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(node);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:0::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer interfaces = ipv6.Assign(net);
+    Ptr<Ipv6L3Protocol> ipv6L3 = node->GetObject<Ipv6L3Protocol>();
+    m_ndiscCache = ipv6L3->GetInterface(interfaces.GetInterfaceIndex(0))->GetNdiscCache();
+
+    // The entries become reachable at 0 s, and stale after the reachable
+    // time of 30 s unless their reachable timer is updated
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        uint8_t buffer[16] = {0x20, 0x01};
+        buffer[14] = 1;
+        buffer[15] = static_cast<uint8_t>(i);
+        m_addresses.emplace_back(buffer);
+        NdiscCache::Entry* entry = m_ndiscCache->Add(m_addresses.back());
+        entry->SetMacAddress(Mac48Address::Allocate());
+        entry->MarkReachable();
+        entry->StartReachableTimer();
+    }
+
+    // Update the reachable timer of 50 entries at 10 s, and remove 10
+    // other entries at 20 s
+    Simulator::Schedule(Seconds(10), [this]() {
+        for (uint32_t i = 0; i < 50; ++i)
+        {
+            m_ndiscCache->Lookup(m_addresses[i])->UpdateReachableTimer();
+        }
+    });
+    Simulator::Schedule(Seconds(20), [this]() {
+        for (uint32_t i = 90; i < 100; ++i)
+        {
+            m_ndiscCache->Remove(m_ndiscCache->Lookup(m_addresses[i]));
+        }
+    });
+
+    Simulator::Schedule(Seconds(29.9), &NudTimerTest::CheckStates, this, 90, 0);
+    Simulator::Schedule(Seconds(30.1), &NudTimerTest::CheckStates, this, 50, 40);
+    Simulator::Schedule(Seconds(39.9), &NudTimerTest::CheckStates, this, 50, 40);
+    Simulator::Schedule(Seconds(40.1), &NudTimerTest::CheckStates, this, 0, 90);
+    Simulator::Stop(Seconds(50));
+    Simulator::Run();
+    m_ndiscCache = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1237,6 +1345,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new NetDeviceContainerTest, TestCase::QUICK);
         AddTestCase(new InterfaceContainerTest, TestCase::QUICK);
         AddTestCase(new FlushTest, TestCase::QUICK);
+        AddTestCase(new NudTimerTest, TestCase::QUICK);
         AddTestCase(new DuplicateTest, TestCase::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::QUICK);
     }
@@ -0,0 +1,281 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/log.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet-test
+ * TCP segmentation and receive offload test suite.
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpOffloadTestSuite");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Send a data stream with the TCP segmentation and receive offloads,
+ * and check the data received and the size of the packets sent.
+ */
+class TcpOffloadTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param mtu The MTU of the devices.
+     * \param queueDisc Whether a queue disc is installed on the devices.
+     * \param tso Whether the sender uses segmentation offload.
+     * \param gro Whether the receiver uses receive offload.
+     * \param sinkSegmentSize The segment size of the receiver.
+     */
+    TcpOffloadTestCase(uint16_t mtu,
+                       bool queueDisc,
+                       bool tso,
+                       bool gro,
+                       uint32_t sinkSegmentSize = SEGMENT_SIZE);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Fill the socket buffer of the sender.
+     * \param socket The sender socket.
+     * \param available The free space of the socket buffer.
+     */
+    void Send(Ptr<Socket> socket, uint32_t available);
+    /**
+     * \brief Accept a connection on the receiver.
+     * \param socket The accepted socket.
+     * \param from The sender address.
+     */
+    void Accept(Ptr<Socket> socket, const Address& from);
+    /**
+     * \brief Read the data received.
+     * \param socket The receiver socket.
+     */
+    void Receive(Ptr<Socket> socket);
+    /**
+     * \brief Record an IPv4 packet sent.
+     * \param packet The packet, with its IPv4 header.
+     * \param ipv4 The IPv4 protocol.
+     * \param interface The output interface.
+     */
+    void Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    uint16_t m_mtu;                //!< MTU of the devices
+    bool m_queueDisc;              //!< Whether a queue disc is installed on the devices
+    bool m_tso;                    //!< Whether the sender uses segmentation offload
+    bool m_gro;                    //!< Whether the receiver uses receive offload
+    uint32_t m_sinkSegmentSize;    //!< Segment size of the receiver
+    std::vector<uint8_t> m_tx;     //!< Data stream sent
+    std::vector<uint8_t> m_rx;     //!< Data stream received
+    uint32_t m_sent{0};            //!< Bytes handed to the sender socket
+    uint32_t m_dataPackets{0};     //!< IPv4 packets sent by the sender
+    uint32_t m_ackPackets{0};      //!< IPv4 packets sent by the receiver
+    uint32_t m_maxPacketSize{0};   //!< Largest IPv4 packet sent by the sender
+    Ptr<Ipv4> m_senderIpv4;        //!< IPv4 protocol of the sender
+    static const uint32_t SEGMENT_SIZE = 1448; //!< TCP segment size
+};
+
+TcpOffloadTestCase::TcpOffloadTestCase(uint16_t mtu,
+                                       bool queueDisc,
+                                       bool tso,
+                                       bool gro,
+                                       uint32_t sinkSegmentSize)
+    : TestCase("Check the TCP offloads, MTU " + std::to_string(mtu) +
+               (queueDisc ? " with" : " without") + " queue disc" + (tso ? ", TSO" : "") +
+               (gro ? ", GRO" : "") + ", receiver segment size " +
+               std::to_string(sinkSegmentSize)),
+      m_mtu(mtu),
+      m_queueDisc(queueDisc),
+      m_tso(tso),
+      m_gro(gro),
+      m_sinkSegmentSize(sinkSegmentSize)
+{
+}
+
+void
+TcpOffloadTestCase::Send(Ptr<Socket> socket, uint32_t available)
+{
+    while (m_sent < m_tx.size() && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint32_t>(m_tx.size() - m_sent, socket->GetTxAvailable());
+        int sent = socket->Send(Create<Packet>(m_tx.data() + m_sent, size));
+        if (sent <= 0)
+        {
+            break;
+        }
+        m_sent += sent;
+    }
+    if (m_sent == m_tx.size())
+    {
+        socket->Close();
+    }
+}
+
+void
+TcpOffloadTestCase::Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&TcpOffloadTestCase::Receive, this));
+}
+
+void
+TcpOffloadTestCase::Receive(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()) && packet->GetSize() > 0)
+    {
+        size_t size = m_rx.size();
+        m_rx.resize(size + packet->GetSize());
+        packet->CopyData(m_rx.data() + size, packet->GetSize());
+    }
+}
+
+void
+TcpOffloadTestCase::Tx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    if (ipv4 == m_senderIpv4)
+    {
+        m_dataPackets++;
+        m_maxPacketSize = std::max(m_maxPacketSize, packet->GetSize());
+    }
+    else
+    {
+        m_ackPackets++;
+    }
+}
+
+void
+TcpOffloadTestCase::DoRun()
+{
+    m_tx.resize(1000000);
+    for (size_t i = 0; i < m_tx.size(); ++i)
+    {
+        m_tx[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper link;
+    link.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    link.SetChannelAttribute("Delay", StringValue("1ms"));
+    NetDeviceContainer devices = link.Install(nodes);
+    for (uint32_t i = 0; i < devices.GetN(); ++i)
+    {
+        devices.Get(i)->SetMtu(m_mtu);
+    }
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = addresses.Assign(devices);
+    if (!m_queueDisc)
+    {
+        TrafficControlHelper().Uninstall(devices);
+    }
+
+    m_senderIpv4 = nodes.Get(0)->GetObject<Ipv4>();
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        nodes.Get(i)->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+            "Tx",
+            MakeCallback(&TcpOffloadTestCase::Tx, this));
+    }
+
+    Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(1), TcpSocketFactory::GetTypeId());
+    sink->SetAttribute("SegmentSize", UintegerValue(m_sinkSegmentSize));
+    sink->SetAttribute("ReceiveOffloadTimeout", TimeValue(m_gro ? MicroSeconds(100) : Time(0)));
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 5000));
+    sink->Listen();
+    sink->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                            MakeCallback(&TcpOffloadTestCase::Accept, this));
+
+    Ptr<Socket> sender = Socket::CreateSocket(nodes.Get(0), TcpSocketFactory::GetTypeId());
+    sender->SetAttribute("SegmentSize", UintegerValue(SEGMENT_SIZE));
+    sender->SetAttribute("SegmentationOffloadSize", UintegerValue(m_tso ? 65535 : 0));
+    sender->SetSendCallback(MakeCallback(&TcpOffloadTestCase::Send, this));
+    sender->Bind();
+    sender->Connect(InetSocketAddress(interfaces.GetAddress(1), 5000));
+    Simulator::ScheduleNow(&TcpOffloadTestCase::Send, this, sender, 0);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rx.size(), m_tx.size(), "Wrong number of bytes received");
+    NS_TEST_ASSERT_MSG_EQ((m_rx == m_tx), true, "Wrong data received");
+
+    uint32_t segments = m_tx.size() / SEGMENT_SIZE;
+    if (m_tso && !m_queueDisc && m_mtu > SEGMENT_SIZE * 2)
+    {
+        // The super-segments are sent as a whole
+        NS_TEST_ASSERT_MSG_GT(m_maxPacketSize, SEGMENT_SIZE * 2, "No super-segment sent");
+        NS_TEST_ASSERT_MSG_LT(m_dataPackets, segments / 4, "Too many packets sent");
+    }
+    else
+    {
+        // The super-segments, if any, are split
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(m_maxPacketSize, SEGMENT_SIZE + 52, "Super-segment sent");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(m_dataPackets, segments, "Too few packets sent");
+    }
+    if (m_gro || (m_tso && !m_queueDisc && m_mtu > SEGMENT_SIZE * 2))
+    {
+        // An ACK is sent for each coalesced segment or super-segment
+        NS_TEST_ASSERT_MSG_LT(m_ackPackets, segments / 4, "Too many ACKs sent");
+    }
+    else
+    {
+        // Without receive offload, a delayed ACK is sent every two segments,
+        // whatever the size of the segments
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(m_ackPackets, segments / 2, "Too few ACKs sent");
+        NS_TEST_ASSERT_MSG_LT(m_ackPackets, segments * 3 / 4, "Too many ACKs sent");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TCP segmentation and receive offload test suite.
+ */
+class TcpOffloadTestSuite : public TestSuite
+{
+  public:
+    TcpOffloadTestSuite()
+        : TestSuite("tcp-offload", UNIT)
+    {
+        AddTestCase(new TcpOffloadTestCase(1500, true, false, false), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(1500, true, true, false), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(65535, true, true, false), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(65535, false, true, false), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(1500, false, false, true), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(1500, true, true, true), TestCase::QUICK);
+        AddTestCase(new TcpOffloadTestCase(1500, true, false, false, 536), TestCase::QUICK);
+    }
+};
+
+static TcpOffloadTestSuite g_tcpOffloadTestSuite; //!< Static variable for test initialization
@@ -42,6 +42,12 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test the extraction of in-order data, after out-of-order and
+     * overlapping segments have been received.
+     */
+    void TestExtract();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -53,6 +59,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestExtract();
 }
 
 void
@@ -288,6 +295,62 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestExtract()
+{
+    TcpRxBuffer rxBuf;
+    rxBuf.SetMaxBufferSize(1000);
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+    TcpHeader h;
+
+    // An in-order segment read at once is handed over as is
+    Ptr<Packet> p = Create<Packet>(100);
+    h.SetSequenceNumber(SequenceNumber32(1));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(p, h), true, "Segment not buffered");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 100, "Wrong available bytes");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000), p, "The segment is copied");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000), nullptr, "Data extracted from an empty buffer");
+
+    // [201;301) and [401;501) out of order, then [251;451) overlapping both
+    h.SetSequenceNumber(SequenceNumber32(201));
+    rxBuf.Add(Create<Packet>(100), h);
+    h.SetSequenceNumber(SequenceNumber32(401));
+    rxBuf.Add(Create<Packet>(100), h);
+    h.SetSequenceNumber(SequenceNumber32(251));
+    rxBuf.Add(Create<Packet>(200), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 300, "Overlapping bytes buffered twice");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "Out-of-order bytes available");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 1, "The SACK blocks are not merged");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackList().front().first,
+                          SequenceNumber32(201),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackList().front().second,
+                          SequenceNumber32(501),
+                          "SACK block different than expected");
+
+    // Filling the hole makes all the data available
+    h.SetSequenceNumber(SequenceNumber32(101));
+    rxBuf.Add(Create<Packet>(100), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(501),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 400, "Wrong available bytes");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should contain no element");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.MaxRxSequence(),
+                          SequenceNumber32(1101),
+                          "The window does not start at the first byte buffered");
+
+    // Partial reads, within and across the fragments
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(50)->GetSize(), 50, "Wrong extracted size");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(200)->GetSize(), 200, "Wrong extracted size");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.MaxRxSequence(),
+                          SequenceNumber32(1351),
+                          "The window does not follow the extracted bytes");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000)->GetSize(), 150, "Wrong extracted size");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "The buffer is not empty");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "The buffer is not empty");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
@@ -53,6 +53,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard of a large window with many holes */
+    void TestLargeWindow();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -100,6 +102,14 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large window:
+     *  -> one segment every ten is lost, and the others are sacked one by one
+     *  -> the lost segments are retransmitted in order, then SND.UNA moves
+     *     to the middle of the window
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -108,6 +118,7 @@ void
 TcpTxBufferTestCase::TestIsLost()
 {
     Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->m_consistencyCheck = true;
     txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
     SequenceNumber32 head(1);
     txBuf->SetHeadSequence(head);
@@ -174,6 +185,7 @@ void
 TcpTxBufferTestCase::TestNextSeg()
 {
     Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->m_consistencyCheck = true;
     ;
     txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
     SequenceNumber32 head(1);
@@ -329,6 +341,7 @@ TcpTxBufferTestCase::TestNewBlock()
 {
     // Manually recreating all the conditions
     Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->m_consistencyCheck = true;
     txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
     txBuf->SetHeadSequence(SequenceNumber32(1));
     txBuf->SetSegmentSize(100);
@@ -406,6 +419,7 @@ void
 TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
 {
     TcpTxBuffer txBuf;
+    txBuf.m_consistencyCheck = true;
     SequenceNumber32 head(1);
     txBuf.SetHeadSequence(head);
     txBuf.SetSegmentSize(2000);
@@ -420,6 +434,81 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->m_consistencyCheck = true;
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    SequenceNumber32 head(1);
+    uint32_t segmentSize = 100;
+    uint32_t segments = 2000;
+    txBuf->SetHeadSequence(head);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->SetMaxBufferSize(segments * segmentSize);
+    txBuf->Add(Create<Packet>(segments * segmentSize));
+
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, head + segmentSize * i);
+    }
+
+    // Every tenth segment is lost; the receiver reports the block of
+    // segments received since the last hole
+    SequenceNumber32 blockBegin;
+    for (uint32_t i = 1; i < segments; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            continue;
+        }
+        if (i % 10 == 1)
+        {
+            blockBegin = head + segmentSize * i;
+        }
+        Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+        sack->AddSackBlock(TcpOptionSack::SackBlock(blockBegin, head + segmentSize * (i + 1)));
+        txBuf->Update(sack->GetSackList());
+    }
+
+    uint32_t holes = segments / 10;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(),
+                          (segments - holes) * segmentSize,
+                          "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), holes * segmentSize, "Wrong lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + segmentSize * 10), true, "Hole not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + segmentSize * 11), false, "Sacked segment lost");
+
+    // The holes are retransmitted in order
+    SequenceNumber32 ret;
+    SequenceNumber32 retHigh;
+    for (uint32_t i = 0; i < holes; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&ret, &retHigh, true), true, "No NextSeg");
+        NS_TEST_ASSERT_MSG_EQ(ret, head + segmentSize * 10 * i, "Wrong NextSeg");
+        txBuf->CopyFromSequence(segmentSize, ret);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&ret, &retHigh, true),
+                          false,
+                          "NextSeg with all the holes retransmitted");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), holes * segmentSize, "Wrong bytes in flight");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(head + segmentSize),
+                          true,
+                          "Retransmission not detected");
+
+    txBuf->DiscardUpTo(head + segmentSize * segments / 2);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(),
+                          (segments - holes) * segmentSize / 2,
+                          "Wrong sacked bytes after the cumulative ACK");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(),
+                          holes * segmentSize / 2,
+                          "Wrong lost bytes after the cumulative ACK");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                          holes * segmentSize / 2,
+                          "Wrong bytes in flight after the cumulative ACK");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -91,6 +91,8 @@ MobilityModel::GetVelocity() const
 void
 MobilityModel::SetPosition(const Vector& position)
 {
+    // Some models only notify the course change in a later event
+    m_courseChanges++;
     DoSetPosition(position);
 }
 
@@ -108,9 +110,16 @@ MobilityModel::GetRelativeSpeed(Ptr<const MobilityModel> other) const
     return (GetVelocity() - other->GetVelocity()).GetLength();
 }
 
+uint64_t
+MobilityModel::GetCourseChangeCount() const
+{
+    return m_courseChanges;
+}
+
 void
 MobilityModel::NotifyCourseChange() const
 {
+    m_courseChanges++;
     m_courseChangeTrace(this);
 }
 
@@ -81,6 +81,15 @@ class MobilityModel : public Object
      * \return the relative speed between the two objects. Unit is meters/s.
      */
     double GetRelativeSpeed(Ptr<const MobilityModel> other) const;
+    /**
+     * The number of course changes counts the positions set and the
+     * course changes notified by the model.  It is unchanged as long as
+     * the object keeps its course, so that the users of the model can
+     * cache values which only depend on the position of a static object.
+     *
+     * \return the number of course changes of the object.
+     */
+    uint64_t GetCourseChangeCount() const;
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model. Return the number of streams (possibly zero) that
@@ -149,6 +158,8 @@ class MobilityModel : public Object
      * or position has occurred.
      */
     ns3::TracedCallback<Ptr<const MobilityModel>> m_courseChangeTrace;
+
+    mutable uint64_t m_courseChanges{0}; //!< Number of course changes
 };
 
 } // namespace ns3
@@ -0,0 +1,276 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "spatial-index.h"
+
+#include "mobility-model.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialIndex");
+
+NS_OBJECT_ENSURE_REGISTERED(SpatialIndex);
+
+TypeId
+SpatialIndex::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SpatialIndex")
+                            .SetParent<Object>()
+                            .SetGroupName("Mobility")
+                            .AddConstructor<SpatialIndex>()
+                            .AddAttribute("CellSize",
+                                          "The size of the side of the cells of the grid, in "
+                                          "meters. It should be of the order of the ranges "
+                                          "queried.",
+                                          DoubleValue(1000),
+                                          MakeDoubleAccessor(&SpatialIndex::SetCellSize,
+                                                             &SpatialIndex::GetCellSize),
+                                          MakeDoubleChecker<double>(1e-3));
+    return tid;
+}
+
+SpatialIndex::SpatialIndex()
+    : m_cellSize(1000)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SpatialIndex::~SpatialIndex()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SpatialIndex::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    Object::DoDispose();
+}
+
+std::size_t
+SpatialIndex::CellHash::operator()(const Cell& cell) const
+{
+    return std::hash<uint64_t>()(static_cast<uint64_t>(cell.first) * 0x9e3779b97f4a7c15ULL ^
+                                 static_cast<uint64_t>(cell.second));
+}
+
+void
+SpatialIndex::Add(uint32_t id, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << id << mobility);
+    NS_ASSERT(mobility);
+
+    std::size_t index = m_items.size();
+    m_items.push_back({id, mobility, Cell(), 0});
+    Bin(index);
+
+    auto& items = m_mobilityItems[mobility];
+    if (items.empty())
+    {
+        mobility->TraceConnectWithoutContext("CourseChange",
+                                             MakeCallback(&SpatialIndex::CourseChanged, this));
+    }
+    items.push_back(index);
+}
+
+void
+SpatialIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, items] : m_mobilityItems)
+    {
+        m_items[items.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialIndex::CourseChanged, this));
+    }
+    m_mobilityItems.clear();
+    m_items.clear();
+    m_cells.clear();
+    m_movingItems.clear();
+    m_maxSpeed = 0;
+}
+
+uint32_t
+SpatialIndex::GetNItems() const
+{
+    return m_items.size();
+}
+
+void
+SpatialIndex::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    m_cellSize = cellSize;
+    m_cells.clear();
+    m_maxSpeed = 0;
+    m_binTime = Simulator::Now();
+    for (std::size_t index = 0; index < m_items.size(); ++index)
+    {
+        Bin(index);
+    }
+}
+
+double
+SpatialIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+SpatialIndex::Cell
+SpatialIndex::GetCell(const Vector& position) const
+{
+    // Clamp the coordinates far enough from the limits of int64_t for the
+    // cell ranges of the queries not to overflow
+    const double limit = std::ldexp(1.0, 60);
+    return {static_cast<int64_t>(std::clamp(std::floor(position.x / m_cellSize), -limit, limit)),
+            static_cast<int64_t>(std::clamp(std::floor(position.y / m_cellSize), -limit, limit))};
+}
+
+void
+SpatialIndex::Bin(std::size_t index)
+{
+    Item& item = m_items[index];
+    item.cell = GetCell(item.mobility->GetPosition());
+    item.speed = item.mobility->GetVelocity().GetLength();
+    m_cells[item.cell].push_back(index);
+    if (item.speed > 0)
+    {
+        m_movingItems.insert(index);
+        m_maxSpeed = std::max(m_maxSpeed, item.speed);
+    }
+    else
+    {
+        m_movingItems.erase(index);
+    }
+}
+
+void
+SpatialIndex::Unbin(std::size_t index)
+{
+    auto cell = m_cells.find(m_items[index].cell);
+    NS_ASSERT(cell != m_cells.end());
+    auto it = std::find(cell->second.begin(), cell->second.end(), index);
+    NS_ASSERT(it != cell->second.end());
+    *it = cell->second.back();
+    cell->second.pop_back();
+    if (cell->second.empty())
+    {
+        m_cells.erase(cell);
+    }
+}
+
+void
+SpatialIndex::RebinMovingItems()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::size_t> moving(m_movingItems.begin(), m_movingItems.end());
+    m_maxSpeed = 0;
+    for (auto index : moving)
+    {
+        Unbin(index);
+        Bin(index);
+    }
+    m_binTime = Simulator::Now();
+}
+
+void
+SpatialIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto items = m_mobilityItems.find(mobility);
+    NS_ASSERT(items != m_mobilityItems.end());
+    for (auto index : items->second)
+    {
+        Unbin(index);
+        Bin(index);
+    }
+}
+
+std::vector<uint32_t>
+SpatialIndex::GetItemsWithin(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+
+    // The moving items may have left their cell by up to the distance the
+    // fastest one has covered since they were binned
+    double slack = 0;
+    if (!m_movingItems.empty())
+    {
+        slack = m_maxSpeed * (Simulator::Now() - m_binTime).GetSeconds();
+        if (slack > m_cellSize)
+        {
+            RebinMovingItems();
+            slack = 0;
+        }
+    }
+
+    std::vector<uint32_t> ids;
+    auto addItemsWithin = [&](const std::vector<std::size_t>& items) {
+        for (auto index : items)
+        {
+            const Item& item = m_items[index];
+            if (CalculateDistance(item.mobility->GetPosition(), position) <= range)
+            {
+                ids.push_back(item.id);
+            }
+        }
+    };
+
+    double reach = range + slack;
+    Cell min = GetCell(Vector(position.x - reach, position.y - reach, 0));
+    Cell max = GetCell(Vector(position.x + reach, position.y + reach, 0));
+    double nCells = (static_cast<double>(max.first - min.first) + 1) *
+                    (static_cast<double>(max.second - min.second) + 1);
+    if (nCells > m_cells.size())
+    {
+        // The range covers more cells than there are non-empty cells
+        for (const auto& [cell, items] : m_cells)
+        {
+            if (cell.first >= min.first && cell.first <= max.first &&
+                cell.second >= min.second && cell.second <= max.second)
+            {
+                addItemsWithin(items);
+            }
+        }
+    }
+    else
+    {
+        for (int64_t x = min.first; x <= max.first; ++x)
+        {
+            for (int64_t y = min.second; y <= max.second; ++y)
+            {
+                auto cell = m_cells.find({x, y});
+                if (cell != m_cells.end())
+                {
+                    addItemsWithin(cell->second);
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    NS_LOG_DEBUG(ids.size() << " of " << m_items.size() << " items within " << range
+                            << " m of " << position);
+    return ids;
+}
+
+} // namespace ns3
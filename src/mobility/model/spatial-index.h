@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/vector.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Index of the positions of a set of mobility models, to find
+ * the items within a given distance of a position.
+ *
+ * The items are binned in a uniform grid of square cells in the (x, y)
+ * plane, and the index follows their movements through the CourseChange
+ * trace of their mobility model. The cell of a moving item is only
+ * updated when its course changes, or when the distance the fastest item
+ * may have covered since the items were last binned exceeds the cell
+ * size: in between, the queries extend their search by that distance.
+ * The candidates found in the grid are then checked against their exact
+ * position, so that a query returns exactly the items within the range.
+ *
+ * This requires the velocity of the mobility models to be constant
+ * between two course change notifications, which is not the case of the
+ * ConstantAccelerationMobilityModel, nor of the WaypointMobilityModel
+ * with its LazyNotify attribute set.
+ *
+ * The cost of a query is proportional to the number of items in the
+ * cells overlapping the range, so the cell size should be of the order
+ * of the ranges queried.
+ */
+class SpatialIndex : public Object
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SpatialIndex();
+    ~SpatialIndex() override;
+
+    /**
+     * \brief Add an item to the index.
+     * \param id The identifier of the item, returned by GetItemsWithin.
+     * \param mobility The mobility model giving the position of the item.
+     *
+     * Several items may share the same mobility model.
+     */
+    void Add(uint32_t id, Ptr<MobilityModel> mobility);
+
+    /**
+     * \brief Remove all the items from the index.
+     */
+    void Clear();
+
+    /**
+     * \return The number of items in the index.
+     */
+    uint32_t GetNItems() const;
+
+    /**
+     * \brief Get the items within a distance of a position.
+     * \param position The position.
+     * \param range The distance from the position, in meters.
+     * \return The identifiers of the items whose current position is at
+     *         most at the given distance of the position, in increasing
+     *         order.
+     */
+    std::vector<uint32_t> GetItemsWithin(const Vector& position, double range);
+
+    /**
+     * \param cellSize The size of the side of the cells, in meters.
+     */
+    void SetCellSize(double cellSize);
+
+    /**
+     * \return The size of the side of the cells, in meters.
+     */
+    double GetCellSize() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Coordinates of a cell of the grid
+    using Cell = std::pair<int64_t, int64_t>;
+
+    /// An item of the index
+    struct Item
+    {
+        uint32_t id;                 //!< Identifier of the item
+        Ptr<MobilityModel> mobility; //!< Mobility model of the item
+        Cell cell;                   //!< Cell of the item
+        double speed;                //!< Speed of the item when it was binned, in m/s
+    };
+
+    /// Hash function for the cells of the grid
+    struct CellHash
+    {
+        /**
+         * \param cell The coordinates of the cell.
+         * \return The hash of the cell.
+         */
+        std::size_t operator()(const Cell& cell) const;
+    };
+
+    /**
+     * \param position A position.
+     * \return The coordinates of the cell containing the position.
+     */
+    Cell GetCell(const Vector& position) const;
+    /**
+     * \brief Insert an item in the cell of its current position, and
+     * update its speed.
+     * \param index The index of the item in m_items.
+     */
+    void Bin(std::size_t index);
+    /**
+     * \brief Remove an item from its cell.
+     * \param index The index of the item in m_items.
+     */
+    void Unbin(std::size_t index);
+    /**
+     * \brief Rebin all the moving items at their current position.
+     */
+    void RebinMovingItems();
+    /**
+     * \brief Rebin the items of a mobility model whose course has changed.
+     * \param mobility The mobility model.
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                   //!< Size of the cells, in meters
+    std::vector<Item> m_items;           //!< Items of the index
+    std::set<std::size_t> m_movingItems; //!< Items with a non-zero speed
+    double m_maxSpeed{0};                //!< Max speed of the moving items, in m/s
+    Time m_binTime;                      //!< Time of the last rebinning of the moving items
+    /// Items of each cell
+    std::unordered_map<Cell, std::vector<std::size_t>, CellHash> m_cells;
+    /// Items of each mobility model
+    std::map<Ptr<const MobilityModel>, std::vector<std::size_t>> m_mobilityItems;
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_INDEX_H */
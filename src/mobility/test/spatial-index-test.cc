@@ -0,0 +1,178 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/random-walk-2d-mobility-model.h>
+#include <ns3/rectangle.h>
+#include <ns3/simulator.h>
+#include <ns3/spatial-index.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check the items returned by a SpatialIndex against an exhaustive
+ * search, for static and moving items.
+ */
+class SpatialIndexTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param cellSize The size of the cells of the index.
+     */
+    SpatialIndexTestCase(double cellSize);
+
+  private:
+    void DoRun() override;
+    /**
+     * Compare the result of a query with an exhaustive search.
+     * \param position The position of the query.
+     * \param range The range of the query.
+     */
+    void Query(Vector position, double range);
+
+    double m_cellSize;                            //!< Size of the cells of the index
+    Ptr<SpatialIndex> m_index;                    //!< The index
+    std::vector<Ptr<MobilityModel>> m_mobilities; //!< Mobility models of the items
+    uint32_t m_queries{0};                        //!< Number of queries
+    uint32_t m_found{0};                          //!< Number of items found
+};
+
+SpatialIndexTestCase::SpatialIndexTestCase(double cellSize)
+    : TestCase("Check the spatial index with cells of " +
+               std::to_string(static_cast<uint32_t>(cellSize)) + " m"),
+      m_cellSize(cellSize)
+{
+}
+
+void
+SpatialIndexTestCase::Query(Vector position, double range)
+{
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < m_mobilities.size(); ++id)
+    {
+        if (CalculateDistance(m_mobilities[id]->GetPosition(), position) <= range)
+        {
+            expected.push_back(id);
+        }
+    }
+    std::vector<uint32_t> found = m_index->GetItemsWithin(position, range);
+    NS_TEST_EXPECT_MSG_EQ(found.size(),
+                          expected.size(),
+                          "Wrong number of items within " << range << " m of " << position
+                                                          << " at " << Simulator::Now());
+    NS_TEST_EXPECT_MSG_EQ((found == expected),
+                          true,
+                          "Wrong items within " << range << " m of " << position << " at "
+                                                << Simulator::Now());
+    m_queries++;
+    m_found += found.size();
+}
+
+void
+SpatialIndexTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+    m_index = CreateObject<SpatialIndex>();
+    m_index->SetAttribute("CellSize", DoubleValue(m_cellSize));
+
+    // Static items, items moving at a constant velocity, some of them
+    // changing course during the simulation, and items following a random
+    // walk in a bounded area
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        Vector position(random->GetValue(0, 2000), random->GetValue(0, 2000), 0);
+        Ptr<MobilityModel> mobility;
+        if (i % 3 == 0)
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        else if (i % 3 == 1)
+        {
+            Ptr<ConstantVelocityMobilityModel> cv = CreateObject<ConstantVelocityMobilityModel>();
+            cv->SetVelocity(Vector(random->GetValue(-30, 30), random->GetValue(-30, 30), 0));
+            if (i % 2 == 0)
+            {
+                Simulator::Schedule(Seconds(random->GetValue(0, 60)),
+                                    &ConstantVelocityMobilityModel::SetVelocity,
+                                    cv,
+                                    Vector(random->GetValue(-60, 60), 0, 0));
+            }
+            mobility = cv;
+        }
+        else
+        {
+            mobility = CreateObject<RandomWalk2dMobilityModel>();
+            mobility->SetAttribute("Bounds", RectangleValue(Rectangle(0, 2000, 0, 2000)));
+            mobility->SetAttribute("Time", TimeValue(Seconds(5)));
+            mobility->SetAttribute("Mode", StringValue("Time"));
+            mobility->AssignStreams(i);
+        }
+        mobility->SetPosition(position);
+        mobility->Initialize();
+        m_index->Add(m_mobilities.size(), mobility);
+        m_mobilities.push_back(mobility);
+    }
+    // An item sharing its mobility model with another one
+    m_index->Add(m_mobilities.size(), m_mobilities[1]);
+    m_mobilities.push_back(m_mobilities[1]);
+    NS_TEST_ASSERT_MSG_EQ(m_index->GetNItems(), 301, "Wrong number of items");
+
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        Vector position(random->GetValue(-500, 2500), random->GetValue(-500, 2500), 0);
+        double range = i % 10 == 0 ? random->GetValue(0, 5000) : random->GetValue(0, 400);
+        Simulator::Schedule(Seconds(i * 0.2), &SpatialIndexTestCase::Query, this, position, range);
+    }
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_queries, 500, "Queries not run");
+    NS_TEST_ASSERT_MSG_GT(m_found, 500, "Too few items found to check the index");
+
+    m_index->Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_index->GetItemsWithin(Vector(), 1e6).size(), 0, "Items not removed");
+    m_index->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief SpatialIndex test suite.
+ */
+class SpatialIndexTestSuite : public TestSuite
+{
+  public:
+    SpatialIndexTestSuite()
+        : TestSuite("spatial-index", UNIT)
+    {
+        AddTestCase(new SpatialIndexTestCase(100), TestCase::QUICK);
+        AddTestCase(new SpatialIndexTestCase(1000), TestCase::QUICK);
+    }
+};
+
+static SpatialIndexTestSuite g_spatialIndexTestSuite; //!< Static variable for test initialization
@@ -43,6 +43,9 @@ NetDeviceQueue::GetTypeId()
 NetDeviceQueue::NetDeviceQueue()
     : m_stoppedByDevice(false),
       m_stoppedByQueueLimits(false),
+      m_batchedCompletions(false),
+      m_dequeuedBytes(0),
+      m_completionPending(false),
       NS_LOG_TEMPLATE_DEFINE("NetDeviceQueueInterface")
 {
     NS_LOG_FUNCTION(this);
@@ -171,6 +174,13 @@ NetDeviceQueue::GetQueueLimits()
     return m_queueLimits;
 }
 
+void
+NetDeviceQueue::SetBatchedCompletions(bool batched)
+{
+    NS_LOG_FUNCTION(this << batched);
+    m_batchedCompletions = batched;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(NetDeviceQueueInterface);
 
 TypeId
@@ -149,6 +149,16 @@ class NetDeviceQueue : public Object
      */
     Ptr<QueueLimits> GetQueueLimits();
 
+    /**
+     * \brief Set whether the packets dequeued at the same time are notified to
+     *        the queue limits, and may wake the queue, in a single event
+     * \param batched whether the completions are batched
+     *
+     * Called by the queue discs which dequeue packets in bulk. Otherwise, each
+     * packet dequeued is notified in its own event.
+     */
+    void SetBatchedCompletions(bool batched);
+
     /**
      * \brief Perform the actions required by flow control and dynamic queue
      *        limits when a packet is enqueued in the queue of a netdevice
@@ -205,11 +215,24 @@ class NetDeviceQueue : public Object
     void ConnectQueueTraces(Ptr<QueueType> queue);
 
   private:
+    /**
+     * \brief Notify the queue limits of the bytes dequeued from the queue of a
+     *        netdevice, and wake the queue if there is room for another packet
+     *
+     * \param queue the device queue
+     * \param bytes the number of bytes dequeued
+     */
+    template <typename QueueType>
+    void CompleteTransmission(QueueType* queue, uint32_t bytes);
+
     bool m_stoppedByDevice;         //!< True if the queue has been stopped by the device
     bool m_stoppedByQueueLimits;    //!< True if the queue has been stopped by a queue limits object
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
+    bool m_batchedCompletions;      //!< True if the completions are notified in batches
+    uint32_t m_dequeuedBytes;       //!< Bytes dequeued since the last completion notification
+    bool m_completionPending;       //!< True if a completion notification is scheduled
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -364,21 +387,52 @@ NetDeviceQueue::PacketDequeued(QueueType* queue, Ptr<const typename QueueType::I
     NS_LOG_FUNCTION(this << queue << item);
     NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
 
-    Simulator::ScheduleNow([=, this]() {
-        // Inform BQL
-        NotifyTransmittedBytes(item->GetSize());
+    if (!m_batchedCompletions)
+    {
+        Simulator::ScheduleNow(&NetDeviceQueue::CompleteTransmission<QueueType>,
+                               this,
+                               queue,
+                               item->GetSize());
+        return;
+    }
 
-        // After dequeuing a packet, if there is room for another packet we
-        // call Wake () that ensures that the queue is not stopped and restarts
-        // the queue disc if the queue was stopped
+    // The packets dequeued at the same time (e.g., a batch sent by a queue disc
+    // dequeuing in bulk) are notified to BQL, and may wake the queue, in a
+    // single event
+    m_dequeuedBytes += item->GetSize();
+    if (m_completionPending)
+    {
+        return;
+    }
+    m_completionPending = true;
 
-        if (!queue->WouldOverflow(1, m_device->GetMtu()))
-        {
-            Wake();
-        }
+    Simulator::ScheduleNow([=, this]() {
+        uint32_t bytes = m_dequeuedBytes;
+        m_dequeuedBytes = 0;
+        m_completionPending = false;
+        CompleteTransmission(queue, bytes);
     });
 }
 
+template <typename QueueType>
+void
+NetDeviceQueue::CompleteTransmission(QueueType* queue, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << queue << bytes);
+
+    // Inform BQL
+    NotifyTransmittedBytes(bytes);
+
+    // After dequeuing a packet, if there is room for another packet we
+    // call Wake () that ensures that the queue is not stopped and restarts
+    // the queue disc if the queue was stopped
+
+    if (!queue->WouldOverflow(1, m_device->GetMtu()))
+    {
+        Wake();
+    }
+}
+
 template <typename QueueType>
 void
 NetDeviceQueue::PacketDiscarded(QueueType* queue, Ptr<const typename QueueType::ItemType> item)
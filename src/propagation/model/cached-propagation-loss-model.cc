@@ -0,0 +1,214 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cached-propagation-loss-model.h"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The first loss model of the chain of deterministic loss models "
+                          "whose Rx Power is cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetModel,
+                                              &CachedPropagationLossModel::GetModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("CacheSize",
+                          "The maximum number of pairs of nodes whose Rx Power is cached. "
+                          "The least recently used pair is evicted to make room for a new "
+                          "one. If set to 0, the cache is unbounded.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::SetCacheSize,
+                                               &CachedPropagationLossModel::GetCacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheHits",
+                          "The number of Rx Powers found in the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::GetCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of Rx Powers computed by the cached loss models.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::GetCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheEvictions",
+                          "The number of pairs of nodes evicted from the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::GetCacheEvictions),
+                          MakeUintegerChecker<uint64_t>());
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.Clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetModel(Ptr<PropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    m_cache.Clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::ClearCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.Clear();
+}
+
+void
+CachedPropagationLossModel::SetCacheSize(uint32_t cacheSize)
+{
+    NS_LOG_FUNCTION(this << cacheSize);
+    m_cacheSize = cacheSize;
+    m_cache.SetCapacity(cacheSize > 0 ? cacheSize : std::numeric_limits<std::size_t>::max());
+}
+
+uint32_t
+CachedPropagationLossModel::GetCacheSize() const
+{
+    return m_cacheSize;
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheMisses() const
+{
+    return m_misses;
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheEvictions() const
+{
+    return m_cache.GetEvictions();
+}
+
+std::size_t
+CachedPropagationLossModel::MobilityPairHasher::operator()(const MobilityPair& key) const
+{
+    auto a = reinterpret_cast<uintptr_t>(key.first);
+    auto b = reinterpret_cast<uintptr_t>(key.second);
+    return std::hash<uint64_t>()(a * 0x9e3779b97f4a7c15ULL ^ b);
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "No loss model to cache");
+
+    // The item holds the mobility models, so that their addresses are not
+    // reused while they are cached
+    MobilityPair key(PeekPointer(a), PeekPointer(b));
+    // Some mobility models only update their numbers of course changes when
+    // their positions are queried
+    a->GetPosition();
+    b->GetPosition();
+    Item* item = m_cache.Find(key);
+    if (item && item->m_txPowerDbm == txPowerDbm &&
+        item->m_courseChangesA == a->GetCourseChangeCount() &&
+        item->m_courseChangesB == b->GetCourseChangeCount())
+    {
+        m_hits++;
+        NS_LOG_DEBUG("cached rx power " << item->m_rxPowerDbm << " dBm");
+        return item->m_rxPowerDbm;
+    }
+
+    m_misses++;
+    double rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+    Vector zero(0, 0, 0);
+    if (a->GetVelocity() == zero && b->GetVelocity() == zero)
+    {
+        Item computed{a,
+                      b,
+                      a->GetCourseChangeCount(),
+                      b->GetCourseChangeCount(),
+                      txPowerDbm,
+                      rxPowerDbm};
+        if (item)
+        {
+            *item = computed;
+        }
+        else
+        {
+            m_cache.Insert(key, computed);
+        }
+    }
+    else if (item)
+    {
+        m_cache.Erase(key);
+    }
+    NS_LOG_DEBUG("computed rx power " << rxPowerDbm << " dBm");
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
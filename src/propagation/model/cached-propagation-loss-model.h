@@ -0,0 +1,169 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-loss-model.h"
+
+#include "ns3/lru-cache.h"
+
+#include <utility>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the Rx Power computed by a chain of deterministic loss
+ * models for each pair of static nodes.
+ *
+ * The chain of loss models set with SetModel() is evaluated once for each
+ * (ordered) pair of mobility models and transmission power, and its result
+ * is reused as long as neither node moves, which is detected with the
+ * MobilityModel::GetCourseChangeCount() of the mobility models.  The Rx
+ * Power is not cached while one of the nodes has a non-zero velocity.  The
+ * loss models chained after this model with SetNext() are evaluated on
+ * each call, so that stochastic models, such as the
+ * NakagamiPropagationLossModel, still draw a new value for each signal:
+ *
+ * \code
+ *   Ptr<CachedPropagationLossModel> loss = CreateObject<CachedPropagationLossModel>();
+ *   loss->SetModel(CreateObject<LogDistancePropagationLossModel>());
+ *   loss->SetNext(CreateObject<NakagamiPropagationLossModel>());
+ * \endcode
+ *
+ * The cached models must only depend on the positions of the nodes and on
+ * the transmission power, and the mobility models must notify their course
+ * changes when they happen (e.g., the LazyNotify attribute of the
+ * WaypointMobilityModel must be false).  The results are then identical to
+ * those of the cached models.  The attribute "CacheSize" bounds the number
+ * of pairs of nodes in the cache, evicting the least recently used pairs.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * Set the chain of deterministic loss models whose Rx Power is cached,
+     * and clear the cache.
+     *
+     * \param model the first loss model of the chain
+     */
+    void SetModel(Ptr<PropagationLossModel> model);
+
+    /**
+     * \return the first loss model of the chain whose Rx Power is cached
+     */
+    Ptr<PropagationLossModel> GetModel() const;
+
+    /**
+     * Remove all the cached Rx Powers, e.g., after changing the attributes
+     * of the cached models.
+     */
+    void ClearCache();
+
+    /**
+     * Set the maximum number of pairs of nodes in the cache.
+     *
+     * \param cacheSize the maximum number of pairs of nodes, or 0 for no limit
+     */
+    void SetCacheSize(uint32_t cacheSize);
+
+    /**
+     * \return the maximum number of pairs of nodes in the cache, or 0 for no limit
+     */
+    uint32_t GetCacheSize() const;
+
+    /**
+     * \return the number of Rx Powers found in the cache
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of Rx Powers computed by the cached models
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * \return the number of pairs of nodes evicted from the cache
+     */
+    uint64_t GetCacheEvictions() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /// Typedef: Mobility models pair, held by the cached item
+    typedef std::pair<const MobilityModel*, const MobilityModel*> MobilityPair;
+
+    /**
+     * \ingroup propagation
+     *
+     * \brief Hasher for a pair of mobility models.
+     */
+    class MobilityPairHasher
+    {
+      public:
+        /**
+         * \brief Get the hash for a MobilityPair.
+         * \param key MobilityPair reference to hash
+         * \return the MobilityPair hash
+         */
+        std::size_t operator()(const MobilityPair& key) const;
+    };
+
+    /// The Rx Power cached for a pair of nodes
+    struct Item
+    {
+        Ptr<MobilityModel> m_a;    //!< Mobility model of the source
+        Ptr<MobilityModel> m_b;    //!< Mobility model of the destination
+        uint64_t m_courseChangesA; //!< Number of course changes of the source
+        uint64_t m_courseChangesB; //!< Number of course changes of the destination
+        double m_txPowerDbm;       //!< Transmission power (in dBm)
+        double m_rxPowerDbm;       //!< Rx Power of the cached models (in dBm)
+    };
+
+    Ptr<PropagationLossModel> m_model; //!< First loss model of the cached chain
+    uint32_t m_cacheSize{0};           //!< Maximum number of pairs of nodes, 0 for no limit
+    mutable LruCache<MobilityPair, Item, MobilityPairHasher> m_cache; //!< Rx Powers
+    mutable uint64_t m_hits{0};   //!< Number of Rx Powers found in the cache
+    mutable uint64_t m_misses{0}; //!< Number of Rx Powers computed
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
@@ -20,13 +20,18 @@
 
 #include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <array>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -305,7 +310,9 @@ ThreeGppChannelConditionModel::GetTypeId()
             .AddAttribute(
                 "UpdatePeriod",
                 "Specifies the time period after which the channel "
-                "condition is recomputed. If set to 0, the channel condition is never updated.",
+                "condition is recomputed. If set to 0, the channel condition is never updated. "
+                "If the cache is bounded, the periods are counted from the start of the "
+                "simulation.",
                 TimeValue(MilliSeconds(0)),
                 MakeTimeAccessor(&ThreeGppChannelConditionModel::m_updatePeriod),
                 MakeTimeChecker())
@@ -330,7 +337,34 @@ ThreeGppChannelConditionModel::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(
                               &ThreeGppChannelConditionModel::m_linkO2iConditionToAntennaHeight),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("CacheSize",
+                          "The maximum number of pairs of nodes whose channel condition is "
+                          "cached. The condition of the least recently used pair is evicted "
+                          "to make room for a new one, and is computed again from the same random "
+                          "values. If set to 0, the cache is unbounded.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelConditionModel::SetCacheSize,
+                                               &ThreeGppChannelConditionModel::GetCacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheHits",
+                          "The number of channel conditions found in the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelConditionModel::GetCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of channel conditions not found in the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelConditionModel::GetCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheEvictions",
+                          "The number of channel conditions evicted from the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelConditionModel::GetCacheEvictions),
+                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
@@ -352,10 +386,42 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel()
 void
 ThreeGppChannelConditionModel::DoDispose()
 {
-    m_channelConditionMap.clear();
+    m_channelConditionMap.Clear();
     m_updatePeriod = Seconds(0.0);
 }
 
+void
+ThreeGppChannelConditionModel::SetCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_cacheSize = size;
+    m_channelConditionMap.SetCapacity(size > 0 ? size : std::numeric_limits<std::size_t>::max());
+}
+
+uint32_t
+ThreeGppChannelConditionModel::GetCacheSize() const
+{
+    return m_cacheSize;
+}
+
+uint64_t
+ThreeGppChannelConditionModel::GetCacheHits() const
+{
+    return m_channelConditionMap.GetHits();
+}
+
+uint64_t
+ThreeGppChannelConditionModel::GetCacheMisses() const
+{
+    return m_channelConditionMap.GetMisses();
+}
+
+uint64_t
+ThreeGppChannelConditionModel::GetCacheEvictions() const
+{
+    return m_channelConditionMap.GetEvictions();
+}
+
 Ptr<ChannelCondition>
 ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
                                                    Ptr<const MobilityModel> b) const
@@ -369,15 +435,22 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     bool update = false;   // indicates if the channel condition has to be updated
 
     // look for the channel condition in m_channelConditionMap
-    auto mapItem = m_channelConditionMap.find(key);
-    if (mapItem != m_channelConditionMap.end())
+    const Item* mapItem = m_channelConditionMap.Find(key);
+    if (mapItem)
     {
         NS_LOG_DEBUG("found the channel condition in the map");
-        cond = mapItem->second.m_condition;
-
-        // check if it has to be updated
-        if (!m_updatePeriod.IsZero() &&
-            Simulator::Now() - mapItem->second.m_generatedTime > m_updatePeriod)
+        cond = mapItem->m_condition;
+
+        // check if it has to be updated. With a bounded cache, the generation
+        // time of an evicted condition is lost, so the conditions are updated
+        // in periods counted from the start of the simulation
+        bool expired =
+            m_cacheSize > 0
+                ? GetUpdatePeriodIndex(mapItem->m_generatedTime) !=
+                      GetUpdatePeriodIndex(Simulator::Now())
+                : !m_updatePeriod.IsZero() &&
+                      Simulator::Now() - mapItem->m_generatedTime > m_updatePeriod;
+        if (expired)
         {
             NS_LOG_DEBUG("it has to be updated");
             update = true;
@@ -393,13 +466,22 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     // generate a new channel condition
     if (notFound || update)
     {
+        if (m_cacheSize > 0)
+        {
+            // draw the random values from the substream of the channel and of
+            // the update period, so that a condition evicted from the cache is
+            // computed again from the same values
+            uint64_t substream = GetSubstream(key, GetUpdatePeriodIndex(Simulator::Now()));
+            m_uniformVar->SetSubstream(substream);
+            m_uniformVarO2i->SetSubstream(substream);
+            m_uniformO2iLowHighLossVar->SetSubstream(substream);
+        }
         cond = ComputeChannelCondition(a, b);
-        // store the channel condition in m_channelConditionMap, used as cache.
-        // For this reason you see a const_cast.
-        Item mapItem;
-        mapItem.m_condition = cond;
-        mapItem.m_generatedTime = Simulator::Now();
-        const_cast<ThreeGppChannelConditionModel*>(this)->m_channelConditionMap[key] = mapItem;
+        // store the channel condition in m_channelConditionMap, used as cache
+        Item newItem;
+        newItem.m_condition = cond;
+        newItem.m_generatedTime = Simulator::Now();
+        m_channelConditionMap.Insert(key, newItem);
     }
 
     return cond;
@@ -537,6 +619,27 @@ ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const Mobi
     return key;
 }
 
+uint64_t
+ThreeGppChannelConditionModel::GetUpdatePeriodIndex(Time t) const
+{
+    if (m_updatePeriod.IsZero())
+    {
+        return 0;
+    }
+    return t.GetTimeStep() / m_updatePeriod.GetTimeStep();
+}
+
+uint64_t
+ThreeGppChannelConditionModel::GetSubstream(uint32_t key, uint64_t period)
+{
+    // map the run, the channel and the period to one of the 2^50 substreams
+    // following the ones used by the run numbers, within the stream of the
+    // random variables
+    std::array<uint64_t, 3> values{RngSeedManager::GetRun(), key, period};
+    uint64_t hash = Hash64(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    return (uint64_t{1} << 50) | (hash & ((uint64_t{1} << 50) - 1));
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(ThreeGppRmaChannelConditionModel);
@@ -19,13 +19,12 @@
 #ifndef CHANNEL_CONDITION_MODEL_H
 #define CHANNEL_CONDITION_MODEL_H
 
+#include "ns3/lru-cache.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 
-#include <unordered_map>
-
 namespace ns3
 {
 
@@ -437,6 +436,17 @@ class NeverLosVehicleChannelConditionModel : public ChannelConditionModel
  *
  * \brief Base class for the 3GPP channel condition models
  *
+ * The channel conditions are cached per pair of nodes.  The attribute
+ * "CacheSize" bounds the number of cached conditions, to limit the memory
+ * used by simulations with many moving nodes: the condition of the least
+ * recently used pair is evicted to cache a new one, and is computed again
+ * at its next use.  With a bounded cache, the condition of a pair of nodes
+ * is computed at its first use in each "UpdatePeriod", counted from the
+ * start of the simulation, from random values drawn from a substream of the
+ * pair of nodes and of the update period, so that an evicted condition is
+ * computed again from the same values.  The conditions thus do not depend
+ * on the cache size, unless the nodes moved since the evicted condition was
+ * computed, but they differ from those drawn with an unbounded cache.
  */
 class ThreeGppChannelConditionModel : public ChannelConditionModel
 {
@@ -483,6 +493,33 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      */
     int64_t AssignStreams(int64_t stream) override;
 
+    /**
+     * Set the maximum number of cached channel conditions.
+     *
+     * \param size the maximum number of cached channel conditions, or 0 for no limit
+     */
+    void SetCacheSize(uint32_t size);
+
+    /**
+     * \return the maximum number of cached channel conditions, or 0 for no limit
+     */
+    uint32_t GetCacheSize() const;
+
+    /**
+     * \return the number of channel conditions found in the cache
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of channel conditions not found in the cache
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * \return the number of channel conditions evicted from the cache
+     */
+    uint64_t GetCacheEvictions() const;
+
   protected:
     void DoDispose() override;
 
@@ -555,6 +592,24 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      */
     static uint32_t GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
 
+    /**
+     * \brief Returns the index of the update period of a time, counted from
+     * the start of the simulation.
+     * \param t the time
+     * \return the index of the update period, or 0 if the "UpdatePeriod" is 0
+     */
+    uint64_t GetUpdatePeriodIndex(Time t) const;
+
+    /**
+     * \brief Returns the substream of the random variables from which the
+     * condition of a channel is drawn in an update period, when the cache
+     * is bounded.
+     * \param key the channel key
+     * \param period the index of the update period
+     * \return the substream number
+     */
+    static uint64_t GetSubstream(uint32_t key, uint64_t period);
+
     /**
      * Struct to store the channel condition in the m_channelConditionMap
      */
@@ -564,8 +619,9 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
         Time m_generatedTime;              //!< the time when the condition was generated
     };
 
-    std::unordered_map<uint32_t, Item>
-        m_channelConditionMap; //!< map to store the channel conditions
+    mutable LruCache<uint32_t, Item>
+        m_channelConditionMap; //!< cache to store the channel conditions
+    uint32_t m_cacheSize{0};   //!< the maximum number of cached channel conditions
     Time m_updatePeriod;       //!< the update period for the channel condition
 
     double m_o2iThreshold{
@@ -23,13 +23,16 @@
 #include "propagation-loss-model.h"
 
 #include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace ns3
 {
@@ -82,6 +85,77 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPower(double txPowerDbm,
+                                  Ptr<MobilityModel> a,
+                                  std::span<const Ptr<MobilityModel>> b,
+                                  std::span<double> rxPowerDbm) const
+{
+    NS_ASSERT_MSG(rxPowerDbm.size() == b.size(), "One reception power per receiver expected");
+    std::fill(rxPowerDbm.begin(), rxPowerDbm.end(), txPowerDbm);
+    for (const PropagationLossModel* model = this; model; model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowers(a, b, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                     std::span<const Ptr<MobilityModel>> b,
+                                     std::span<double> powerDbm) const
+{
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        powerDbm[i] = DoCalcRxPower(powerDbm[i], a, b[i]);
+    }
+}
+
+void
+PropagationLossModel::GetDistances(Ptr<MobilityModel> a,
+                                   std::span<const Ptr<MobilityModel>> b,
+                                   std::span<double> distances)
+{
+    NS_ASSERT(distances.size() == b.size());
+    Vector position = a->GetPosition();
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        distances[i] = CalculateDistance(position, b[i]->GetPosition());
+    }
+}
+
+double
+PropagationLossModel::CalcMaxRange(double txPowerDbm, double rxPowerDbm, double maxRange) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << rxPowerDbm << maxRange);
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    auto isAbove = [&](double distance) {
+        b->SetPosition(Vector(distance, 0, 0));
+        return CalcRxPower(txPowerDbm, a, b) >= rxPowerDbm;
+    };
+
+    if (isAbove(maxRange))
+    {
+        return maxRange;
+    }
+    double low = 0;
+    double high = maxRange;
+    while (high - low > 1e-6 * high)
+    {
+        double middle = (low + high) / 2;
+        if (isAbove(middle))
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    NS_LOG_DEBUG("Rx power below " << rxPowerDbm << " dBm beyond " << high << " m");
+    return high;
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -281,6 +355,32 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                          std::span<const Ptr<MobilityModel>> b,
+                                          std::span<double> powerDbm) const
+{
+    std::vector<double> distances(b.size());
+    GetDistances(a, b, distances);
+
+    // Same computation as DoCalcRxPower(), with the factors common to all
+    // the receivers computed once
+    double numerator = m_lambda * m_lambda;
+    double factor = 16 * M_PI * M_PI;
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        double distance = distances[i];
+        if (distance < 3 * m_lambda)
+        {
+            NS_LOG_WARN(
+                "distance not within the far field region => inaccurate propagation loss value");
+        }
+        double denominator = factor * distance * distance * m_systemLoss;
+        double lossDb = -10 * std::log10(numerator / denominator);
+        powerDbm[i] -= (distance <= 0) ? m_minLoss : std::max(lossDb, m_minLoss);
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -462,6 +562,50 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+void
+TwoRayGroundPropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                                 std::span<const Ptr<MobilityModel>> b,
+                                                 std::span<double> powerDbm) const
+{
+    Vector position = a->GetPosition();
+    std::vector<double> distances(b.size());
+    std::vector<double> rxAntHeights(b.size());
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        Vector rxPosition = b[i]->GetPosition();
+        distances[i] = CalculateDistance(position, rxPosition);
+        rxAntHeights[i] = rxPosition.z + m_heightAboveZ;
+    }
+
+    // Same computation as DoCalcRxPower(), with the factors common to all
+    // the receivers computed once
+    double txAntHeight = position.z + m_heightAboveZ;
+    double crossFactor = 4 * M_PI * txAntHeight;
+    double friisNumerator = m_lambda * m_lambda;
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        double distance = distances[i];
+        if (distance <= m_minDistance)
+        {
+            continue;
+        }
+        double dCross = (crossFactor * rxAntHeights[i]) / m_lambda;
+        double tmp;
+        if (distance <= dCross)
+        {
+            tmp = M_PI * distance;
+            powerDbm[i] += 10 * std::log10(friisNumerator / (16 * tmp * tmp * m_systemLoss));
+        }
+        else
+        {
+            tmp = txAntHeight * rxAntHeights[i];
+            double rayNumerator = tmp * tmp;
+            tmp = distance * distance;
+            powerDbm[i] += 10 * std::log10(rayNumerator / (tmp * tmp * m_systemLoss));
+        }
+    }
+}
+
 int64_t
 TwoRayGroundPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -554,6 +698,31 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                                std::span<const Ptr<MobilityModel>> b,
+                                                std::span<double> powerDbm) const
+{
+    std::vector<double> distances(b.size());
+    GetDistances(a, b, distances);
+
+    // Same computation as DoCalcRxPower()
+    double scale = 10 * m_exponent;
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        double distance = distances[i];
+        if (distance <= m_referenceDistance)
+        {
+            powerDbm[i] -= m_referenceLoss;
+        }
+        else
+        {
+            double pathLossDb = scale * std::log10(distance / m_referenceDistance);
+            powerDbm[i] += -m_referenceLoss - pathLossDb;
+        }
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -653,6 +822,46 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                                     std::span<const Ptr<MobilityModel>> b,
+                                                     std::span<double> powerDbm) const
+{
+    std::vector<double> distances(b.size());
+    GetDistances(a, b, distances);
+
+    // Same computation as DoCalcRxPower(), with the losses at the beginning
+    // of the middle and far fields computed once
+    double scale0 = 10 * m_exponent0;
+    double scale1 = 10 * m_exponent1;
+    double scale2 = 10 * m_exponent2;
+    double loss1 = m_referenceLoss + scale0 * std::log10(m_distance1 / m_distance0);
+    double loss2 = loss1 + scale1 * std::log10(m_distance2 / m_distance1);
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        double distance = distances[i];
+        NS_ASSERT(distance >= 0);
+        double pathLossDb;
+        if (distance < m_distance0)
+        {
+            pathLossDb = 0;
+        }
+        else if (distance < m_distance1)
+        {
+            pathLossDb = m_referenceLoss + scale0 * std::log10(distance / m_distance0);
+        }
+        else if (distance < m_distance2)
+        {
+            pathLossDb = loss1 + scale1 * std::log10(distance / m_distance1);
+        }
+        else
+        {
+            pathLossDb = loss2 + scale2 * std::log10(distance / m_distance2);
+        }
+        powerDbm[i] -= pathLossDb;
+    }
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -948,6 +1157,19 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowers(Ptr<MobilityModel> a,
+                                          std::span<const Ptr<MobilityModel>> b,
+                                          std::span<double> powerDbm) const
+{
+    std::vector<double> distances(b.size());
+    GetDistances(a, b, distances);
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        powerDbm[i] = (distances[i] <= m_range) ? powerDbm[i] : -1000;
+    }
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
+#include <span>
 #include <unordered_map>
 
 namespace ns3
@@ -101,6 +102,43 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Powers of a transmission to several receivers, taking
+     * into account all the PropagationLossModel(s) chained to the current one.
+     *
+     * The result is the same as calling CalcRxPower() for each receiver in
+     * turn, but each model of the chain processes all the receivers at once,
+     * which lets the models hoist the computations common to all the
+     * receivers and run their arithmetic over contiguous arrays.
+     *
+     * \param txPowerDbm current transmission power (in dBm)
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param rxPowerDbm the reception powers after adding/multiplying propagation
+     *        loss (in dBm), of the same size as b
+     */
+    void CalcRxPower(double txPowerDbm,
+                     Ptr<MobilityModel> a,
+                     std::span<const Ptr<MobilityModel>> b,
+                     std::span<double> rxPowerDbm) const;
+
+    /**
+     * Returns the distance beyond which the Rx Power, taking into account all
+     * the PropagationLossModel(s) chained to the current one, is below a
+     * threshold, e.g., to set the MaxRange attribute of the channels.
+     *
+     * The distance is searched by bisection between two positions at the
+     * same height, so the loss models must be deterministic and their Rx
+     * Power must decrease with the distance.
+     *
+     * \param txPowerDbm transmission power (in dBm)
+     * \param rxPowerDbm reception power threshold (in dBm)
+     * \param maxRange the largest distance considered (in meters)
+     * \returns the distance (in meters), or maxRange if the Rx Power is above the
+     *          threshold at that distance
+     */
+    double CalcMaxRange(double txPowerDbm, double rxPowerDbm, double maxRange = 1e6) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -126,6 +164,17 @@ class PropagationLossModel : public Object
      */
     virtual int64_t DoAssignStreams(int64_t stream) = 0;
 
+    /**
+     * Compute the distances between a source and several destinations.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param distances the distances (in meters), of the same size as b
+     */
+    static void GetDistances(Ptr<MobilityModel> a,
+                             std::span<const Ptr<MobilityModel>> b,
+                             std::span<double> distances);
+
   private:
     /**
      * PropagationLossModel.
@@ -139,6 +188,23 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * PropagationLossModel for several receivers.
+     *
+     * The default implementation calls DoCalcRxPower() for each receiver in
+     * turn.  Subclasses can override it to process all the receivers at once,
+     * with the same results.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param powerDbm the transmission powers on input, and the reception powers
+     *        after adding/multiplying propagation loss on output (in dBm), of the
+     *        same size as b
+     */
+    virtual void DoCalcRxPowers(Ptr<MobilityModel> a,
+                                std::span<const Ptr<MobilityModel>> b,
+                                std::span<double> powerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -303,6 +369,9 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        std::span<const Ptr<MobilityModel>> b,
+                        std::span<double> powerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -413,6 +482,9 @@ class TwoRayGroundPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        std::span<const Ptr<MobilityModel>> b,
+                        std::span<double> powerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -491,6 +563,9 @@ class LogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        std::span<const Ptr<MobilityModel>> b,
+                        std::span<double> powerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -567,6 +642,9 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        std::span<const Ptr<MobilityModel>> b,
+                        std::span<double> powerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -796,6 +874,9 @@ class RangePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowers(Ptr<MobilityModel> a,
+                        std::span<const Ptr<MobilityModel>> b,
+                        std::span<double> powerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -27,8 +27,10 @@
 #include "ns3/node.h"
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -76,7 +78,35 @@ ThreeGppPropagationLossModel::GetTypeId()
                 "Enable/disable Building Penetration Losses.",
                 BooleanValue(true),
                 MakeBooleanAccessor(&ThreeGppPropagationLossModel::m_buildingPenLossesEnabled),
-                MakeBooleanChecker());
+                MakeBooleanChecker())
+            .AddAttribute("CacheSize",
+                          "The maximum number of pairs of nodes whose shadowing and building "
+                          "penetration losses are cached. The losses of the least recently used "
+                          "pair are evicted to make room for a new one, and the shadowing of an "
+                          "evicted pair is generated again uncorrelated with its previous value. "
+                          "If set to 0, the caches are unbounded.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppPropagationLossModel::SetCacheSize,
+                                               &ThreeGppPropagationLossModel::GetCacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheHits",
+                          "The number of losses found in the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppPropagationLossModel::GetCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of losses not found in the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppPropagationLossModel::GetCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheEvictions",
+                          "The number of losses evicted from the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppPropagationLossModel::GetCacheEvictions),
+                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
@@ -112,7 +142,8 @@ ThreeGppPropagationLossModel::DoDispose()
 {
     m_channelConditionModel->Dispose();
     m_channelConditionModel = nullptr;
-    m_shadowingMap.clear();
+    m_shadowingMap.Clear();
+    m_o2iLossMap.Clear();
 }
 
 void
@@ -129,6 +160,40 @@ ThreeGppPropagationLossModel::GetChannelConditionModel() const
     return m_channelConditionModel;
 }
 
+void
+ThreeGppPropagationLossModel::SetCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_cacheSize = size;
+    std::size_t capacity = size > 0 ? size : std::numeric_limits<std::size_t>::max();
+    m_shadowingMap.SetCapacity(capacity);
+    m_o2iLossMap.SetCapacity(capacity);
+}
+
+uint32_t
+ThreeGppPropagationLossModel::GetCacheSize() const
+{
+    return m_cacheSize;
+}
+
+uint64_t
+ThreeGppPropagationLossModel::GetCacheHits() const
+{
+    return m_shadowingMap.GetHits() + m_o2iLossMap.GetHits();
+}
+
+uint64_t
+ThreeGppPropagationLossModel::GetCacheMisses() const
+{
+    return m_shadowingMap.GetMisses() + m_o2iLossMap.GetMisses();
+}
+
+uint64_t
+ThreeGppPropagationLossModel::GetCacheEvictions() const
+{
+    return m_shadowingMap.GetEvictions() + m_o2iLossMap.GetEvictions();
+}
+
 void
 ThreeGppPropagationLossModel::SetFrequency(double f)
 {
@@ -263,19 +328,17 @@ ThreeGppPropagationLossModel::GetO2iLowPenetrationLoss(
     bool notFound = false;     // indicates if the o2iLoss value has not been computed yet
     bool newCondition = false; // indicates if the channel condition has changed
 
-    auto it = m_o2iLossMap.end(); // the o2iLoss map iterator
-    if (m_o2iLossMap.find(key) != m_o2iLossMap.end())
+    O2iLossMapItem* item = m_o2iLossMap.Find(key); // the o2iLoss map entry
+    if (item)
     {
         // found the o2iLoss value in the map
-        it = m_o2iLossMap.find(key);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
-        // add a new entry in the map and update the iterator
-        O2iLossMapItem newItem;
-        it = m_o2iLossMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = m_o2iLossMap.Insert(key, O2iLossMapItem());
     }
 
     if (notFound || newCondition)
@@ -302,12 +365,12 @@ ThreeGppPropagationLossModel::GetO2iLowPenetrationLoss(
     }
     else
     {
-        o2iLossValue = it->second.m_o2iLoss;
+        o2iLossValue = item->m_o2iLoss;
     }
 
     // update the entry in the map
-    it->second.m_o2iLoss = o2iLossValue;
-    it->second.m_condition = cond;
+    item->m_o2iLoss = o2iLossValue;
+    item->m_condition = cond;
 
     return o2iLossValue;
 }
@@ -333,19 +396,17 @@ ThreeGppPropagationLossModel::GetO2iHighPenetrationLoss(
     bool notFound = false;     // indicates if the o2iLoss value has not been computed yet
     bool newCondition = false; // indicates if the channel condition has changed
 
-    auto it = m_o2iLossMap.end(); // the o2iLoss map iterator
-    if (m_o2iLossMap.find(key) != m_o2iLossMap.end())
+    O2iLossMapItem* item = m_o2iLossMap.Find(key); // the o2iLoss map entry
+    if (item)
     {
         // found the o2iLoss value in the map
-        it = m_o2iLossMap.find(key);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
-        // add a new entry in the map and update the iterator
-        O2iLossMapItem newItem;
-        it = m_o2iLossMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = m_o2iLossMap.Insert(key, O2iLossMapItem());
     }
 
     if (notFound || newCondition)
@@ -374,12 +435,12 @@ ThreeGppPropagationLossModel::GetO2iHighPenetrationLoss(
     }
     else
     {
-        o2iLossValue = it->second.m_o2iLoss;
+        o2iLossValue = item->m_o2iLoss;
     }
 
     // update the entry in the map
-    it->second.m_o2iLoss = o2iLossValue;
-    it->second.m_condition = cond;
+    item->m_o2iLoss = o2iLossValue;
+    item->m_condition = cond;
 
     return o2iLossValue;
 }
@@ -427,21 +488,19 @@ ThreeGppPropagationLossModel::GetShadowing(Ptr<MobilityModel> a,
     bool notFound = false;          // indicates if the shadowing value has not been computed yet
     bool newCondition = false;      // indicates if the channel condition has changed
     Vector newDistance;             // the distance vector, that is not a distance but a difference
-    auto it = m_shadowingMap.end(); // the shadowing map iterator
-    if (m_shadowingMap.find(key) != m_shadowingMap.end())
+    ShadowingMapItem* item = m_shadowingMap.Find(key); // the shadowing map entry
+    if (item)
     {
         // found the shadowing value in the map
-        it = m_shadowingMap.find(key);
         newDistance = GetVectorDifference(a, b);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
 
-        // add a new entry in the map and update the iterator
-        ShadowingMapItem newItem;
-        it = m_shadowingMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = m_shadowingMap.Insert(key, ShadowingMapItem());
     }
 
     if (notFound || newCondition)
@@ -452,19 +511,19 @@ ThreeGppPropagationLossModel::GetShadowing(Ptr<MobilityModel> a,
     else
     {
         // compute a new correlated shadowing loss
-        Vector2D displacement(newDistance.x - it->second.m_distance.x,
-                              newDistance.y - it->second.m_distance.y);
+        Vector2D displacement(newDistance.x - item->m_distance.x,
+                              newDistance.y - item->m_distance.y);
         double R = exp(-1 * displacement.GetLength() / GetShadowingCorrelationDistance(cond));
-        shadowingValue = R * it->second.m_shadowing + sqrt(1 - R * R) *
-                                                          m_normRandomVariable->GetValue() *
-                                                          GetShadowingStd(a, b, cond);
+        shadowingValue = R * item->m_shadowing + sqrt(1 - R * R) *
+                                                     m_normRandomVariable->GetValue() *
+                                                     GetShadowingStd(a, b, cond);
     }
 
     // update the entry in the map
-    it->second.m_shadowing = shadowingValue;
-    it->second.m_distance = newDistance; // Save the (0,0,0) vector in case it's the first time we
-                                         // are calculating this value
-    it->second.m_condition = cond;
+    item->m_shadowing = shadowingValue;
+    item->m_distance = newDistance; // Save the (0,0,0) vector in case it's the first time we
+                                    // are calculating this value
+    item->m_condition = cond;
 
     return shadowingValue;
 }
@@ -22,6 +22,8 @@
 #include "channel-condition-model.h"
 #include "propagation-loss-model.h"
 
+#include "ns3/lru-cache.h"
+
 namespace ns3
 {
 
@@ -29,6 +31,18 @@ namespace ns3
  * \ingroup propagation
  *
  * \brief Base class for the 3GPP propagation models
+ *
+ * The shadowing and building penetration losses are cached per pair of
+ * nodes.  The attribute "CacheSize" bounds the number of cached pairs, to
+ * limit the memory used by simulations with many moving nodes: the losses
+ * of the least recently used pair are evicted to cache a new one, and are
+ * generated again at its next use, as new independent realizations: the
+ * shadowing of an evicted pair is not correlated with its previous value,
+ * as the correlated shadowing of TR 38.901 Sec. 7.4.4 depends on the
+ * evicted state.  The eviction thus changes the random values drawn by the
+ * model, and the simulation results depend on the cache size, as they
+ * depend on the random number generator run.  By default, the caches are
+ * unbounded.
  */
 class ThreeGppPropagationLossModel : public PropagationLossModel
 {
@@ -86,6 +100,33 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
      */
     bool IsO2iLowPenetrationLoss(Ptr<const ChannelCondition> cond) const;
 
+    /**
+     * \brief Set the maximum number of pairs of nodes whose losses are cached
+     * \param size the maximum number of cached pairs, or 0 for no limit
+     */
+    void SetCacheSize(uint32_t size);
+
+    /**
+     * \brief Return the maximum number of pairs of nodes whose losses are cached
+     * \return the maximum number of cached pairs, or 0 for no limit
+     */
+    uint32_t GetCacheSize() const;
+
+    /**
+     * \return the number of shadowing and building penetration losses found in the caches
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of shadowing and building penetration losses not found in the caches
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * \return the number of shadowing and building penetration losses evicted from the caches
+     */
+    uint64_t GetCacheEvictions() const;
+
   private:
     /**
      * Computes the received power by applying the pathloss model described in
@@ -316,8 +357,8 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
         Vector m_distance;                               //!< the vector AB
     };
 
-    mutable std::unordered_map<uint32_t, ShadowingMapItem>
-        m_shadowingMap; //!< map to store the shadowing values
+    mutable LruCache<uint32_t, ShadowingMapItem>
+        m_shadowingMap; //!< cache to store the shadowing values
 
     /** Define a struct for the m_o2iLossMap entries */
     struct O2iLossMapItem
@@ -326,8 +367,9 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
         ChannelCondition::LosConditionValue m_condition; //!< the LOS/NLOS condition
     };
 
-    mutable std::unordered_map<uint32_t, O2iLossMapItem>
-        m_o2iLossMap; //!< map to store the o2i Loss values
+    mutable LruCache<uint32_t, O2iLossMapItem>
+        m_o2iLossMap;        //!< cache to store the o2i Loss values
+    uint32_t m_cacheSize{0}; //!< the maximum number of pairs of nodes in the caches
 
     Ptr<UniformRandomVariable> m_randomO2iVar1; //!< a uniform random variable for the calculation
                                                 //!< of the indoor loss, see TR38.901 Table 7.4.3-2
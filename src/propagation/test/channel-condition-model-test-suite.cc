@@ -25,6 +25,8 @@
 #include "ns3/node-container.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/three-gpp-propagation-loss-model.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -277,6 +279,143 @@ ThreeGppChannelConditionModelTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the bounded cache of the 3GPP channel condition models. The
+ * channel conditions between a node and four other nodes are queried in
+ * turn, several times per update period, from a model caching the condition
+ * of a single pair of nodes and from a model whose cache holds all the pairs,
+ * and thus never evicts a condition. The evicted conditions are computed
+ * again from the same random values, so the two models must return the same
+ * conditions, and two 3GPP propagation loss models using them must return
+ * the same losses. The statistics of the caches are also checked.
+ */
+class ThreeGppChannelConditionCacheTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelConditionCacheTestCase();
+
+  private:
+    /**
+     * Builds the simulation scenario and perform the tests
+     */
+    void DoRun() override;
+
+    /**
+     * Compare the channel conditions between a and b returned by the two
+     * models, and the losses computed with them
+     * \param a the mobility model of the first node
+     * \param b the mobility model of the second node
+     */
+    void CompareChannelConditions(Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+
+    Ptr<ThreeGppChannelConditionModel> m_bounded;    //!< the model caching a single pair
+    Ptr<ThreeGppChannelConditionModel> m_large;      //!< the model caching all the pairs
+    Ptr<ThreeGppPropagationLossModel> m_boundedLoss; //!< the loss model using m_bounded
+    Ptr<ThreeGppPropagationLossModel> m_largeLoss;   //!< the loss model using m_large
+    uint32_t m_numLos{0};                            //!< the number of LOS occurrences
+};
+
+ThreeGppChannelConditionCacheTestCase::ThreeGppChannelConditionCacheTestCase()
+    : TestCase("Test case for the bounded cache of the ThreeGppChannelConditionModel")
+{
+}
+
+void
+ThreeGppChannelConditionCacheTestCase::CompareChannelConditions(Ptr<MobilityModel> a,
+                                                                Ptr<MobilityModel> b)
+{
+    Ptr<ChannelCondition> bounded = m_bounded->GetChannelCondition(a, b);
+    Ptr<ChannelCondition> large = m_large->GetChannelCondition(a, b);
+    NS_TEST_EXPECT_MSG_EQ(bounded->GetLosCondition(),
+                          large->GetLosCondition(),
+                          "The eviction changed the channel condition at " << Simulator::Now());
+    if (bounded->GetLosCondition() == ChannelCondition::LosConditionValue::LOS)
+    {
+        m_numLos++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_boundedLoss->CalcRxPower(0, a, b),
+                          m_largeLoss->CalcRxPower(0, a, b),
+                          "The eviction changed the loss at " << Simulator::Now());
+}
+
+void
+ThreeGppChannelConditionCacheTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(i == 0 ? Vector(0, 0, 25.0) : Vector(60.0 * i, 0, 1.5));
+        nodes.Get(i)->AggregateObject(mobility);
+        mobilities.push_back(mobility);
+    }
+
+    m_bounded = CreateObject<ThreeGppUmaChannelConditionModel>();
+    m_bounded->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    m_bounded->SetAttribute("CacheSize", UintegerValue(1));
+    m_bounded->AssignStreams(1);
+    m_large = CreateObject<ThreeGppUmaChannelConditionModel>();
+    m_large->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    m_large->SetAttribute("CacheSize", UintegerValue(1000));
+    m_large->AssignStreams(1);
+
+    m_boundedLoss = CreateObject<ThreeGppUmaPropagationLossModel>();
+    m_boundedLoss->SetChannelConditionModel(m_bounded);
+    m_boundedLoss->AssignStreams(10);
+    m_largeLoss = CreateObject<ThreeGppUmaPropagationLossModel>();
+    m_largeLoss->SetChannelConditionModel(m_large);
+    m_largeLoss->AssignStreams(10);
+
+    // The pairs of nodes are used in turn, so that their conditions are
+    // evicted from the bounded cache several times per update period
+    const uint32_t numRounds = 50;
+    for (uint32_t round = 0; round < numRounds; round++)
+    {
+        for (uint32_t i = 1; i < nodes.GetN(); i++)
+        {
+            Simulator::Schedule(MilliSeconds(30 * round + i),
+                                &ThreeGppChannelConditionCacheTestCase::CompareChannelConditions,
+                                this,
+                                mobilities[0],
+                                mobilities[i]);
+        }
+    }
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_numLos, 0, "No LOS condition");
+    NS_TEST_EXPECT_MSG_LT(m_numLos, numRounds * 4, "No NLOS condition");
+
+    // The bounded cache misses the condition of each pair when it is first
+    // used in a round, and finds it when the loss model uses it
+    UintegerValue value;
+    m_bounded->GetAttribute("CacheHits", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), numRounds * 4, "Wrong number of hits of the bounded cache");
+    m_bounded->GetAttribute("CacheMisses", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), numRounds * 4, "Wrong number of misses");
+    m_bounded->GetAttribute("CacheEvictions", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), numRounds * 4 - 1, "Wrong number of evictions");
+    m_large->GetAttribute("CacheHits", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), numRounds * 8 - 4, "Wrong number of hits");
+    m_large->GetAttribute("CacheEvictions", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), 0, "The large cache evicted conditions");
+
+    // The condition of the most recently used pair is still cached
+    Ptr<ChannelCondition> cond = m_bounded->GetChannelCondition(mobilities[0], mobilities[4]);
+    NS_TEST_EXPECT_MSG_EQ(cond,
+                          m_bounded->GetChannelCondition(mobilities[4], mobilities[0]),
+                          "The cached condition is not reused");
+    NS_TEST_EXPECT_MSG_EQ(m_bounded->GetCacheHits(), numRounds * 4 + 2, "Wrong number of hits");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -292,6 +431,7 @@ ChannelConditionModelsTestSuite::ChannelConditionModelsTestSuite()
     : TestSuite("propagation-channel-condition-model", UNIT)
 {
     AddTestCase(new ThreeGppChannelConditionModelTestCase, TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelConditionCacheTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -16,13 +16,20 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/waypoint-mobility-model.h"
+
+#include <functional>
+#include <vector>
 
 using namespace ns3;
 
@@ -489,6 +496,252 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief PropagationLossModel::CalcMaxRange Test
+ */
+class MaxRangePropagationLossModelTestCase : public TestCase
+{
+  public:
+    MaxRangePropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MaxRangePropagationLossModelTestCase::MaxRangePropagationLossModelTestCase()
+    : TestCase("Test PropagationLossModel::CalcMaxRange")
+{
+}
+
+void
+MaxRangePropagationLossModelTestCase::DoRun()
+{
+    // A loss of 40 dB at 1 m and 30 dB per decade reaches 100 dB at 100 m
+    Ptr<LogDistancePropagationLossModel> lossModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    lossModel->SetAttribute("Exponent", DoubleValue(3));
+    lossModel->SetAttribute("ReferenceDistance", DoubleValue(1));
+    lossModel->SetAttribute("ReferenceLoss", DoubleValue(40));
+    NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcMaxRange(20, -80),
+                              100,
+                              1e-3,
+                              "Got unexpected max range");
+
+    // The max range is capped by a chained RangePropagationLossModel
+    Ptr<RangePropagationLossModel> rangeModel = CreateObject<RangePropagationLossModel>();
+    rangeModel->SetAttribute("MaxRange", DoubleValue(50));
+    lossModel->SetNext(rangeModel);
+    NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcMaxRange(20, -80),
+                              50,
+                              1e-3,
+                              "Got unexpected max range");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->CalcMaxRange(20, -2000, 1000),
+                          1000,
+                          "Got unexpected max range");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test of the Rx Powers computed for several receivers at once
+ *
+ * Checks that each model, alone and chained to other models, returns the
+ * same Rx Powers for several receivers at once as for each receiver in
+ * turn, for distances in all the ranges of the models.
+ */
+class BatchPropagationLossModelTestCase : public TestCase
+{
+  public:
+    BatchPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase()
+    : TestCase("Test PropagationLossModel::CalcRxPower for several receivers")
+{
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 1.5));
+    std::vector<Ptr<MobilityModel>> b;
+    for (double distance : {0.0, 0.3, 1.0, 2.0, 50.0, 150.0, 300.0, 600.0, 1000.0, 5000.0})
+    {
+        for (double height : {0.5, 1.5, 30.0})
+        {
+            Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(distance, 0, height));
+            b.push_back(mobility);
+        }
+    }
+
+    // Two identical chains, using the same random streams
+    auto check = [&](const std::string& name,
+                     const std::function<Ptr<PropagationLossModel>()>& createChain) {
+        Ptr<PropagationLossModel> scalar = createChain();
+        Ptr<PropagationLossModel> batch = createChain();
+        scalar->AssignStreams(1);
+        batch->AssignStreams(1);
+        std::vector<double> rxPowerDbm(b.size());
+        batch->CalcRxPower(10, a, b, rxPowerDbm);
+        for (std::size_t i = 0; i < b.size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rxPowerDbm[i],
+                                  scalar->CalcRxPower(10, a, b[i]),
+                                  name << ": got unexpected rcv power for receiver " << i);
+        }
+    };
+
+    check("Friis", []() { return CreateObject<FriisPropagationLossModel>(); });
+    check("TwoRayGround", []() {
+        Ptr<PropagationLossModel> model = CreateObject<TwoRayGroundPropagationLossModel>();
+        model->SetAttribute("HeightAboveZ", DoubleValue(1));
+        return model;
+    });
+    check("LogDistance", []() { return CreateObject<LogDistancePropagationLossModel>(); });
+    check("ThreeLogDistance",
+          []() { return CreateObject<ThreeLogDistancePropagationLossModel>(); });
+    check("Range", []() {
+        Ptr<PropagationLossModel> model = CreateObject<RangePropagationLossModel>();
+        model->SetAttribute("MaxRange", DoubleValue(700));
+        return model;
+    });
+    // A chain of models with and without their own implementation for
+    // several receivers, including random ones
+    check("Chain", []() {
+        Ptr<PropagationLossModel> model = CreateObject<ThreeLogDistancePropagationLossModel>();
+        Ptr<PropagationLossModel> nakagami = CreateObject<NakagamiPropagationLossModel>();
+        model->SetNext(nakagami);
+        nakagami->SetNext(CreateObject<RangePropagationLossModel>());
+        return model;
+    });
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationLossModel Test
+ *
+ * Checks that a LogDistancePropagationLossModel followed by a
+ * NakagamiPropagationLossModel returns the same Rx Powers with and without
+ * caching the LogDistancePropagationLossModel, and that the Rx Powers are
+ * only reused for static nodes whose position and transmission power have
+ * not changed, also when the mobility model only notifies its course changes
+ * when its position is queried.
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(50, 0, 0));
+    Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel>();
+    c->SetPosition(Vector(0, 20, 0));
+    c->SetVelocity(Vector(1, 0, 0));
+
+    Ptr<PropagationLossModel> reference = CreateObject<LogDistancePropagationLossModel>();
+    reference->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    reference->AssignStreams(1);
+    Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+    cached->SetModel(CreateObject<LogDistancePropagationLossModel>());
+    cached->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    cached->AssignStreams(1);
+
+    auto check = [&](double txPowerDbm,
+                     Ptr<MobilityModel> tx,
+                     Ptr<MobilityModel> rx,
+                     uint64_t hits,
+                     uint64_t misses) {
+        double rxPowerDbm = reference->CalcRxPower(txPowerDbm, tx, rx);
+        NS_TEST_EXPECT_MSG_EQ(cached->CalcRxPower(txPowerDbm, tx, rx),
+                              rxPowerDbm,
+                              "Got unexpected rcv power");
+        NS_TEST_EXPECT_MSG_EQ(cached->GetCacheHits(), hits, "Unexpected number of hits");
+        NS_TEST_EXPECT_MSG_EQ(cached->GetCacheMisses(), misses, "Unexpected number of misses");
+    };
+
+    // The Rx Power of a pair of static nodes is computed once
+    check(20, a, b, 0, 1);
+    check(20, a, b, 1, 1);
+    check(20, a, b, 2, 1);
+    // Links are not symmetric
+    check(20, b, a, 2, 2);
+    check(20, b, a, 3, 2);
+    // The Rx Power is computed again after a node is moved or with another power
+    b->SetPosition(Vector(80, 0, 0));
+    check(20, a, b, 3, 3);
+    check(20, a, b, 4, 3);
+    check(10, a, b, 4, 4);
+    check(10, a, b, 5, 4);
+    // The Rx Power of a moving node is never cached
+    check(20, a, c, 5, 5);
+    check(20, a, c, 5, 6);
+    c->SetVelocity(Vector(0, 0, 0));
+    check(20, a, c, 5, 7);
+    check(20, a, c, 6, 7);
+    NS_TEST_EXPECT_MSG_EQ(cached->GetCacheEvictions(), 0, "Unexpected number of evictions");
+
+    // A bounded cache evicts the least recently used pairs
+    cached->SetCacheSize(2);
+    NS_TEST_EXPECT_MSG_EQ(cached->GetCacheEvictions(), 1, "Unexpected number of evictions");
+    check(10, a, b, 7, 7);
+    check(20, b, a, 7, 8);
+    NS_TEST_EXPECT_MSG_EQ(cached->GetCacheEvictions(), 2, "Unexpected number of evictions");
+    cached->ClearCache();
+    check(10, a, b, 7, 9);
+
+    // A node paused between two equal waypoints, and then moving, with a
+    // mobility model lazily notifying its course changes
+    Ptr<WaypointMobilityModel> d = CreateObject<WaypointMobilityModel>();
+    d->SetAttribute("LazyNotify", BooleanValue(true));
+    d->AddWaypoint(Waypoint(Seconds(0), Vector(0, 50, 0)));
+    d->AddWaypoint(Waypoint(Seconds(1), Vector(0, 50, 0)));
+    d->AddWaypoint(Waypoint(Seconds(2), Vector(0, 100, 0)));
+    Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel>();
+    Ptr<CachedPropagationLossModel> lazy = CreateObject<CachedPropagationLossModel>();
+    lazy->SetModel(CreateObject<LogDistancePropagationLossModel>());
+
+    auto checkLazy = [&](uint64_t hits, uint64_t misses) {
+        // The cached model is queried first, so that it is the first to query
+        // the position of the lazy mobility model
+        double rxPowerDbm = lazy->CalcRxPower(20, a, d);
+        NS_TEST_EXPECT_MSG_EQ(rxPowerDbm,
+                              logDistance->CalcRxPower(20, a, d),
+                              "Got unexpected rcv power at " << Simulator::Now().As(Time::S));
+        NS_TEST_EXPECT_MSG_EQ(lazy->GetCacheHits(), hits, "Unexpected number of hits");
+        NS_TEST_EXPECT_MSG_EQ(lazy->GetCacheMisses(), misses, "Unexpected number of misses");
+    };
+    Simulator::Schedule(Seconds(0.5), [&]() { checkLazy(0, 1); });
+    Simulator::Schedule(Seconds(0.75), [&]() { checkLazy(1, 1); });
+    Simulator::Schedule(Seconds(1.5), [&]() { checkLazy(1, 2); });
+    Simulator::Run();
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +753,9 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - PropagationLossModel::CalcMaxRange
+ *   - PropagationLossModel::CalcRxPower for several receivers
+ *   - CachedPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +771,9 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new MaxRangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new BatchPropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -29,6 +29,7 @@
 #include "ns3/test.h"
 #include "ns3/three-gpp-propagation-loss-model.h"
 #include "ns3/three-gpp-v2v-propagation-loss-model.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1304,6 +1305,66 @@ ThreeGppShadowingTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * Test of the bounded cache of the 3GPP propagation loss models. The shadowing
+ * of a static link is the same at each use, from the second one, while it is
+ * cached, and is generated again, uncorrelated, once it was evicted by the use
+ * of another link.
+ */
+class ThreeGppShadowingCacheTestCase : public TestCase
+{
+  public:
+    ThreeGppShadowingCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ThreeGppShadowingCacheTestCase::ThreeGppShadowingCacheTestCase()
+    : TestCase("Test the shadowing evicted from the bounded cache")
+{
+}
+
+void
+ThreeGppShadowingCacheTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(3);
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(i == 0 ? Vector(0, 0, 25.0) : Vector(100.0 * i, 0, 1.6));
+        nodes.Get(i)->AggregateObject(mobility);
+        mobilities.push_back(mobility);
+    }
+
+    Ptr<ThreeGppPropagationLossModel> lossModel = CreateObject<ThreeGppUmaPropagationLossModel>();
+    lossModel->SetAttribute("Frequency", DoubleValue(3.5e9));
+    lossModel->SetAttribute("ShadowingEnabled", BooleanValue(true));
+    lossModel->SetAttribute("CacheSize", UintegerValue(1));
+    lossModel->SetChannelConditionModel(CreateObject<AlwaysLosChannelConditionModel>());
+    lossModel->AssignStreams(1);
+
+    // the position of b relative to a is only saved with the shadowing from
+    // its second computation, which correlates it with the first one
+    lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    double cached = lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    double again = lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    NS_TEST_EXPECT_MSG_EQ(again, cached, "The cached shadowing of a static link changed");
+    lossModel->CalcRxPower(0, mobilities[0], mobilities[2]);
+    double regenerated = lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    NS_TEST_EXPECT_MSG_NE(regenerated, cached, "The evicted shadowing was not generated again");
+
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheHits(), 2, "Wrong number of hits");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 3, "Wrong number of misses");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheEvictions(), 2, "Wrong number of evictions");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -1317,6 +1378,7 @@ ThreeGppShadowingTestCase::DoRun()
  *   - ThreeGppV2vUrbanPropagationLossModel
  *   - ThreeGppV2vHighwayPropagationLossModel
  *   - ThreeGppShadowing
+ *   - ThreeGppShadowingCache
  */
 class ThreeGppPropagationLossModelsTestSuite : public TestSuite
 {
@@ -1334,6 +1396,7 @@ ThreeGppPropagationLossModelsTestSuite::ThreeGppPropagationLossModelsTestSuite()
     AddTestCase(new ThreeGppV2vUrbanPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new ThreeGppV2vHighwayPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new ThreeGppShadowingTestCase, TestCase::QUICK);
+    AddTestCase(new ThreeGppShadowingCacheTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
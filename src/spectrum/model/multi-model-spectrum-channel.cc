@@ -81,7 +81,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_maxRange{0}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,18 +93,32 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    if (m_rxIndex)
+    {
+        m_rxIndex->Dispose();
+        m_rxIndex = nullptr;
+    }
+    m_indexedRxPhys.clear();
+    m_unlocatedRxPhys.clear();
     SpectrumChannel::DoDispose();
 }
 
 TypeId
 MultiModelSpectrumChannel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::MultiModelSpectrumChannel")
-                            .SetParent<SpectrumChannel>()
-                            .SetGroupName("Spectrum")
-                            .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+    static TypeId tid =
+        TypeId("ns3::MultiModelSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<MultiModelSpectrumChannel>()
+            .AddAttribute("MaxRange",
+                          "If greater than zero, the maximum distance, in meters, between a "
+                          "transmitter and the receivers to which its transmissions are "
+                          "propagated. The other receivers are found through a spatial index, "
+                          "without computing the propagation loss to them.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&MultiModelSpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -112,6 +127,13 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
 
+    // the spatial index of the receivers is rebuilt on the next transmission
+    if (m_rxIndex)
+    {
+        m_rxIndex->Dispose();
+        m_rxIndex = nullptr;
+    }
+
     // remove a previous entry of this phy if it exists
     // we need to scan for all rxSpectrumModel values since we don't
     // know which spectrum model the phy had when it was previously added
@@ -252,6 +274,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    // With a max range, only the receivers within that range of the
+    // transmitter, and those without a mobility model, are considered
+    bool inRangeOnly = m_maxRange > 0 && txMobility;
+    std::map<SpectrumModelUid_t, std::vector<Ptr<SpectrumPhy>>> rxPhysInRange;
+    if (inRangeOnly)
+    {
+        rxPhysInRange = GetRxPhysInRange(txMobility);
+    }
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -259,6 +290,17 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
+        const std::vector<Ptr<SpectrumPhy>>* rxPhys = &rxInfoIterator->second.m_rxPhys;
+        if (inRangeOnly)
+        {
+            auto rxPhysIterator = rxPhysInRange.find(rxSpectrumModelUid);
+            if (rxPhysIterator == rxPhysInRange.end())
+            {
+                continue;
+            }
+            rxPhys = &rxPhysIterator->second;
+        }
+
         Ptr<SpectrumValue> convertedTxPowerSpectrum;
         if (txSpectrumModelUid == rxSpectrumModelUid)
         {
@@ -279,9 +321,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        for (auto rxPhyIterator = rxPhys->begin(); rxPhyIterator != rxPhys->end(); ++rxPhyIterator)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -395,6 +435,49 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     }
 }
 
+std::map<SpectrumModelUid_t, std::vector<Ptr<SpectrumPhy>>>
+MultiModelSpectrumChannel::GetRxPhysInRange(Ptr<MobilityModel> txMobility)
+{
+    NS_LOG_FUNCTION(this << txMobility);
+
+    if (!m_rxIndex)
+    {
+        m_rxIndex = CreateObject<SpatialIndex>();
+        m_rxIndex->SetAttribute("CellSize", DoubleValue(m_maxRange));
+        m_indexedRxPhys.clear();
+        m_unlocatedRxPhys.clear();
+        for (const auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+        {
+            for (const auto& rxPhy : rxInfo.m_rxPhys)
+            {
+                uint32_t id = m_indexedRxPhys.size();
+                m_indexedRxPhys.emplace_back(rxSpectrumModelUid, rxPhy);
+                if (Ptr<MobilityModel> rxMobility = rxPhy->GetMobility())
+                {
+                    m_rxIndex->Add(id, rxMobility);
+                }
+                else
+                {
+                    m_unlocatedRxPhys.push_back(id);
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> ids = m_rxIndex->GetItemsWithin(txMobility->GetPosition(), m_maxRange);
+    if (!m_unlocatedRxPhys.empty())
+    {
+        ids.insert(ids.end(), m_unlocatedRxPhys.begin(), m_unlocatedRxPhys.end());
+        std::sort(ids.begin(), ids.end());
+    }
+    std::map<SpectrumModelUid_t, std::vector<Ptr<SpectrumPhy>>> rxPhys;
+    for (auto id : ids)
+    {
+        rxPhys[m_indexedRxPhys[id].first].push_back(m_indexedRxPhys[id].second);
+    }
+    return rxPhys;
+}
+
 void
 MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
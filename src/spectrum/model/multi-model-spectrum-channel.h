@@ -26,6 +26,7 @@
 #include "spectrum-value.h"
 
 #include <ns3/propagation-delay-model.h>
+#include <ns3/spatial-index.h>
 
 #include <map>
 #include <set>
@@ -99,6 +100,15 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * If the MaxRange attribute is set, the receivers are kept in a
+ * SpatialIndex, and a transmission is only propagated to the receivers
+ * within that distance of the transmitter, and to the receivers without
+ * a mobility model, without computing the propagation loss to the other
+ * receivers. The index is rebuilt on the first transmission after a
+ * receiver is added or removed, so a receiver must have its mobility
+ * model when it is added to the channel or before the first
+ * transmission.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -145,6 +155,18 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      */
     virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+    /**
+     * Get the receivers within MaxRange of a transmitter, and the receivers
+     * without a mobility model, building the spatial index of the
+     * receivers if needed.
+     *
+     * \param txMobility The mobility model of the transmitter.
+     * \return The receivers, per RX spectrum model, in the order of
+     *         m_rxSpectrumModelInfoMap.
+     */
+    std::map<SpectrumModelUid_t, std::vector<Ptr<SpectrumPhy>>> GetRxPhysInRange(
+        Ptr<MobilityModel> txMobility);
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -163,6 +185,19 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    double m_maxRange;           //!< Max distance of the receivers, 0 for no limit
+    Ptr<SpatialIndex> m_rxIndex; //!< Spatial index of the receivers, if built
+
+    /**
+     * Receivers, with their RX spectrum model, by identifier in m_rxIndex
+     */
+    std::vector<std::pair<SpectrumModelUid_t, Ptr<SpectrumPhy>>> m_indexedRxPhys;
+
+    /**
+     * Identifiers of the receivers without a mobility model
+     */
+    std::vector<uint32_t> m_unlocatedRxPhys;
 };
 
 } // namespace ns3
@@ -119,6 +119,9 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
+    // Select the receivers, whose propagation gains are then computed at once
+    std::vector<Ptr<SpectrumPhy>> receivers;
+    std::vector<Ptr<MobilityModel>> lossMobilities;
     for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
@@ -142,86 +145,101 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
         if ((*rxPhyIterator) != txParams->txPhy)
         {
-            Time delay = MicroSeconds(0);
-
+            receivers.push_back(*rxPhyIterator);
             Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-
-            if (senderMobility && receiverMobility)
+            if (senderMobility && receiverMobility && m_propagationLoss)
             {
-                double txAntennaGain = 0;
-                double rxAntennaGain = 0;
-                double propagationGainDb = 0;
-                double pathLossDb = 0;
-                if (rxParams->txAntenna)
-                {
-                    Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    pathLossDb -= txAntennaGain;
-                }
-                Ptr<AntennaModel> rxAntenna =
-                    DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                if (rxAntenna)
-                {
-                    Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
-                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                    pathLossDb -= rxAntennaGain;
-                }
-                if (m_propagationLoss)
-                {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
-                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                    pathLossDb -= propagationGainDb;
-                }
-                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                // Gain trace
-                m_gainTrace(senderMobility,
-                            receiverMobility,
-                            txAntennaGain,
-                            rxAntennaGain,
-                            propagationGainDb,
-                            pathLossDb);
-                // Pathloss trace
-                m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                if (pathLossDb > m_maxLossDb)
-                {
-                    // beyond range
-                    continue;
-                }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
-
-                if (m_propagationDelay)
-                {
-                    delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
-                }
+                lossMobilities.push_back(receiverMobility);
             }
+        }
+    }
+    std::vector<double> propagationGainsDb(lossMobilities.size());
+    if (!lossMobilities.empty())
+    {
+        m_propagationLoss->CalcRxPower(0, senderMobility, lossMobilities, propagationGainsDb);
+    }
 
-            if (rxNetDevice)
+    std::size_t lossIndex = 0;
+    for (auto rxPhyIterator = receivers.begin(); rxPhyIterator != receivers.end(); ++rxPhyIterator)
+    {
+        Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
+        Time delay = MicroSeconds(0);
+
+        Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+
+        if (senderMobility && receiverMobility)
+        {
+            double txAntennaGain = 0;
+            double rxAntennaGain = 0;
+            double propagationGainDb = 0;
+            double pathLossDb = 0;
+            if (rxParams->txAntenna)
             {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
+                Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+                txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+                pathLossDb -= txAntennaGain;
             }
-            else
+            Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
+            if (rxAntenna)
             {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
+                Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+                rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+                NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+                pathLossDb -= rxAntennaGain;
             }
+            if (m_propagationLoss)
+            {
+                propagationGainDb = propagationGainsDb[lossIndex++];
+                NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+                pathLossDb -= propagationGainDb;
+            }
+            NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+            // Gain trace
+            m_gainTrace(senderMobility,
+                        receiverMobility,
+                        txAntennaGain,
+                        rxAntennaGain,
+                        propagationGainDb,
+                        pathLossDb);
+            // Pathloss trace
+            m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
+            if (pathLossDb > m_maxLossDb)
+            {
+                // beyond range
+                continue;
+            }
+            double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+            *(rxParams->psd) *= pathGainLinear;
+
+            if (m_propagationDelay)
+            {
+                delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+            }
+        }
+
+        if (rxNetDevice)
+        {
+            // the receiver has a NetDevice, so we expect that it is attached to a Node
+            uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+            Simulator::ScheduleWithContext(dstNode,
+                                           delay,
+                                           &SingleModelSpectrumChannel::StartRx,
+                                           this,
+                                           rxParams,
+                                           *rxPhyIterator);
+        }
+        else
+        {
+            // the receiver is not attached to a NetDevice, so we cannot assume that it is
+            // attached to a node
+            Simulator::Schedule(delay,
+                                &SingleModelSpectrumChannel::StartRx,
+                                this,
+                                rxParams,
+                                *rxPhyIterator);
         }
     }
 }
@@ -40,11 +40,49 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
     m_fromSpectrumModel = fromSpectrumModel;
     m_toSpectrumModel = toSpectrumModel;
 
+    uint64_t key = (static_cast<uint64_t>(fromSpectrumModel->GetUid()) << 32) |
+                   toSpectrumModel->GetUid();
+    auto& matrices = GetConversionMatrices();
+    Ptr<const ConversionMatrix>* matrix = matrices.Find(key);
+    if (!matrix)
+    {
+        matrix = matrices.Insert(key, BuildConversionMatrix());
+    }
+    m_conversionMatrix = *matrix;
+}
+
+SpectrumConverter::ConversionMatrixCache&
+SpectrumConverter::GetConversionMatrices()
+{
+    // The spectrum models are never destroyed while a simulation uses them,
+    // but they can be created again by each run of a program, with new UIDs
+    static ConversionMatrixCache matrices(1024);
+    return matrices;
+}
+
+Ptr<const SpectrumConverter::ConversionMatrix>
+SpectrumConverter::BuildConversionMatrix() const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<ConversionMatrix> matrix = Create<ConversionMatrix>();
+    auto fromBegin = m_fromSpectrumModel->Begin();
+    auto fromEnd = m_fromSpectrumModel->End();
+
+    // If the bands to convert from are sorted, those overlapping a band to
+    // convert to are contiguous
+    bool sorted = m_fromSpectrumModel->IsSorted();
+
     size_t rowPtr = 0;
-    for (auto toit = toSpectrumModel->Begin(); toit != toSpectrumModel->End(); ++toit)
+    for (auto toit = m_toSpectrumModel->Begin(); toit != m_toSpectrumModel->End(); ++toit)
     {
-        size_t colInd = 0;
-        for (auto fromit = fromSpectrumModel->Begin(); fromit != fromSpectrumModel->End(); ++fromit)
+        auto fromit = fromBegin;
+        if (sorted)
+        {
+            fromit = std::partition_point(fromBegin, fromEnd, [toit](const BandInfo& from) {
+                return from.fh <= toit->fl;
+            });
+        }
+        for (; fromit != fromEnd && !(sorted && fromit->fl >= toit->fh); ++fromit)
         {
             double c = GetCoefficient(*fromit, *toit);
             NS_LOG_LOGIC("(" << fromit->fl << "," << fromit->fh << ")"
@@ -53,14 +91,14 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
                              << " = " << c);
             if (c > 0)
             {
-                m_conversionMatrix.push_back(c);
-                m_conversionColInd.push_back(colInd);
+                matrix->values.push_back(c);
+                matrix->colInd.push_back(fromit - fromBegin);
                 rowPtr++;
             }
-            colInd++;
         }
-        m_conversionRowPtr.push_back(rowPtr);
+        matrix->rowPtr.push_back(rowPtr);
     }
+    return matrix;
 }
 
 double
@@ -80,22 +118,59 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
-    auto tvit = tvvf->ValuesBegin();
+    const double* from = fvvf->GetValues().data();
+    double* to = tvvf->GetValues().data();
+    const double* values = m_conversionMatrix->values.data();
+    const size_t* colInd = m_conversionMatrix->colInd.data();
     size_t i = 0; // Index of conversion coefficient
 
-    for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
+    for (size_t row = 0; row < m_conversionMatrix->rowPtr.size(); ++row)
     {
         double sum = 0;
-        while (i < *convIt)
+        for (size_t end = m_conversionMatrix->rowPtr[row]; i < end; i++)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += from[colInd[i]] * values[i];
         }
-        *tvit = sum;
-        ++tvit;
+        to[row] = sum;
     }
 
     return tvvf;
 }
 
+std::vector<Ptr<SpectrumValue>>
+SpectrumConverter::Convert(const std::vector<Ptr<const SpectrumValue>>& fvvfs) const
+{
+    std::vector<const double*> from;
+    std::vector<double*> to;
+    std::vector<Ptr<SpectrumValue>> tvvfs;
+    for (const auto& fvvf : fvvfs)
+    {
+        NS_ASSERT(*(fvvf->GetSpectrumModel()) == *m_fromSpectrumModel);
+        tvvfs.push_back(Create<SpectrumValue>(m_toSpectrumModel));
+        from.push_back(fvvf->GetValues().data());
+        to.push_back(tvvfs.back()->GetValues().data());
+    }
+
+    const double* values = m_conversionMatrix->values.data();
+    const size_t* colInd = m_conversionMatrix->colInd.data();
+    size_t begin = 0; // Index of the first conversion coefficient of the row
+
+    for (size_t row = 0; row < m_conversionMatrix->rowPtr.size(); ++row)
+    {
+        size_t end = m_conversionMatrix->rowPtr[row];
+        for (size_t j = 0; j < fvvfs.size(); j++)
+        {
+            double sum = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                sum += from[j][colInd[i]] * values[i];
+            }
+            to[j][row] = sum;
+        }
+        begin = end;
+    }
+
+    return tvvfs;
+}
+
 } // namespace ns3
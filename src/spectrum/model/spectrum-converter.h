@@ -22,6 +22,10 @@
 
 #include "spectrum-value.h"
 
+#include <ns3/lru-cache.h>
+
+#include <vector>
+
 namespace ns3
 {
 
@@ -37,6 +41,11 @@ namespace ns3
  * and devices using a finer representation (e.g., one frequency for
  * each OFDM subcarrier).
  *
+ * The conversion matrix is stored in Compressed Row Storage format. It is
+ * built once for each pair of SpectrumModels, and shared by all the
+ * converters between them, e.g., those of several channels. When the
+ * bands of the SpectrumModel to convert from are sorted by frequency, only
+ * the bands overlapping each band to convert to are visited to build it.
  */
 class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
 {
@@ -63,7 +72,46 @@ class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
      */
     Ptr<SpectrumValue> Convert(Ptr<const SpectrumValue> vvf) const;
 
+    /**
+     * Convert several ValueVsFreq instances, in a single pass over the
+     * conversion matrix
+     *
+     * @param vvfs the ValueVsFreq instances to be converted
+     *
+     * @return the converted versions of the provided ValueVsFreq, in the same order
+     */
+    std::vector<Ptr<SpectrumValue>> Convert(
+        const std::vector<Ptr<const SpectrumValue>>& vvfs) const;
+
   private:
+    /// Conversion matrix, in Compressed Row Storage format
+    struct ConversionMatrix : public SimpleRefCount<ConversionMatrix>
+    {
+        std::vector<double> values; //!< non-zero conversion coefficients
+        std::vector<size_t> rowPtr; //!< offset of the end of each row in values
+        std::vector<size_t> colInd; //!< column of each element of values
+    };
+
+    /**
+     * Recently built conversion matrices, indexed by the UIDs of the
+     * SpectrumModels to convert from (high 32 bits) and to (low 32 bits).
+     * The matrices of a converter are kept by the converter itself, so an
+     * evicted matrix is only rebuilt for a new converter.
+     */
+    using ConversionMatrixCache = LruCache<uint64_t, Ptr<const ConversionMatrix>>;
+
+    /**
+     * \return the conversion matrices shared by all the converters
+     */
+    static ConversionMatrixCache& GetConversionMatrices();
+
+    /**
+     * Build the conversion matrix between the SpectrumModels of this converter
+     *
+     * \return the conversion matrix
+     */
+    Ptr<const ConversionMatrix> BuildConversionMatrix() const;
+
     /**
      * Calculate the coefficient for value conversion between elements
      *
@@ -75,11 +123,7 @@ class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
      */
     double GetCoefficient(const BandInfo& from, const BandInfo& to) const;
 
-    std::vector<double> m_conversionMatrix; //!< matrix of conversion coefficients stored in
-                                            //!< Compressed Row Storage format
-    std::vector<size_t> m_conversionRowPtr; //!< offset of rows in m_conversionMatrix
-    std::vector<size_t>
-        m_conversionColInd; //!< column of each non-zero element in m_conversionMatrix
+    Ptr<const ConversionMatrix> m_conversionMatrix; //!< matrix of conversion coefficients
 
     Ptr<const SpectrumModel> m_fromSpectrumModel; //!<  the SpectrumModel this SpectrumConverter
                                                   //!<  instance can convert from
@@ -23,6 +23,7 @@
 #include <ns3/assert.h>
 #include <ns3/log.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 
@@ -67,6 +68,7 @@ SpectrumModel::SpectrumModel(const std::vector<double>& centerFreqs)
         }
         m_bands.push_back(e);
     }
+    ComputeBandProperties();
 }
 
 SpectrumModel::SpectrumModel(const Bands& bands)
@@ -74,6 +76,7 @@ SpectrumModel::SpectrumModel(const Bands& bands)
     m_uid = ++m_uidCount;
     NS_LOG_INFO("creating new SpectrumModel, m_uid=" << m_uid);
     m_bands = bands;
+    ComputeBandProperties();
 }
 
 SpectrumModel::SpectrumModel(Bands&& bands)
@@ -81,6 +84,23 @@ SpectrumModel::SpectrumModel(Bands&& bands)
 {
     m_uid = ++m_uidCount;
     NS_LOG_INFO("creating new SpectrumModel, m_uid=" << m_uid);
+    ComputeBandProperties();
+}
+
+void
+SpectrumModel::ComputeBandProperties()
+{
+    m_bandWidths.reserve(m_bands.size());
+    for (const auto& band : m_bands)
+    {
+        m_bandWidths.push_back(band.fh - band.fl);
+    }
+    m_sorted = std::is_sorted(m_bands.begin(),
+                              m_bands.end(),
+                              [](const BandInfo& a, const BandInfo& b) { return a.fl < b.fl; }) &&
+               std::is_sorted(m_bands.begin(),
+                              m_bands.end(),
+                              [](const BandInfo& a, const BandInfo& b) { return a.fh < b.fh; });
 }
 
 Bands::const_iterator
@@ -95,6 +115,18 @@ SpectrumModel::End() const
     return m_bands.end();
 }
 
+const std::vector<double>&
+SpectrumModel::GetBandWidths() const
+{
+    return m_bandWidths;
+}
+
+bool
+SpectrumModel::IsSorted() const
+{
+    return m_sorted;
+}
+
 size_t
 SpectrumModel::GetNumBands() const
 {
@@ -110,6 +142,24 @@ SpectrumModel::GetUid() const
 bool
 SpectrumModel::IsOrthogonal(const SpectrumModel& other) const
 {
+    if (other.IsSorted())
+    {
+        // The first band of the other model ending after the start of a
+        // band is the one starting first among those which may overlap it
+        for (auto myIt = Begin(); myIt != End(); ++myIt)
+        {
+            auto otherIt =
+                std::partition_point(other.Begin(), other.End(), [myIt](const BandInfo& band) {
+                    return band.fh <= myIt->fl;
+                });
+            if (otherIt != other.End() &&
+                std::max(myIt->fl, otherIt->fl) < std::min(myIt->fh, otherIt->fh))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
     for (auto myIt = Begin(); myIt != End(); ++myIt)
     {
         for (auto otherIt = other.Begin(); otherIt != other.End(); ++otherIt)
@@ -133,6 +133,21 @@ class SpectrumModel : public SimpleRefCount<SpectrumModel>
      */
     Bands::const_iterator End() const;
 
+    /**
+     * The widths of the bands, shared by the SpectrumValues of this model
+     * to compute their integral.
+     *
+     * @return the width (fh - fl) of each band, in Hz
+     */
+    const std::vector<double>& GetBandWidths() const;
+
+    /**
+     * @return true if the lower and upper limits of the bands are both
+     * non-decreasing, so that the bands overlapping a frequency range are
+     * contiguous
+     */
+    bool IsSorted() const;
+
     /**
      * Check if another SpectrumModels has bands orthogonal to our bands.
      *
@@ -142,9 +157,14 @@ class SpectrumModel : public SimpleRefCount<SpectrumModel>
     bool IsOrthogonal(const SpectrumModel& other) const;
 
   private:
+    /// Compute the widths of the bands and whether they are sorted
+    void ComputeBandProperties();
+
     Bands m_bands;            //!< Actual definition of frequency bands within this SpectrumModel
     SpectrumModelUid_t m_uid; //!< unique id for a given set of frequencies
     static SpectrumModelUid_t m_uidCount; //!< counter to assign m_uids
+    std::vector<double> m_bandWidths;     //!< width of each band
+    bool m_sorted;                        //!< whether the bands are sorted
 };
 
 } // namespace ns3
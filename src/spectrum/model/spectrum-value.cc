@@ -20,14 +20,117 @@
 
 #include "spectrum-value.h"
 
+#include <ns3/boolean.h>
+#include <ns3/global-value.h>
 #include <ns3/log.h>
 #include <ns3/math.h>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("SpectrumValue");
 
+/**
+ * \relates SpectrumValue
+ * \anchor GlobalValueSpectrumValueInterleavedSums
+ * \brief Whether Sum(), Norm() and Integral() accumulate the values in four
+ * interleaved partial sums, instead of in the order of the bands.
+ */
+static GlobalValue g_interleavedSums =
+    GlobalValue("SpectrumValueInterleavedSums",
+                "Whether the sums of the values of SpectrumValues are accumulated in four "
+                "interleaved partial sums, which may change the last bits of the results",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+namespace
+{
+
+/**
+ * Compute the sum of the values of an array, or of their products with the
+ * values of another array.
+ *
+ * By default, the values are accumulated in order.  If the interleaved sums
+ * are enabled, they are accumulated in four interleaved partial sums, with
+ * AVX2 instructions when they are available and with scalar code otherwise,
+ * so that both compute the same sum in the same order.
+ *
+ * \param x the values
+ * \param y the factors of the values, or nullptr
+ * \param n the number of values
+ * \return the sum of the values, or of their products with the factors
+ */
+double
+SumKernel(const double* x, const double* y, std::size_t n)
+{
+    std::size_t i = 0;
+    BooleanValue interleaved;
+    g_interleavedSums.GetValue(interleaved);
+    if (!interleaved.Get())
+    {
+        double sum = 0;
+        for (; i < n; i++)
+        {
+            sum += y ? x[i] * y[i] : x[i];
+        }
+        return sum;
+    }
+#ifdef __AVX2__
+    __m256d sums = _mm256_setzero_pd();
+    if (y)
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            sums = _mm256_add_pd(sums,
+                                 _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            sums = _mm256_add_pd(sums, _mm256_loadu_pd(x + i));
+        }
+    }
+    alignas(32) double partial[4];
+    _mm256_store_pd(partial, sums);
+#else
+    double partial[4] = {0, 0, 0, 0};
+    if (y)
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            for (std::size_t j = 0; j < 4; j++)
+            {
+                partial[j] += x[i + j] * y[i + j];
+            }
+        }
+    }
+    else
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            for (std::size_t j = 0; j < 4; j++)
+            {
+                partial[j] += x[i + j];
+            }
+        }
+    }
+#endif
+    double sum = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+    for (; i < n; i++)
+    {
+        sum += y ? x[i] * y[i] : x[i];
+    }
+    return sum;
+}
+
+} // namespace
+
 SpectrumValue::SpectrumValue()
 {
 }
@@ -101,46 +204,41 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
+        values[i] += other[i];
     }
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 += s;
-        ++it1;
+        values[i] += s;
     }
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
+        values[i] -= other[i];
     }
 }
 
@@ -153,46 +251,41 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
+        values[i] *= other[i];
     }
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 *= s;
-        ++it1;
+        values[i] *= s;
     }
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
+        values[i] /= other[i];
     }
 }
 
@@ -200,12 +293,11 @@ void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    const std::size_t n = m_values.size();
+    double* values = m_values.data();
+    for (std::size_t i = 0; i < n; i++)
     {
-        *it1 /= s;
-        ++it1;
+        values[i] /= s;
     }
 }
 
@@ -321,27 +413,13 @@ SpectrumValue::Log()
 double
 Norm(const SpectrumValue& x)
 {
-    double s = 0;
-    auto it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
-    {
-        s += (*it1) * (*it1);
-        ++it1;
-    }
-    return std::sqrt(s);
+    return std::sqrt(SumKernel(x.m_values.data(), x.m_values.data(), x.m_values.size()));
 }
 
 double
 Sum(const SpectrumValue& x)
 {
-    double s = 0;
-    auto it1 = x.ConstValuesBegin();
-    while (it1 != x.ConstValuesEnd())
-    {
-        s += (*it1);
-        ++it1;
-    }
-    return s;
+    return SumKernel(x.m_values.data(), nullptr, x.m_values.size());
 }
 
 double
@@ -360,18 +438,9 @@ Prod(const SpectrumValue& x)
 double
 Integral(const SpectrumValue& arg)
 {
-    double i = 0;
-    auto vit = arg.ConstValuesBegin();
-    auto bit = arg.ConstBandsBegin();
-    while (vit != arg.ConstValuesEnd())
-    {
-        NS_ASSERT(bit != arg.ConstBandsEnd());
-        i += (*vit) * (bit->fh - bit->fl);
-        ++vit;
-        ++bit;
-    }
-    NS_ASSERT(bit == arg.ConstBandsEnd());
-    return i;
+    const std::vector<double>& widths = arg.m_spectrumModel->GetBandWidths();
+    NS_ASSERT(widths.size() == arg.m_values.size());
+    return SumKernel(arg.m_values.data(), widths.data(), arg.m_values.size());
 }
 
 Ptr<SpectrumValue>
@@ -442,9 +511,8 @@ operator+(double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator-(const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = rhs;
-    res.ChangeSign();
-    res.Add(lhs);
+    SpectrumValue res = lhs;
+    res.Subtract(rhs);
     return res;
 }
 
@@ -512,6 +580,62 @@ operator/(double lhs, const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator+(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
 SpectrumValue
 operator+(const SpectrumValue& rhs)
 {
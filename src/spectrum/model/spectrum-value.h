@@ -330,6 +330,94 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator/(double lhs, const SpectrumValue& rhs);
 
+    /**
+     * addition component-by-component, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * addition by a scalar, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * subtraction component-by-component, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * subtraction of a scalar, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * multiplication component-by-component, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * multiplication by a scalar, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * division component-by-component, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * division by a scalar, reusing the values of a temporary Left Hand Side,
+     * so that chained operations only allocate one SpectrumValue
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, double rhs);
+
     /**
      * Compare two spectrum values
      *
@@ -551,6 +639,12 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      *
      * @param arg the argument
      *
+     * The sums of Sum(), Norm() and Integral() are accumulated in the
+     * order of the bands, unless the SpectrumValueInterleavedSums global
+     * value is set, in which case they are accumulated in four interleaved
+     * partial sums, with AVX2 instructions when the build enables them, which
+     * is faster for many bands but may change the last bits of the results.
+     *
      * @return the value of the integral \f$\int_F g(f) df  \f$
      */
     friend double Integral(const SpectrumValue& arg);
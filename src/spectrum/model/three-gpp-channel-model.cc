@@ -22,18 +22,25 @@
 #include "three-gpp-channel-model.h"
 
 #include "ns3/double.h"
+#include "ns3/hash.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include <ns3/simulator.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
 #include <map>
 #include <random>
+#include <thread>
 
 namespace ns3
 {
@@ -270,8 +277,8 @@ ThreeGppChannelModel::DoDispose()
     {
         m_channelConditionModel->Dispose();
     }
-    m_channelMatrixMap.clear();
-    m_channelParamsMap.clear();
+    m_channelMatrixMap.Clear();
+    m_channelParamsMap.Clear();
     m_channelConditionModel = nullptr;
 }
 
@@ -303,10 +310,47 @@ ThreeGppChannelModel::GetTypeId()
                                               &ThreeGppChannelModel::GetChannelConditionModel),
                           MakePointerChecker<ChannelConditionModel>())
             .AddAttribute("UpdatePeriod",
-                          "Specify the channel coherence time",
+                          "Specify the channel coherence time. If the caches are bounded, the "
+                          "channels are updated at their first use in each period, counted from "
+                          "the start of the simulation",
                           TimeValue(MilliSeconds(0)),
                           MakeTimeAccessor(&ThreeGppChannelModel::m_updatePeriod),
                           MakeTimeChecker())
+            .AddAttribute("CacheSize",
+                          "The maximum number of pairs of nodes whose channel parameters, and of "
+                          "pairs of antenna arrays whose channel matrices, are cached. The least "
+                          "recently used pair is evicted to make room for a new one, and is "
+                          "generated again from the same random values. If set to 0, the caches "
+                          "are unbounded.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetCacheSize,
+                                               &ThreeGppChannelModel::GetCacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Threads",
+                          "The number of threads computing the coefficients of each channel "
+                          "matrix (0 for one per hardware thread). The channels do not depend on "
+                          "the number of threads.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_threads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheHits",
+                          "The number of channel parameters and matrices found in the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of channel parameters and matrices not found in the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheEvictions",
+                          "The number of channel parameters and matrices evicted from the caches.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetCacheEvictions),
+                          MakeUintegerChecker<uint64_t>())
             // attributes for the blockage model
             .AddAttribute("Blockage",
                           "Enable blockage model A (sec 7.6.4.1)",
@@ -1068,9 +1112,15 @@ ThreeGppChannelModel::ChannelParamsNeedsUpdate(Ptr<const ThreeGppChannelParams>
         update = true;
     }
 
-    // if the coherence time is over the channel has to be updated
-    if (!m_updatePeriod.IsZero() &&
-        Simulator::Now() - channelParams->m_generatedTime > m_updatePeriod)
+    // if the coherence time is over the channel has to be updated. With bounded
+    // caches, the generation time of evicted parameters is lost, so the
+    // channels are updated in periods counted from the start of the simulation
+    bool expired = m_cacheSize > 0
+                       ? GetUpdatePeriodIndex(channelParams->m_generatedTime) !=
+                             GetUpdatePeriodIndex(Simulator::Now())
+                       : !m_updatePeriod.IsZero() &&
+                             Simulator::Now() - channelParams->m_generatedTime > m_updatePeriod;
+    if (expired)
     {
         NS_LOG_DEBUG("Generation time " << channelParams->m_generatedTime.As(Time::NS) << " now "
                                         << Now().As(Time::NS));
@@ -1114,9 +1164,9 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     Ptr<ChannelMatrix> channelMatrix;
     Ptr<ThreeGppChannelParams> channelParams;
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    if (Ptr<ThreeGppChannelParams>* cachedParams = m_channelParamsMap.Find(channelParamsKey))
     {
-        channelParams = m_channelParamsMap[channelParamsKey];
+        channelParams = *cachedParams;
         // check if it has to be updated
         updateParams = ChannelParamsNeedsUpdate(channelParams, condition);
     }
@@ -1148,16 +1198,37 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
         // shuffle all the arrays to perform random coupling
         // Step 9: Generate the cross polarization power ratios
         // Step 10: Draw initial phases
-        channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
+        // With bounded caches, the random values are drawn from the substream
+        // of the pair of nodes, of the update period and of the channel
+        // condition, and the parameters are generated from the node with the
+        // lowest ID, so that parameters evicted from the cache are generated
+        // again from the same values
+        if (m_cacheSize > 0)
+        {
+            uint64_t substream = GetSubstream(channelParamsKey, condition);
+            m_normalRv->SetSubstream(substream);
+            m_uniformRv->SetSubstream(substream);
+            m_uniformRvShuffle->SetSubstream(substream);
+            m_uniformRvDoppler->SetSubstream(substream);
+        }
+        if (m_cacheSize == 0 ||
+            aMob->GetObject<Node>()->GetId() <= bMob->GetObject<Node>()->GetId())
+        {
+            channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
+        }
+        else
+        {
+            channelParams = GenerateChannelParameters(condition, table3gpp, bMob, aMob);
+        }
         // store or replace the channel parameters
-        m_channelParamsMap[channelParamsKey] = channelParams;
+        m_channelParamsMap.Insert(channelParamsKey, channelParams);
     }
 
-    if (m_channelMatrixMap.find(channelMatrixKey) != m_channelMatrixMap.end())
+    if (Ptr<ChannelMatrix>* cachedMatrix = m_channelMatrixMap.Find(channelMatrixKey))
     {
         // channel matrix present in the map
         NS_LOG_DEBUG("channel matrix present in the map");
-        channelMatrix = m_channelMatrixMap[channelMatrixKey];
+        channelMatrix = *cachedMatrix;
         updateMatrix = ChannelMatrixNeedsUpdate(channelParams, channelMatrix);
     }
     else
@@ -1178,12 +1249,72 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
                                                // antennas at the moment of the channel generation
 
         // store or replace the channel matrix in the channel map
-        m_channelMatrixMap[channelMatrixKey] = channelMatrix;
+        m_channelMatrixMap.Insert(channelMatrixKey, channelMatrix);
     }
 
     return channelMatrix;
 }
 
+void
+ThreeGppChannelModel::SetCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_cacheSize = size;
+    std::size_t capacity = size > 0 ? size : std::numeric_limits<std::size_t>::max();
+    m_channelMatrixMap.SetCapacity(capacity);
+    m_channelParamsMap.SetCapacity(capacity);
+}
+
+uint32_t
+ThreeGppChannelModel::GetCacheSize() const
+{
+    return m_cacheSize;
+}
+
+uint64_t
+ThreeGppChannelModel::GetCacheHits() const
+{
+    return m_channelMatrixMap.GetHits() + m_channelParamsMap.GetHits();
+}
+
+uint64_t
+ThreeGppChannelModel::GetCacheMisses() const
+{
+    return m_channelMatrixMap.GetMisses() + m_channelParamsMap.GetMisses();
+}
+
+uint64_t
+ThreeGppChannelModel::GetCacheEvictions() const
+{
+    return m_channelMatrixMap.GetEvictions() + m_channelParamsMap.GetEvictions();
+}
+
+uint64_t
+ThreeGppChannelModel::GetUpdatePeriodIndex(Time t) const
+{
+    if (m_updatePeriod.IsZero())
+    {
+        return 0;
+    }
+    return t.GetTimeStep() / m_updatePeriod.GetTimeStep();
+}
+
+uint64_t
+ThreeGppChannelModel::GetSubstream(uint64_t channelParamsKey,
+                                   Ptr<const ChannelCondition> channelCondition) const
+{
+    // map the run, the pair of nodes, the period and the condition to one of
+    // the 2^50 substreams following the ones used by the run numbers, within
+    // the stream of the random variables
+    std::array<uint64_t, 5> values{RngSeedManager::GetRun(),
+                                   channelParamsKey,
+                                   GetUpdatePeriodIndex(Simulator::Now()),
+                                   channelCondition->GetLosCondition(),
+                                   channelCondition->GetO2iCondition()};
+    uint64_t hash = Hash64(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    return (uint64_t{1} << 50) | (hash & ((uint64_t{1} << 50) - 1));
+}
+
 Ptr<const MatrixBasedChannelModel::ChannelParams>
 ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const MobilityModel> bMob) const
 {
@@ -1193,9 +1324,9 @@ ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const Mobilit
     uint64_t channelParamsKey =
         GetKey(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    if (Ptr<ThreeGppChannelParams>* cachedParams = m_channelParamsMap.Find(channelParamsKey))
     {
-        return m_channelParamsMap.find(channelParamsKey)->second;
+        return *cachedParams;
     }
     else
     {
@@ -2001,18 +2132,46 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
-    // The following for loops computes the channel coefficients
-    // Keeps track of how many sub-clusters have been added up to now
+    // The locations and polarizations of the antenna elements are read
+    // beforehand, so that the coefficients are computed from local data only
+    std::vector<Vector> uLocs(uSize);
+    std::vector<uint8_t> uPols(uSize);
+    for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+        uLocs[uIndex] = uAntenna->GetElementLocation(uIndex);
+        uPols[uIndex] = uAntenna->GetElemPol(uIndex);
+    }
+    std::vector<Vector> sLocs(sSize);
+    std::vector<uint8_t> sPols(sSize);
+    for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+        sLocs[sIndex] = sAntenna->GetElementLocation(sIndex);
+        sPols[sIndex] = sAntenna->GetElemPol(sIndex);
+    }
+
+    // The sub-clusters 2 and 3 of the two strongest clusters follow the
+    // other clusters, in the order of the strongest clusters
+    std::vector<uint16_t> subClusterIndex(channelParams->m_reducedClusterNumber);
     uint8_t numSubClustersAdded = 0;
     for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
-        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        subClusterIndex[nIndex] = channelParams->m_reducedClusterNumber + numSubClustersAdded;
+        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
         {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            numSubClustersAdded += 2;
+        }
+    }
 
-            for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+    // Compute the channel coefficients of a receive antenna element
+    auto computeCoefficients = [&](size_t uIndex) {
+        const Vector& uLoc = uLocs[uIndex];
+        for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+            const Vector& sLoc = sLocs[sIndex];
+            const Complex2DVector& rayPreComp =
+                raysPreComp.at(std::make_pair(sPols[sIndex], uPols[uIndex]));
+            for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
                 // Compute the N-2 weakest cluster, assuming 0 slant angle and a
                 // polarization slant angle configured in the array (7.5-22)
                 if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
@@ -2032,9 +2191,7 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                              cosZoD[nIndex][mIndex] * sLoc.z);
                         // NOTE Doppler is computed in the CalcBeamformingGain function and is
                         // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                           uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                          mIndex) *
+                        rays += rayPreComp(nIndex, mIndex) *
                                 std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
                                 std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
                     }
@@ -2063,9 +2220,7 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                              cosZoD[nIndex][mIndex] * sLoc.z);
 
                         std::complex<double> raySub =
-                            raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                       uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                      mIndex) *
+                            rayPreComp(nIndex, mIndex) *
                             std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
                             std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
 
@@ -2097,20 +2252,37 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     raysSub3 *=
                         sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
                     hUsn(uIndex, sIndex, nIndex) = raysSub1;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded) = raysSub2;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded + 1) =
-                        raysSub3;
+                    hUsn(uIndex, sIndex, subClusterIndex[nIndex]) = raysSub2;
+                    hUsn(uIndex, sIndex, subClusterIndex[nIndex] + 1) = raysSub3;
                 }
             }
         }
-        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+    };
+
+    // The receive antenna elements are handed out one at a time to the
+    // threads, and each thread only writes the coefficients of its elements
+    std::size_t nThreads = m_threads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    nThreads = std::min(nThreads, uSize);
+    std::atomic<std::size_t> nextUIndex(0);
+    auto work = [&nextUIndex, uSize, &computeCoefficients]() {
+        for (std::size_t uIndex = nextUIndex++; uIndex < uSize; uIndex = nextUIndex++)
         {
-            numSubClustersAdded += 2;
+            computeCoefficients(uIndex);
         }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < nThreads; i++)
+    {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads)
+    {
+        thread.join();
     }
 
     if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
@@ -26,6 +26,7 @@
 #include "ns3/angles.h"
 #include <ns3/boolean.h>
 #include <ns3/channel-condition-model.h>
+#include <ns3/lru-cache.h>
 
 #include <complex.h>
 #include <unordered_map>
@@ -42,6 +43,26 @@ class MobilityModel;
  * The class implements the channel matrix generation procedure
  * described in 3GPP TR 38.901.
  *
+ * The channel parameters of each pair of nodes and the channel matrices of
+ * each pair of antenna arrays are cached. The CacheSize attribute bounds the
+ * number of cached pairs, to limit the memory used by simulations with many
+ * moving nodes: the least recently used pair is evicted to cache a new one.
+ * With bounded caches, the channel parameters of each pair of nodes are
+ * generated at their first use in each UpdatePeriod, counted from the start
+ * of the simulation, from random values drawn from a substream of the pair
+ * of nodes, of the update period and of the channel condition. Evicted
+ * parameters are thus generated again from the same random values, and
+ * evicted channel matrices are computed again from the parameters, so that
+ * the channels do not depend on the cache size, unless the nodes moved since
+ * the evicted parameters or matrices were generated, but they differ from
+ * those generated with unbounded caches.
+ *
+ * The Threads attribute sets the number of threads computing the
+ * coefficients of each channel matrix, split by receive antenna element.
+ * The random values are all drawn beforehand in the simulation thread, and
+ * each coefficient is computed by a single thread in the same order, so the
+ * channels do not depend on the number of threads.
+ *
  * \see GetChannel
  */
 class ThreeGppChannelModel : public MatrixBasedChannelModel
@@ -137,6 +158,34 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Set the maximum number of pairs of nodes and of pairs of antenna arrays
+     * whose channel parameters and channel matrices are cached.
+     *
+     * \param size the maximum number of cached pairs, or 0 for no limit
+     */
+    void SetCacheSize(uint32_t size);
+
+    /**
+     * \return the maximum number of cached pairs, or 0 for no limit
+     */
+    uint32_t GetCacheSize() const;
+
+    /**
+     * \return the number of channel parameters and matrices found in the caches
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of channel parameters and matrices not found in the caches
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * \return the number of channel parameters and matrices evicted from the caches
+     */
+    uint64_t GetCacheEvictions() const;
+
   protected:
     /**
      * Wrap an (azimuth, inclination) angle pair in a valid range.
@@ -316,6 +365,25 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
         const DoubleVector& clusterAOA,
         const DoubleVector& clusterZOA) const;
 
+    /**
+     * Get the index of the update period of a time, counted from the start of
+     * the simulation
+     * \param t the time
+     * \return the index of the update period, or 0 if the update period is 0
+     */
+    uint64_t GetUpdatePeriodIndex(Time t) const;
+
+    /**
+     * Get the substream of the random variables from which the channel
+     * parameters of a pair of nodes are drawn in the current update period,
+     * when the caches are bounded
+     * \param channelParamsKey the key of the pair of nodes
+     * \param channelCondition the channel condition
+     * \return the substream number
+     */
+    uint64_t GetSubstream(uint64_t channelParamsKey,
+                          Ptr<const ChannelCondition> channelCondition) const;
+
     /**
      * Check if the channel params has to be updated
      * \param channelParams channel params
@@ -335,14 +403,16 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     bool ChannelMatrixNeedsUpdate(Ptr<const ThreeGppChannelParams> channelParams,
                                   Ptr<const ChannelMatrix> channelMatrix);
 
-    std::unordered_map<uint64_t, Ptr<ChannelMatrix>>
-        m_channelMatrixMap; //!< map containing the channel realizations per pair of
+    LruCache<uint64_t, Ptr<ChannelMatrix>>
+        m_channelMatrixMap; //!< cache containing the channel realizations per pair of
                             //!< PhasedAntennaArray instances, the key of this map is reciprocal
                             //!< uniquely identifies a pair of PhasedAntennaArrays
-    std::unordered_map<uint64_t, Ptr<ThreeGppChannelParams>>
-        m_channelParamsMap; //!< map containing the common channel parameters per pair of nodes, the
-                            //!< key of this map is reciprocal and uniquely identifies a pair of
-                            //!< nodes
+    mutable LruCache<uint64_t, Ptr<ThreeGppChannelParams>>
+        m_channelParamsMap; //!< cache containing the common channel parameters per pair of nodes,
+                            //!< the key of this map is reciprocal and uniquely identifies a pair
+                            //!< of nodes
+    uint32_t m_cacheSize;   //!< the maximum number of pairs in the caches
+    uint32_t m_threads;     //!< the number of threads computing the channel matrices
     Time m_updatePeriod;    //!< the channel update period
     double m_frequency;     //!< the operating frequency
     std::string m_scenario; //!< the 3GPP scenario
@@ -41,6 +41,43 @@ NS_LOG_COMPONENT_DEFINE("ThreeGppSpectrumPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED(ThreeGppSpectrumPropagationLossModel);
 
+namespace
+{
+
+/**
+ * Build the matrix applying the beamforming weights of an antenna array to
+ * the elements of each of its ports, following the sub-array partition
+ * model of ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent.
+ *
+ * \param antenna the antenna array
+ * \return the matrix of dimensions #ports x #elements, whose row p holds the
+ * weights of the elements of port p, and zeros elsewhere
+ */
+ComplexMatrixArray
+GetPortWeights(Ptr<const PhasedArrayModel> antenna)
+{
+    const PhasedArrayModel::ComplexVector& w = antenna->GetBeamformingVectorRef();
+    ComplexMatrixArray weights(antenna->GetNumPorts(), w.GetSize());
+    auto hElemsPerPort = antenna->GetHElemsPerPort();
+    for (auto portIdx = 0; portIdx < antenna->GetNumPorts(); portIdx++)
+    {
+        auto start = antenna->ArrayIndexFromPortIndex(portIdx, 0);
+        auto index = start;
+        for (size_t elemIdx = 0; elemIdx < antenna->GetNumElemsPerPort(); elemIdx++, index++)
+        {
+            weights(portIdx, index) = w[index - start];
+            if (elemIdx % hElemsPerPort == hElemsPerPort - 1)
+            {
+                // Increment by a factor to reach next column in a port
+                index += antenna->GetNumColumns() - hElemsPerPort;
+            }
+        }
+    }
+    return weights;
+}
+
+} // unnamed namespace
+
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel()
 {
     NS_LOG_FUNCTION(this);
@@ -130,26 +167,14 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
                                       << " s ports: " << sAnt->GetNumPorts()
                                       << " u ports: " << uAnt->GetNumPorts());
     NS_ASSERT_MSG((sAnt != nullptr) && (uAnt != nullptr), "Improper call to the method");
-    size_t numClusters = params->m_channel.GetNumPages();
-    // create and initialize the size of the longTerm 3D matrix
-    Ptr<MatrixBasedChannelModel::Complex3DVector> longTerm =
-        Create<MatrixBasedChannelModel::Complex3DVector>(uAnt->GetNumPorts(),
-                                                         sAnt->GetNumPorts(),
-                                                         numClusters);
     // Calculate long term uW * Husn * sW, the result is a matrix
-    // with the dimensions #uPorts, #sPorts, #cluster
-    for (auto sPortIdx = 0; sPortIdx < sAnt->GetNumPorts(); sPortIdx++)
-    {
-        for (auto uPortIdx = 0; uPortIdx < uAnt->GetNumPorts(); uPortIdx++)
-        {
-            for (size_t cIndex = 0; cIndex < numClusters; cIndex++)
-            {
-                longTerm->Elem(uPortIdx, sPortIdx, cIndex) =
-                    CalculateLongTermComponent(params, sAnt, uAnt, sPortIdx, uPortIdx, cIndex);
-            }
-        }
-    }
-    return longTerm;
+    // with the dimensions #uPorts, #sPorts, #cluster. The channel matrix of
+    // each cluster is multiplied on the left and on the right by the weights
+    // of the elements of each port, which gives the same result as
+    // CalculateLongTermComponent for all the ports and clusters at once
+    return Create<MatrixBasedChannelModel::Complex3DVector>(
+        params->m_channel.MultiplyByLeftAndRightMatrix(GetPortWeights(uAnt),
+                                                       GetPortWeights(sAnt).Transpose()));
 }
 
 std::complex<double>
@@ -365,44 +390,51 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
 
     auto directionalLongTerm = isReverse ? longTerm->Transpose() : (*longTerm);
 
-    Ptr<MatrixBasedChannelModel::Complex3DVector> chanSpct =
-        Create<MatrixBasedChannelModel::Complex3DVector>(numRxPorts, numTxPorts, (uint16_t)numRb);
+    NS_ASSERT(directionalLongTerm.GetNumRows() == numRxPorts);
+    NS_ASSERT(directionalLongTerm.GetNumCols() == numTxPorts);
 
     // If "params" (ChannelMatrix) and longTerm were computed for the reverse direction (e.g. this
     // is a DL transmission but params and longTerm were last updated during UL), then the elements
     // in longTerm start from different offsets.
 
-    auto vit = inPsd->ValuesBegin();      // psd iterator
+    // Compute the frequency response of each cluster, including the Doppler
+    // term, in each sub-band with a non-zero PSD
+    MatrixBasedChannelModel::Complex2DVector clusterResponse(numCluster, numRb);
+    auto vit = inPsd->ConstValuesBegin(); // psd iterator
     auto sbit = inPsd->ConstBandsBegin(); // band iterator
-    size_t iRb = 0;
-    // Compute the frequency-domain channel matrix
-    while (vit != inPsd->ValuesEnd())
+    for (size_t iRb = 0; iRb < numRb; iRb++, vit++, sbit++)
     {
         if ((*vit) != 0.00)
         {
             double fsb = (*sbit).fc; // center frequency of the sub-band
-            for (auto rxPortIdx = 0; rxPortIdx < numRxPorts; rxPortIdx++)
+            for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-                for (auto txPortIdx = 0; txPortIdx < numTxPorts; txPortIdx++)
-                {
-                    std::complex<double> subsbandGain(0.0, 0.0);
-
-                    for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
-                    {
-                        double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                        subsbandGain += directionalLongTerm(rxPortIdx, txPortIdx, cIndex) *
-                                        doppler[cIndex] *
-                                        std::complex<double>(cos(delay), sin(delay));
-                    }
-                    // Multiply with the square root of the input PSD so that the norm (absolute
-                    // value squared) of chanSpct will be the output PSD
-                    chanSpct->Elem(rxPortIdx, txPortIdx, iRb) = sqrt(*vit) * subsbandGain;
-                }
+                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+                clusterResponse(cIndex, iRb) =
+                    doppler[cIndex] * std::complex<double>(cos(delay), sin(delay));
             }
         }
-        vit++;
-        sbit++;
-        iRb++;
+    }
+
+    // Compute the frequency-domain channel matrix of all the sub-bands at
+    // once, as the combinations of the long term of the clusters weighted by
+    // their responses
+    Ptr<MatrixBasedChannelModel::Complex3DVector> chanSpct =
+        Create<MatrixBasedChannelModel::Complex3DVector>(
+            directionalLongTerm.CombinePages(clusterResponse));
+
+    // Multiply with the square root of the input PSD so that the norm (absolute
+    // value squared) of chanSpct will be the output PSD
+    size_t numPortPairs = numRxPorts * numTxPorts;
+    vit = inPsd->ConstValuesBegin();
+    for (size_t iRb = 0; iRb < numRb; iRb++, vit++)
+    {
+        std::complex<double>* subbandGains = chanSpct->GetPagePtr(iRb);
+        double amplitude = sqrt(*vit);
+        for (size_t i = 0; i < numPortPairs; i++)
+        {
+            subbandGains[i] *= amplitude;
+        }
     }
     return chanSpct;
 }
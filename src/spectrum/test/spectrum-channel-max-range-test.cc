@@ -0,0 +1,289 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup spectrum-tests
+ * Test of the MaxRange attribute of the MultiModelSpectrumChannel.
+ */
+
+using namespace ns3;
+
+/// A reception: time, receiver and received power
+using MaxRangeTestRx = std::tuple<Time, uint32_t, double>;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * SpectrumPhy recording the signals it receives.
+ */
+class MaxRangeTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor.
+     * \param id The identifier of the PHY.
+     * \param rxSpectrumModel The RX spectrum model of the PHY.
+     * \param receptions The receptions of all the PHYs.
+     */
+    MaxRangeTestPhy(uint32_t id,
+                    Ptr<const SpectrumModel> rxSpectrumModel,
+                    std::vector<MaxRangeTestRx>* receptions);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+  private:
+    uint32_t m_id;                              //!< Identifier of the PHY
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;              //!< Mobility model
+    std::vector<MaxRangeTestRx>* m_receptions;  //!< Receptions of all the PHYs
+};
+
+MaxRangeTestPhy::MaxRangeTestPhy(uint32_t id,
+                                 Ptr<const SpectrumModel> rxSpectrumModel,
+                                 std::vector<MaxRangeTestRx>* receptions)
+    : m_id(id),
+      m_rxSpectrumModel(rxSpectrumModel),
+      m_receptions(receptions)
+{
+}
+
+void
+MaxRangeTestPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+MaxRangeTestPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+MaxRangeTestPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+MaxRangeTestPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+MaxRangeTestPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+MaxRangeTestPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+MaxRangeTestPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+MaxRangeTestPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_receptions->emplace_back(Simulator::Now(), m_id, Integral(*params->psd));
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Check that a MultiModelSpectrumChannel with a MaxRange equal to the
+ * range of its MaxLossDb delivers the same signals as the exhaustive
+ * search of the receivers, with static, moving and unlocated receivers
+ * using two spectrum models.
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    SpectrumChannelMaxRangeTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Run a simulation.
+     * \param maxRange The MaxRange attribute of the channel.
+     * \return The receptions.
+     */
+    std::vector<MaxRangeTestRx> Run(double maxRange);
+};
+
+SpectrumChannelMaxRangeTestCase::SpectrumChannelMaxRangeTestCase()
+    : TestCase("Check the receivers culled by the MaxRange of MultiModelSpectrumChannel")
+{
+}
+
+std::vector<MaxRangeTestRx>
+SpectrumChannelMaxRangeTestCase::Run(double maxRange)
+{
+    const uint32_t nPhys = 100;
+    const uint32_t nTx = 300;
+    const double maxLossDb = 110;
+    std::vector<MaxRangeTestRx> receptions;
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+    std::vector<double> freqs;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        freqs.push_back(2400e6 + i * 1e6);
+    }
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+    freqs.clear();
+    for (uint32_t i = 0; i < 25; ++i)
+    {
+        freqs.push_back(2420.5e6 + i * 2e6);
+    }
+    Ptr<SpectrumModel> otherModel = Create<SpectrumModel>(freqs);
+
+    Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    channel->SetAttribute("MaxLossDb", DoubleValue(maxLossDb));
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+
+    std::vector<Ptr<MaxRangeTestPhy>> phys;
+    for (uint32_t i = 0; i < nPhys; ++i)
+    {
+        auto phy =
+            CreateObject<MaxRangeTestPhy>(i, i % 4 == 0 ? otherModel : model, &receptions);
+        Vector position(random->GetValue(0, 3000), random->GetValue(0, 3000), 1.5);
+        if (i % 2 == 0)
+        {
+            Ptr<ConstantVelocityMobilityModel> mobility =
+                CreateObject<ConstantVelocityMobilityModel>();
+            mobility->SetPosition(position);
+            mobility->SetVelocity(Vector(random->GetValue(-40, 40), random->GetValue(-40, 40), 0));
+            phy->SetMobility(mobility);
+        }
+        else if (i % 25 != 1)
+        {
+            Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(position);
+            phy->SetMobility(mobility);
+        }
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    for (uint32_t i = 0; i < nTx; ++i)
+    {
+        Ptr<MaxRangeTestPhy> txPhy = phys[random->GetInteger(0, nPhys - 1)];
+        if (!txPhy->GetMobility())
+        {
+            continue;
+        }
+        Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+        params->duration = MilliSeconds(1);
+        params->txPhy = txPhy;
+        params->psd = Create<SpectrumValue>(model);
+        *params->psd = 1e-3 / 100e6;
+        Simulator::Schedule(Seconds(i * 0.1), &SpectrumChannel::StartTx, channel, params);
+    }
+    // Receivers removed and added back during the simulation
+    Simulator::Schedule(Seconds(10), &SpectrumChannel::RemoveRx, channel, phys[10]);
+    Simulator::Schedule(Seconds(15), &SpectrumChannel::AddRx, channel, phys[10]);
+    Simulator::Run();
+    Simulator::Destroy();
+    return receptions;
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    // Range of the 110 dB loss of the LogDistancePropagationLossModel
+    Ptr<PropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel>();
+    double maxRange = loss->CalcMaxRange(0, -110);
+    NS_TEST_ASSERT_MSG_GT(maxRange, 100, "Unexpected range");
+    NS_TEST_ASSERT_MSG_LT(maxRange, 3000, "Unexpected range");
+
+    std::vector<MaxRangeTestRx> exhaustive = Run(0);
+    std::vector<MaxRangeTestRx> culled = Run(maxRange);
+    NS_TEST_ASSERT_MSG_GT(exhaustive.size(), 0, "No signal received");
+    NS_TEST_EXPECT_MSG_EQ(culled.size(), exhaustive.size(), "Wrong number of receptions");
+    for (std::size_t i = 0; i < std::min(culled.size(), exhaustive.size()); ++i)
+    {
+        // The positions of the moving receivers are computed at other times
+        // with the spatial index, which may change their last bits
+        auto [time, id, power] = culled[i];
+        auto [expectedTime, expectedId, expectedPower] = exhaustive[i];
+        NS_TEST_EXPECT_MSG_EQ_TOL(time,
+                                  expectedTime,
+                                  NanoSeconds(1),
+                                  "Wrong time of reception " << i);
+        NS_TEST_EXPECT_MSG_EQ(id, expectedId, "Wrong receiver of reception " << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(power,
+                                  expectedPower,
+                                  expectedPower * 1e-9,
+                                  "Wrong power of reception " << i);
+    }
+
+    // A smaller range only culls receivers
+    std::vector<MaxRangeTestRx> shorter = Run(maxRange / 2);
+    NS_TEST_EXPECT_MSG_GT(shorter.size(), 0, "No signal received");
+    NS_TEST_EXPECT_MSG_LT(shorter.size(), exhaustive.size(), "No receiver culled");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * MultiModelSpectrumChannel MaxRange test suite.
+ */
+class SpectrumChannelMaxRangeTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelMaxRangeTestSuite()
+        : TestSuite("spectrum-channel-max-range", UNIT)
+    {
+        AddTestCase(new SpectrumChannelMaxRangeTestCase, TestCase::QUICK);
+    }
+};
+
+/// Static variable for test initialization
+static SpectrumChannelMaxRangeTestSuite g_spectrumChannelMaxRangeTestSuite;
@@ -19,14 +19,18 @@
 
 #include "spectrum-test.h"
 
+#include <ns3/boolean.h>
+#include <ns3/global-value.h>
 #include <ns3/log.h>
 #include <ns3/object.h>
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/test.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 using namespace ns3;
 
@@ -93,6 +97,83 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check Sum(), Norm() and Integral() against a plain summation, for
+ * spectrum models of any size, including the sizes which are not a multiple
+ * of the number of partial sums.
+ */
+class SpectrumValueReductionTestCase : public TestCase
+{
+  public:
+    SpectrumValueReductionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpectrumValueReductionTestCase::SpectrumValueReductionTestCase()
+    : TestCase("Check the sums of the values of SpectrumValues, in order and interleaved")
+{
+}
+
+void
+SpectrumValueReductionTestCase::DoRun()
+{
+    for (std::size_t nBands : {2, 3, 4, 5, 7, 8, 9, 100, 3301})
+    {
+        std::vector<double> freqs;
+        for (std::size_t i = 0; i < nBands; i++)
+        {
+            // Bands of different widths
+            freqs.push_back(1e9 + 1e5 * i + 1e3 * (i % 7) * (i % 3));
+        }
+        Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+        SpectrumValue value(model);
+        long double sum = 0;
+        long double squares = 0;
+        long double integral = 0;
+        // The sums in the order of the bands
+        double orderedSum = 0;
+        double orderedSquares = 0;
+        double orderedIntegral = 0;
+        auto band = model->Begin();
+        for (std::size_t i = 0; i < nBands; i++, band++)
+        {
+            value[i] = std::sin(i + 1.0) * 1e-12;
+            sum += value[i];
+            squares += value[i] * value[i];
+            integral += value[i] * (band->fh - band->fl);
+            orderedSum += value[i];
+            orderedSquares += value[i] * value[i];
+            orderedIntegral += value[i] * (band->fh - band->fl);
+        }
+        NS_TEST_EXPECT_MSG_EQ(Sum(value), orderedSum, "Sum of " << nBands << " bands reordered");
+        NS_TEST_EXPECT_MSG_EQ(Norm(value),
+                              std::sqrt(orderedSquares),
+                              "Norm of " << nBands << " bands reordered");
+        NS_TEST_EXPECT_MSG_EQ(Integral(value),
+                              orderedIntegral,
+                              "Integral of " << nBands << " bands reordered");
+
+        GlobalValue::Bind("SpectrumValueInterleavedSums", BooleanValue(true));
+        NS_TEST_EXPECT_MSG_EQ_TOL(Sum(value),
+                                  static_cast<double>(sum),
+                                  1e-24 * nBands,
+                                  "Wrong sum of " << nBands << " bands");
+        NS_TEST_EXPECT_MSG_EQ_TOL(Norm(value),
+                                  std::sqrt(static_cast<double>(squares)),
+                                  1e-24 * nBands,
+                                  "Wrong norm of " << nBands << " bands");
+        NS_TEST_EXPECT_MSG_EQ_TOL(Integral(value),
+                                  static_cast<double>(integral),
+                                  1e-18 * nBands,
+                                  "Wrong integral of " << nBands << " bands");
+        GlobalValue::Bind("SpectrumValueInterleavedSums", BooleanValue(false));
+    }
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -268,6 +349,132 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     v1rs3[4] = v1[1];
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
+
+    // Chained operations, reusing the values of the temporaries
+    SpectrumValue tv3c = v1 * v2 - v5 + v3;
+    SpectrumValue tv4c = (v1 + doubleValue) / v2 * v2 - doubleValue - v2;
+    SpectrumValue tv5c = v1 * doubleValue / doubleValue * v2;
+    AddTestCase(new SpectrumValueTestCase(tv3c, v3, "tv3c = v1 * v2 - v5 + v3"), TestCase::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4c, v4, "tv4c = (v1 + d) div v2 * v2 - d - v2"),
+                TestCase::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv5c, v5, "tv5c = v1 * d div d * v2"), TestCase::QUICK);
+    AddTestCase(new SpectrumValueReductionTestCase, TestCase::QUICK);
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check the SpectrumConverter and SpectrumModel::IsOrthogonal()
+ * against a dense computation over all the pairs of bands, for sorted
+ * and unsorted spectrum models, and the conversion of several values at
+ * once against their separate conversions.
+ */
+class SpectrumConverterSparseTestCase : public TestCase
+{
+  public:
+    SpectrumConverterSparseTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpectrumConverterSparseTestCase::SpectrumConverterSparseTestCase()
+    : TestCase("Check the sparse conversion matrices against a dense computation")
+{
+}
+
+void
+SpectrumConverterSparseTestCase::DoRun()
+{
+    // Subcarriers, resource blocks, channels, a model whose bands are not
+    // sorted, and a model out of the other ones
+    std::vector<Ptr<SpectrumModel>> models;
+    std::vector<double> freqs;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        freqs.push_back(5.15e9 + 78125 * i);
+    }
+    models.push_back(Create<SpectrumModel>(freqs));
+    freqs.clear();
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        freqs.push_back(5.149e9 + 1.8e6 * i);
+    }
+    models.push_back(Create<SpectrumModel>(freqs));
+    Bands bands;
+    for (double fc : {5.18e9, 5.2e9, 5.22e9, 5.24e9})
+    {
+        bands.push_back({fc - 10e6, fc, fc + 10e6});
+    }
+    models.push_back(Create<SpectrumModel>(bands));
+    std::swap(bands[0], bands[3]);
+    std::swap(bands[1], bands[2]);
+    models.push_back(Create<SpectrumModel>(bands));
+    freqs.clear();
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        freqs.push_back(2.4e9 + 1e6 * i);
+    }
+    models.push_back(Create<SpectrumModel>(freqs));
+    NS_TEST_EXPECT_MSG_EQ(models[2]->IsSorted(), true, "Bands should be sorted");
+    NS_TEST_EXPECT_MSG_EQ(models[3]->IsSorted(), false, "Bands should not be sorted");
+
+    for (const auto& from : models)
+    {
+        for (const auto& to : models)
+        {
+            bool orthogonal = true;
+            for (auto fromIt = from->Begin(); fromIt != from->End(); ++fromIt)
+            {
+                for (auto toIt = to->Begin(); toIt != to->End(); ++toIt)
+                {
+                    orthogonal = orthogonal && std::max(fromIt->fl, toIt->fl) >=
+                                                   std::min(fromIt->fh, toIt->fh);
+                }
+            }
+            NS_TEST_EXPECT_MSG_EQ(from->IsOrthogonal(*to),
+                                  orthogonal,
+                                  "Wrong orthogonality of models " << from->GetUid() << " and "
+                                                                   << to->GetUid());
+
+            std::vector<Ptr<const SpectrumValue>> values;
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                Ptr<SpectrumValue> value = Create<SpectrumValue>(from);
+                for (size_t i = 0; i < from->GetNumBands(); i++)
+                {
+                    (*value)[i] = 1 + std::sin(i * 0.1 + j);
+                }
+                values.push_back(value);
+            }
+            SpectrumConverter converter(from, to);
+            std::vector<Ptr<SpectrumValue>> converted = converter.Convert(values);
+            NS_TEST_ASSERT_MSG_EQ(converted.size(), values.size(), "Wrong number of values");
+            for (size_t j = 0; j < values.size(); j++)
+            {
+                NS_TEST_EXPECT_MSG_EQ((*converted[j] == *converter.Convert(values[j])),
+                                      true,
+                                      "Batch conversion differs from single conversion");
+                size_t row = 0;
+                for (auto toIt = to->Begin(); toIt != to->End(); ++toIt, ++row)
+                {
+                    double expected = 0;
+                    size_t col = 0;
+                    for (auto fromIt = from->Begin(); fromIt != from->End(); ++fromIt, ++col)
+                    {
+                        double overlap = std::min(fromIt->fh, toIt->fh) -
+                                         std::max(fromIt->fl, toIt->fl);
+                        double c = std::min(1.0, std::max(0.0, overlap) / (toIt->fh - toIt->fl));
+                        expected += (*values[j])[col] * c;
+                    }
+                    NS_TEST_EXPECT_MSG_EQ_TOL((*converted[j])[row],
+                                              expected,
+                                              1e-12 * (1 + expected),
+                                              "Wrong converted value of band " << row);
+                }
+            }
+        }
+    }
 }
 
 /**
@@ -346,6 +553,8 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite()
     //   NS_LOG_LOGIC(t21b);
     //   NS_LOG_LOGIC(*res);
     AddTestCase(new SpectrumValueTestCase(t21b, *res, ""), TestCase::QUICK);
+
+    AddTestCase(new SpectrumConverterSparseTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -17,6 +17,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/angles.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
@@ -1213,6 +1214,246 @@ ThreeGppMimoPolarizationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the bounded caches of the ThreeGppChannelModel class. A base
+ * station alternately reaches two user terminals, several times per update
+ * period, through a model caching the channel parameters and the channel
+ * matrix of a single pair of nodes, which evicts those of the other pair each
+ * time. It checks that the evicted parameters are generated again from the
+ * same random values and that the evicted matrices are computed again from
+ * them, identical to those of a model whose caches hold all the pairs, and
+ * the statistics of the caches.
+ */
+class ThreeGppChannelCacheTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelCacheTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Compare the channels between a and b returned by the two models
+     * \param aMob mobility model of the a device
+     * \param bMob mobility model of the b device
+     * \param aAntenna antenna of the a device
+     * \param bAntenna antenna of the b device
+     */
+    void CompareChannels(Ptr<MobilityModel> aMob,
+                         Ptr<MobilityModel> bMob,
+                         Ptr<PhasedArrayModel> aAntenna,
+                         Ptr<PhasedArrayModel> bAntenna);
+
+    Ptr<ThreeGppChannelModel> m_bounded; //!< the model caching a single pair
+    Ptr<ThreeGppChannelModel> m_large;   //!< the model caching all the pairs
+};
+
+ThreeGppChannelCacheTest::ThreeGppChannelCacheTest()
+    : TestCase("Check the channels regenerated after their eviction from the caches")
+{
+}
+
+void
+ThreeGppChannelCacheTest::CompareChannels(Ptr<MobilityModel> aMob,
+                                          Ptr<MobilityModel> bMob,
+                                          Ptr<PhasedArrayModel> aAntenna,
+                                          Ptr<PhasedArrayModel> bAntenna)
+{
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel =
+        m_bounded->GetChannel(aMob, bMob, aAntenna, bAntenna);
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> reference =
+        m_large->GetChannel(aMob, bMob, aAntenna, bAntenna);
+    NS_TEST_EXPECT_MSG_EQ((channel->m_channel == reference->m_channel),
+                          true,
+                          "Different channel matrices at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ((channel->m_antennaPair == reference->m_antennaPair),
+                          true,
+                          "Different antenna pairs at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ((m_bounded->GetParams(aMob, bMob)->m_delay ==
+                           m_large->GetParams(aMob, bMob)->m_delay),
+                          true,
+                          "Different channel parameters at " << Simulator::Now().As(Time::MS));
+}
+
+void
+ThreeGppChannelCacheTest::DoRun()
+{
+    // create the models, drawing the same random variables
+    auto createModel = [](uint32_t cacheSize) {
+        Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+        channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+        channelModel->SetAttribute("Scenario", StringValue("UMa"));
+        channelModel->SetAttribute("ChannelConditionModel",
+                                   PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+        channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+        channelModel->SetAttribute("CacheSize", UintegerValue(cacheSize));
+        channelModel->AssignStreams(1);
+        return channelModel;
+    };
+    m_bounded = createModel(1);
+    m_large = createModel(1000);
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    Ptr<MobilityModel> bsMob = CreateObject<ConstantPositionMobilityModel>();
+    bsMob->SetPosition(Vector(0.0, 0.0, 25.0));
+    nodes.Get(0)->AggregateObject(bsMob);
+    Ptr<MobilityModel> utMobs[] = {CreateObject<ConstantPositionMobilityModel>(),
+                                   CreateObject<ConstantPositionMobilityModel>()};
+    utMobs[0]->SetPosition(Vector(80.0, 40.0, 1.5));
+    nodes.Get(1)->AggregateObject(utMobs[0]);
+    utMobs[1]->SetPosition(Vector(-60.0, 90.0, 1.5));
+    nodes.Get(2)->AggregateObject(utMobs[1]);
+    auto createAntenna = []() {
+        return CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(2),
+            "NumRows",
+            UintegerValue(2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>()));
+    };
+    Ptr<PhasedArrayModel> bsAntenna = createAntenna();
+    Ptr<PhasedArrayModel> utAntennas[] = {createAntenna(), createAntenna()};
+
+    // the user terminals are reached in turn, every 30 ms, so that the
+    // channels are evicted from the bounded caches within the update periods
+    const uint32_t numChannels = 12;
+    for (uint32_t i = 0; i < numChannels; i++)
+    {
+        Simulator::Schedule(MilliSeconds(30 * i),
+                            &ThreeGppChannelCacheTest::CompareChannels,
+                            this,
+                            bsMob,
+                            utMobs[i % 2],
+                            bsAntenna,
+                            utAntennas[i % 2]);
+    }
+    Simulator::Run();
+
+    // the channel parameters are only found by GetParams, after their
+    // generation by GetChannel, in the bounded model, while the large
+    // model finds the parameters and the matrices after the first use of
+    // each user terminal
+    NS_TEST_EXPECT_MSG_EQ(m_bounded->GetCacheHits(),
+                          numChannels,
+                          "Wrong number of hits of the bounded caches");
+    NS_TEST_EXPECT_MSG_EQ(m_bounded->GetCacheEvictions(),
+                          2 * (numChannels - 1),
+                          "Wrong number of evictions of the bounded caches");
+    NS_TEST_EXPECT_MSG_EQ(m_large->GetCacheHits(),
+                          numChannels + 2 * (numChannels - 2),
+                          "Wrong number of hits of the large caches");
+    NS_TEST_EXPECT_MSG_EQ(m_large->GetCacheEvictions(),
+                          0,
+                          "The large caches evicted channels");
+
+    m_bounded->Dispose();
+    m_large->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the threads of the ThreeGppChannelModel class. It checks that
+ * the channel matrices between dual-polarized antenna arrays, in LOS and NLOS
+ * conditions, computed by several threads are identical to those computed by
+ * a single thread.
+ */
+class ThreeGppChannelThreadsTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelThreadsTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+};
+
+ThreeGppChannelThreadsTest::ThreeGppChannelThreadsTest()
+    : TestCase("Check the channel matrices computed by several threads")
+{
+}
+
+void
+ThreeGppChannelThreadsTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> aMob = CreateObject<ConstantPositionMobilityModel>();
+    aMob->SetPosition(Vector(0.0, 0.0, 25.0));
+    nodes.Get(0)->AggregateObject(aMob);
+    Ptr<MobilityModel> bMob = CreateObject<ConstantPositionMobilityModel>();
+    bMob->SetPosition(Vector(80.0, 40.0, 1.5));
+    nodes.Get(1)->AggregateObject(bMob);
+    auto createAntenna = [](uint32_t numColumns, uint32_t numRows) {
+        return CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(numColumns),
+            "NumRows",
+            UintegerValue(numRows),
+            "IsDualPolarized",
+            BooleanValue(true),
+            "AntennaElement",
+            PointerValue(CreateObject<ThreeGppAntennaModel>()));
+    };
+    Ptr<PhasedArrayModel> aAntenna = createAntenna(4, 2);
+    Ptr<PhasedArrayModel> bAntenna = createAntenna(2, 2);
+
+    for (bool los : {true, false})
+    {
+        // create the models, drawing the same random variables
+        auto createModel = [los](uint32_t threads) {
+            Ptr<ChannelConditionModel> conditionModel;
+            if (los)
+            {
+                conditionModel = CreateObject<AlwaysLosChannelConditionModel>();
+            }
+            else
+            {
+                conditionModel = CreateObject<NeverLosChannelConditionModel>();
+            }
+            Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+            channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+            channelModel->SetAttribute("Scenario", StringValue("UMa"));
+            channelModel->SetAttribute("ChannelConditionModel", PointerValue(conditionModel));
+            channelModel->SetAttribute("Threads", UintegerValue(threads));
+            channelModel->AssignStreams(1);
+            return channelModel;
+        };
+        for (uint32_t threads : {3, 0})
+        {
+            Ptr<ThreeGppChannelModel> serial = createModel(1);
+            Ptr<ThreeGppChannelModel> parallel = createModel(threads);
+            Ptr<const MatrixBasedChannelModel::ChannelMatrix> reference =
+                serial->GetChannel(aMob, bMob, aAntenna, bAntenna);
+            Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel =
+                parallel->GetChannel(aMob, bMob, aAntenna, bAntenna);
+            NS_TEST_EXPECT_MSG_EQ((channel->m_channel == reference->m_channel),
+                                  true,
+                                  "Different channel matrices with " << threads << " threads"
+                                                                     << (los ? " in LOS" : ""));
+            serial->Dispose();
+            parallel->Dispose();
+        }
+    }
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -1244,6 +1485,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 2, 2, 2), TestCase::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 2, 2, 1), TestCase::QUICK);
     AddTestCase(new ThreeGppCalcLongTermMultiPortTest(), TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelCacheTest(), TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelThreadsTest(), TestCase::QUICK);
 
     /**
      *  The TX and RX antennas are configured face-to-face.
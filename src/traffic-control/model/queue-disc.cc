@@ -19,11 +19,13 @@
 #include "queue-disc.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
@@ -103,7 +105,10 @@ QueueDisc::Stats::Stats()
       nTotalRequeuedPackets(0),
       nTotalRequeuedBytes(0),
       nTotalMarkedPackets(0),
-      nTotalMarkedBytes(0)
+      nTotalMarkedBytes(0),
+      nTotalRuns(0),
+      nTotalSentBatches(0),
+      nMaxSentBatchPackets(0)
 {
 }
 
@@ -220,6 +225,8 @@ QueueDisc::Stats::Print(std::ostream& os) const
 
     os << std::endl
        << "Packets/Bytes sent: " << nTotalSentPackets << " / " << nTotalSentBytes << std::endl
+       << "Runs/Batches sent: " << nTotalRuns << " / " << nTotalSentBatches
+       << " (largest batch: " << nMaxSentBatchPackets << " packets)" << std::endl
        << "Packets/Bytes marked: " << nTotalMarkedPackets << " / " << nTotalMarkedBytes;
 
     itp = nMarkedPackets.begin();
@@ -257,6 +264,14 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("BulkDequeue",
+                          "Whether to dequeue packets in batches of as many bytes as the queue "
+                          "limits of the device queue allow, and send each batch to the device "
+                          "at once. Only used with devices having a single transmission queue "
+                          "with queue limits.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&QueueDisc::m_bulkDequeue),
+                          MakeBooleanChecker())
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -381,7 +396,8 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
-    m_requeued = nullptr;
+    m_requeued.clear();
+    m_batch.clear();
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
     m_childQueueDiscDbeFunctor = nullptr;
@@ -419,11 +435,15 @@ QueueDisc::GetStats()
     // the total number of sent packets is only updated here to avoid to increase it
     // after a dequeue and then having to decrease it if the packet is dropped after
     // dequeue or requeued
-    m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - (m_requeued ? 1 : 0) -
+    uint64_t requeuedBytes = 0;
+    for (const auto& item : m_requeued)
+    {
+        requeuedBytes += item->GetSize();
+    }
+    m_stats.nTotalSentPackets = m_stats.nTotalDequeuedPackets - m_requeued.size() -
                                 m_stats.nTotalDroppedPacketsAfterDequeue;
-    m_stats.nTotalSentBytes = m_stats.nTotalDequeuedBytes -
-                              (m_requeued ? m_requeued->GetSize() : 0) -
-                              m_stats.nTotalDroppedBytesAfterDequeue;
+    m_stats.nTotalSentBytes =
+        m_stats.nTotalDequeuedBytes - requeuedBytes - m_stats.nTotalDroppedBytesAfterDequeue;
 
     return m_stats;
 }
@@ -890,11 +910,12 @@ QueueDisc::Dequeue()
     // The QueueDisc::DoPeek method dequeues a packet and keeps it as a requeued
     // packet. Thus, first check whether a peeked packet exists. Otherwise, call
     // the private DoDequeue method.
-    Ptr<QueueDiscItem> item = m_requeued;
+    Ptr<QueueDiscItem> item;
 
-    if (item)
+    if (!m_requeued.empty())
     {
-        m_requeued = nullptr;
+        item = m_requeued.front();
+        m_requeued.pop_front();
         if (m_peeked)
         {
             // If the packet was requeued because a peek operation was requested
@@ -928,17 +949,19 @@ QueueDisc::DoPeek()
 {
     NS_LOG_FUNCTION(this);
 
-    if (!m_requeued)
+    if (m_requeued.empty())
     {
         m_peeked = true;
-        m_requeued = Dequeue();
+        Ptr<QueueDiscItem> item = Dequeue();
         // if no packet is returned, reset the m_peeked flag
-        if (!m_requeued)
+        if (!item)
         {
             m_peeked = false;
+            return nullptr;
         }
+        m_requeued.push_back(item);
     }
-    return m_requeued;
+    return m_requeued.front();
 }
 
 void
@@ -948,15 +971,17 @@ QueueDisc::Run()
 
     if (RunBegin())
     {
+        m_stats.nTotalRuns++;
         uint32_t quota = m_quota;
-        while (Restart())
+        uint32_t packets;
+        while (Restart(packets))
         {
-            quota -= 1;
-            if (quota <= 0)
+            if (packets >= quota)
             {
                 /// \todo netif_schedule (q);
                 break;
             }
+            quota -= packets;
         }
         RunEnd();
     }
@@ -983,16 +1008,18 @@ QueueDisc::RunEnd()
 }
 
 bool
-QueueDisc::Restart()
+QueueDisc::Restart(uint32_t& packets)
 {
     NS_LOG_FUNCTION(this);
     Ptr<QueueDiscItem> item = DequeuePacket();
     if (!item)
     {
         NS_LOG_LOGIC("No packet to send");
+        packets = 0;
         return false;
     }
 
+    packets = 1 + m_batch.size();
     return Transmit(item);
 }
 
@@ -1004,16 +1031,16 @@ QueueDisc::DequeuePacket()
     Ptr<QueueDiscItem> item;
 
     // First check if there is a requeued packet
-    if (m_requeued)
+    if (!m_requeued.empty())
     {
         // If the queue where the requeued packet is destined to is not stopped, return
         // the requeued packet; otherwise, return an empty packet.
         // If the device does not support flow control, the device queue is never stopped
         if (!m_devQueueIface ||
-            !m_devQueueIface->GetTxQueue(m_requeued->GetTxQueueIndex())->IsStopped())
+            !m_devQueueIface->GetTxQueue(m_requeued.front()->GetTxQueueIndex())->IsStopped())
         {
-            item = m_requeued;
-            m_requeued = nullptr;
+            item = m_requeued.front();
+            m_requeued.pop_front();
             if (m_peeked)
             {
                 // If the packet was requeued because a peek operation was requested
@@ -1039,18 +1066,56 @@ QueueDisc::DequeuePacket()
             if (item)
             {
                 item->AddHeader();
+                if (m_bulkDequeue)
+                {
+                    BulkDequeue(item);
+                }
             }
-            // Here, Linux tries bulk dequeues
         }
     }
     return item;
 }
 
+void
+QueueDisc::BulkDequeue(Ptr<const QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    // As in Linux, packets are only dequeued in bulk for single queue devices
+    // whose queue limits bound the bytes of the batch
+    if (!m_devQueueIface || m_devQueueIface->GetNTxQueues() != 1)
+    {
+        return;
+    }
+    Ptr<NetDeviceQueue> txq = m_devQueueIface->GetTxQueue(0);
+    Ptr<QueueLimits> queueLimits = txq->GetQueueLimits();
+    if (!queueLimits)
+    {
+        return;
+    }
+    // The packets of a batch are then notified to the queue limits together
+    txq->SetBatchedCompletions(true);
+
+    int64_t byteLimit = static_cast<int64_t>(queueLimits->Available()) - item->GetSize();
+    while (byteLimit > 0)
+    {
+        Ptr<QueueDiscItem> next = Dequeue();
+        if (!next)
+        {
+            break;
+        }
+        next->AddHeader();
+        byteLimit -= next->GetSize();
+        m_batch.push_back(next);
+    }
+    NS_LOG_LOGIC("Dequeued a batch of " << m_batch.size() + 1 << " packets");
+}
+
 void
 QueueDisc::Requeue(Ptr<QueueDiscItem> item)
 {
     NS_LOG_FUNCTION(this << item);
-    m_requeued = item;
+    m_requeued.push_back(item);
     /// \todo netif_schedule (q);
 
     m_stats.nTotalRequeuedPackets++;
@@ -1065,24 +1130,55 @@ QueueDisc::Transmit(Ptr<QueueDiscItem> item)
 {
     NS_LOG_FUNCTION(this << item);
 
+    std::size_t txq = item->GetTxQueueIndex();
+
     // if the device queue is stopped, requeue the packet and return false.
     // Note that if the underlying device is tc-unaware, packets are never
     // requeued because the queues of tc-unaware devices are never stopped
-    if (m_devQueueIface && m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->IsStopped())
+    if (m_devQueueIface && m_devQueueIface->GetTxQueue(txq)->IsStopped())
     {
         Requeue(item);
+        for (const auto& next : m_batch)
+        {
+            Requeue(next);
+        }
+        m_batch.clear();
         return false;
     }
 
     // a single queue device makes no use of the priority tag
     // a device that does not install a device queue interface likely makes no use of it as well
-    if (!m_devQueueIface || m_devQueueIface->GetNTxQueues() == 1)
+    bool removePriorityTag = !m_devQueueIface || m_devQueueIface->GetNTxQueues() == 1;
+    NS_ASSERT_MSG(m_send, "Send callback not set");
+    uint32_t sent = 0;
+    while (true)
     {
-        SocketPriorityTag priorityTag;
-        item->GetPacket()->RemovePacketTag(priorityTag);
+        if (removePriorityTag)
+        {
+            SocketPriorityTag priorityTag;
+            item->GetPacket()->RemovePacketTag(priorityTag);
+        }
+        m_send(item);
+
+        if (++sent > m_batch.size())
+        {
+            break;
+        }
+        if (m_devQueueIface->GetTxQueue(txq)->IsStopped())
+        {
+            // the device queue was stopped within the batch: requeue the remaining
+            // packets
+            for (auto next = m_batch.begin() + (sent - 1); next != m_batch.end(); ++next)
+            {
+                Requeue(*next);
+            }
+            break;
+        }
+        item = m_batch[sent - 1];
     }
-    NS_ASSERT_MSG(m_send, "Send callback not set");
-    m_send(item);
+    m_batch.clear();
+    m_stats.nTotalSentBatches++;
+    m_stats.nMaxSentBatchPackets = std::max(m_stats.nMaxSentBatchPackets, sent);
 
     // the behavior here slightly diverges from Linux. In Linux, it is advised that
     // the function called when a packet needs to be transmitted (ndo_start_xmit)
@@ -1100,9 +1196,8 @@ QueueDisc::Transmit(Ptr<QueueDiscItem> item)
 
     // if the queue disc is empty or the device queue is now stopped, return false so
     // that the Run method does not attempt to dequeue other packets and exits
-    return !(
-        GetNPackets() == 0 ||
-        (m_devQueueIface && m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->IsStopped()));
+    return !(GetNPackets() == 0 ||
+             (m_devQueueIface && m_devQueueIface->GetTxQueue(txq)->IsStopped()));
 }
 
 } // namespace ns3
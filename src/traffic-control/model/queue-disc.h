@@ -28,6 +28,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <string>
@@ -162,7 +163,7 @@ enum QueueDiscSizePolicy
  * - dropped = dropped before enqueue + dropped after dequeue
  * - received = dropped before enqueue + enqueued
  * - queued = enqueued - dequeued
- * - sent = dequeued - dropped after dequeue (- 1 if there is a requeued packet)
+ * - sent = dequeued - dropped after dequeue - requeued packets still held
  *
  * Separate counters are also kept for each possible reason to drop a packet.
  * When a packet is dropped by an internal queue, e.g., because the queue is full,
@@ -234,6 +235,12 @@ class QueueDisc : public Object
         uint32_t nTotalMarkedBytes;
         /// Marked bytes, for each reason
         std::map<std::string, uint64_t, std::less<>> nMarkedBytes;
+        /// Total runs, i.e., calls to Run while the queue disc was not running
+        uint32_t nTotalRuns;
+        /// Total batches of packets sent to the netdevice
+        uint32_t nTotalSentBatches;
+        /// Number of packets of the largest batch sent to the netdevice
+        uint32_t nMaxSentBatchPackets;
 
         /// constructor
         Stats();
@@ -421,6 +428,11 @@ class QueueDisc : public Object
      * Modelled after the Linux function __qdisc_run (net/sched/sch_generic.c)
      * Dequeues multiple packets, until a quota is exceeded or sending a packet
      * to the device failed.
+     *
+     * If the BulkDequeue attribute is set and the device has a single transmission
+     * queue with queue limits (e.g., DynamicQueueLimits), the packets are dequeued
+     * in batches of as many bytes as the queue limits allow, and each batch is
+     * sent to the device without checking the queue disc between its packets.
      */
     void Run();
 
@@ -643,17 +655,29 @@ class QueueDisc : public Object
 
     /**
      * Modelled after the Linux function qdisc_restart (net/sched/sch_generic.c)
-     * Dequeue a packet (by calling DequeuePacket) and send it to the device (by calling Transmit).
-     * \return true if a packet is successfully sent to the device.
+     * Dequeue a packet (by calling DequeuePacket), along with the other packets of
+     * its batch, if any, and send them to the device (by calling Transmit).
+     * \param [out] packets the number of packets dequeued
+     * \return true if the packets are successfully sent to the device.
      */
-    bool Restart();
+    bool Restart(uint32_t& packets);
 
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
+     * If bulk dequeue is enabled, the other packets of the batch are stored in
+     * m_batch.
      * \return the requeued packet, if any, or the packet dequeued by the queue disc, otherwise.
      */
     Ptr<QueueDiscItem> DequeuePacket();
 
+    /**
+     * Modelled after the Linux function try_bulk_dequeue_skb (net/sched/sch_generic.c)
+     * Dequeues the packets following the given one in m_batch, as long as the queue
+     * limits of the device queue allow.
+     * \param item the first packet of the batch
+     */
+    void BulkDequeue(Ptr<const QueueDiscItem> item);
+
     /**
      * Modelled after the Linux function dev_requeue_skb (net/sched/sch_generic.c)
      * Requeues a packet whose transmission failed.
@@ -663,8 +687,8 @@ class QueueDisc : public Object
 
     /**
      * Modelled after the Linux function sch_direct_xmit (net/sched/sch_generic.c)
-     * Sends a packet to the device if the device queue is not stopped, and requeues
-     * it otherwise.
+     * Sends a packet, and the other packets of its batch, if any, to the device as
+     * long as the device queue is not stopped, and requeues the remaining packets.
      * \param item the packet to transmit
      * \return true if the device queue is not stopped and the queue disc is not empty
      */
@@ -696,13 +720,17 @@ class QueueDisc : public Object
     TracedCallback<Time> m_sojourn;   //!< Sojourn time of the latest dequeued packet
     QueueSize m_maxSize;              //!< max queue size
 
-    Stats m_stats;    //!< The collected statistics
-    uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
+    Stats m_stats;      //!< The collected statistics
+    uint32_t m_quota;   //!< Maximum number of packets dequeued in a qdisc run
+    bool m_bulkDequeue; //!< Whether packets are dequeued in batches
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
-    SendCallback m_send;           //!< Callback used to send a packet to the receiving object
-    bool m_running;                //!< The queue disc is performing multiple dequeue operations
-    Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
-    bool m_peeked;                 //!< A packet was dequeued because Peek was called
+    SendCallback m_send; //!< Callback used to send a packet to the receiving object
+    bool m_running;      //!< The queue disc is performing multiple dequeue operations
+    /// The packets that failed to be transmitted, or the peeked packet
+    std::deque<Ptr<QueueDiscItem>> m_requeued;
+    /// The packets dequeued in bulk after the one being transmitted
+    std::vector<Ptr<QueueDiscItem>> m_batch;
+    bool m_peeked;                       //!< A packet was dequeued because Peek was called
     std::string m_childQueueDiscDropMsg; //!< Reason why a packet was dropped by a child queue disc
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
     QueueDiscSizePolicy m_sizePolicy;    //!< The queue disc size policy
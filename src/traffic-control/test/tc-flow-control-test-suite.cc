@@ -18,6 +18,7 @@
  *
  */
 
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
@@ -36,6 +37,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -492,6 +494,123 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Traffic Control Bulk Dequeue Test Case
+ */
+class TcBulkDequeueTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param bulkDequeue whether the queue disc dequeues packets in batches
+     */
+    TcBulkDequeueTestCase(bool bulkDequeue);
+
+  private:
+    void DoRun() override;
+    /**
+     * Record a packet received by the receiving device
+     * \param dev the receiving device
+     * \param p the packet
+     * \param protocol the protocol number
+     * \param from the sender address
+     * \param to the destination address
+     * \param type the packet type
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> dev,
+                 Ptr<const Packet> p,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType type);
+
+    bool m_bulkDequeue;               //!< whether the queue disc dequeues packets in batches
+    std::vector<uint64_t> m_received; //!< the uids of the packets received, in order
+};
+
+TcBulkDequeueTestCase::TcBulkDequeueTestCase(bool bulkDequeue)
+    : TestCase(std::string("Test the transmission of packets ") +
+               (bulkDequeue ? "dequeued in batches" : "dequeued one at a time") +
+               " with dynamic queue limits"),
+      m_bulkDequeue(bulkDequeue)
+{
+}
+
+bool
+TcBulkDequeueTestCase::Receive(Ptr<NetDevice> dev,
+                               Ptr<const Packet> p,
+                               uint16_t protocol,
+                               const Address& from,
+                               const Address& to,
+                               NetDevice::PacketType type)
+{
+    m_received.push_back(p->GetUid());
+    return true;
+}
+
+void
+TcBulkDequeueTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+    rxDevC.Get(0)->SetPromiscReceiveCallback(
+        MakeCallback(&TcBulkDequeueTestCase::Receive, this));
+
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("100p"));
+    Ptr<NetDevice> txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+
+    TrafficControlHelper tch;
+    tch.SetRootQueueDisc("ns3::FifoQueueDisc",
+                         "MaxSize",
+                         StringValue("100p"),
+                         "BulkDequeue",
+                         BooleanValue(m_bulkDequeue));
+    tch.SetQueueLimits("ns3::DynamicQueueLimits", "MinLimit", UintegerValue(4000));
+    Ptr<QueueDisc> qdisc = tch.Install(txDev).Get(0);
+
+    // The device queue is stopped by its queue limits of 4000 bytes, and the
+    // other packets accumulate in the queue disc
+    std::vector<uint64_t> sent;
+    Simulator::Schedule(Seconds(0), [&sent, txDev]() {
+        Ptr<TrafficControlLayer> tc = txDev->GetNode()->GetObject<TrafficControlLayer>();
+        for (uint32_t i = 0; i < 50; i++)
+        {
+            Ptr<Packet> p = Create<Packet>(1000);
+            sent.push_back(p->GetUid());
+            tc->Send(txDev, Create<QueueDiscTestItem>(p));
+        }
+    });
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ((m_received == sent), true, "The packets must be received in order");
+    const QueueDisc::Stats& stats = qdisc->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.nTotalSentPackets, 50, "All the packets must be sent");
+    if (m_bulkDequeue)
+    {
+        NS_TEST_EXPECT_MSG_LT(stats.nTotalSentBatches, 50, "The packets must be sent in batches");
+        NS_TEST_EXPECT_MSG_GT(stats.nMaxSentBatchPackets, 1, "The packets must be sent in batches");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(stats.nTotalSentBatches, 50, "The packets must be sent one by one");
+        NS_TEST_EXPECT_MSG_EQ(stats.nMaxSentBatchPackets, 1, "The packets must be sent one by one");
+    }
+    NS_TEST_EXPECT_MSG_LT(stats.nTotalRuns, 100, "The queue disc must not run for every packet");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup traffic-control-test
  *
@@ -516,5 +635,8 @@ static class TcFlowControlTestSuite : public TestSuite
         // TODO: Right now, this test only works for 5000B and 10 packets (it's hard coded). Should
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10), TestCase::QUICK);
+
+        AddTestCase(new TcBulkDequeueTestCase(false), TestCase::QUICK);
+        AddTestCase(new TcBulkDequeueTestCase(true), TestCase::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
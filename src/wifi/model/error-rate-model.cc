@@ -20,21 +20,392 @@
 #include "error-rate-model.h"
 
 #include "wifi-tx-vector.h"
+#include "wifi-utils.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <tuple>
 
 namespace ns3
 {
 
+NS_LOG_COMPONENT_DEFINE("ErrorRateModel");
+
 NS_OBJECT_ENSURE_REGISTERED(ErrorRateModel);
 
+static constexpr double LOOKUP_TABLE_MIN_SNR_DB = -10;     //!< lowest SNR of the tables in dB
+static constexpr double LOOKUP_TABLE_MAX_SNR_DB = 100;     //!< highest SNR of the tables in dB
+static constexpr double LOOKUP_TABLE_RANGE_STEP_DB = 1;    //!< SNR step to find the rise in dB
+static constexpr double LOOKUP_TABLE_SNR_STEP_DB = 0.1;    //!< coarsest SNR step in dB
+static constexpr uint8_t LOOKUP_TABLE_SNR_REFINEMENTS = 3; //!< number of halvings of the step
+static constexpr uint64_t LOOKUP_TABLE_MIN_NBITS = 16;     //!< smallest chunk size of the tables
+static constexpr double LOOKUP_TABLE_MIN_LOG = -700;       //!< lowest logarithm in the tables
+
+/**
+ * \ingroup wifi
+ *
+ * Tables of the logarithm of the chunk success rate of an error rate
+ * model. Each table covers the chunks of a given mode and transmission
+ * parameters, and holds one row per chunk size, on a grid of four sizes
+ * per octave. The rows and the intervals between them are built and
+ * checked on first use.
+ *
+ * A row only covers the SNRs over which the success rate rises from 0
+ * to 1, within the precision; below and above, the success rate is
+ * assumed to stay at the first and last value of the row, that is, not
+ * to decrease when the SNR increases.
+ */
+class ErrorRateModel::LookupTables : public SimpleRefCount<LookupTables>
+{
+  public:
+    /**
+     * Mode UID, PPDU field, number of RX antennas, channel width, guard
+     * interval, number of spatial streams, RU type, LDPC, and whether the
+     * mode is not the one of the payload of the TXVECTOR
+     */
+    using Key = std::
+        tuple<uint32_t, WifiPpduField, uint8_t, uint16_t, uint16_t, uint8_t, uint8_t, bool, bool>;
+
+    /// Function computing the chunk success rate of the model for a SNR and a chunk size
+    using ChunkSuccessRate = std::function<double(double, uint64_t)>;
+
+    /**
+     * Get the tables shared by the error rate models with the same identifier.
+     * The shared tables are released when the simulator is destroyed.
+     *
+     * \param id the identifier of the error rate model
+     * \param precision the precision of the tables
+     * \return the tables
+     */
+    static Ptr<LookupTables> Get(const std::string& id, double precision);
+
+    /**
+     * \param precision the precision of the tables
+     */
+    LookupTables(double precision);
+
+    /**
+     * Interpolate a chunk success rate in the tables.
+     *
+     * \param key the key of the table
+     * \param snr the SNR of the chunk
+     * \param nbits the number of bits of the chunk
+     * \param compute the function computing the chunk success rate with the model
+     * \return the chunk success rate, or nothing if it must be computed by the model
+     */
+    std::optional<double> Interpolate(const Key& key,
+                                      double snr,
+                                      uint64_t nbits,
+                                      const ChunkSuccessRate& compute);
+
+  private:
+    /// Row of a table
+    struct Row
+    {
+        bool built{false};          //!< whether the row has been built
+        double minSnrDb{0};         //!< SNR of the first value in dB
+        double step{0};             //!< SNR step in dB, 0 if the row could not be built
+        std::vector<double> values; //!< logarithm of the success rate at each SNR
+    };
+
+    /// Status of the interval between two rows
+    enum Interval : uint8_t
+    {
+        UNCHECKED,
+        VALID,
+        INVALID
+    };
+
+    /// Table of a mode and transmission parameters
+    struct Table
+    {
+        std::vector<Row> rows;           //!< the rows, indexed by chunk size
+        std::vector<Interval> intervals; //!< the intervals following each row
+    };
+
+    /**
+     * Build a row, with the coarsest SNR step within the precision.
+     *
+     * \param row the row
+     * \param nbits the chunk size of the row
+     * \param compute the function computing the chunk success rate with the model
+     */
+    void Build(Row& row, uint64_t nbits, const ChunkSuccessRate& compute) const;
+
+    /**
+     * \param row the row
+     * \param snrDb the SNR in dB
+     * \return the logarithm of the success rate interpolated in the row
+     */
+    static double Interpolate(const Row& row, double snrDb);
+
+    /// Release the shared tables
+    static void Clear();
+
+    static std::map<std::string, Ptr<LookupTables>> m_shared; //!< the shared tables, by identifier
+
+    double m_precision;               //!< precision of the success rates
+    std::vector<uint64_t> m_rowNbits; //!< chunk size of each row
+    std::map<Key, Table> m_tables;    //!< the tables
+    Key m_lastKey;                    //!< key of the last table used
+    Table* m_lastTable{nullptr};      //!< last table used
+};
+
+std::map<std::string, Ptr<ErrorRateModel::LookupTables>> ErrorRateModel::LookupTables::m_shared;
+
+Ptr<ErrorRateModel::LookupTables>
+ErrorRateModel::LookupTables::Get(const std::string& id, double precision)
+{
+    auto it = m_shared.find(id);
+    if (it == m_shared.end())
+    {
+        NS_LOG_DEBUG("New lookup tables for " << id);
+        if (m_shared.empty())
+        {
+            Simulator::ScheduleDestroy(&LookupTables::Clear);
+        }
+        it = m_shared.emplace(id, Create<LookupTables>(precision)).first;
+    }
+    return it->second;
+}
+
+void
+ErrorRateModel::LookupTables::Clear()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_shared.clear();
+}
+
+ErrorRateModel::LookupTables::LookupTables(double precision)
+    : m_precision(precision),
+      m_rowNbits{LOOKUP_TABLE_MIN_NBITS}
+{
+}
+
+void
+ErrorRateModel::LookupTables::Build(Row& row, uint64_t nbits, const ChunkSuccessRate& compute) const
+{
+    row.built = true;
+    // Find the SNRs over which the success rate rises from 0 to 1
+    const double span = LOOKUP_TABLE_MAX_SNR_DB - LOOKUP_TABLE_MIN_SNR_DB;
+    auto n = static_cast<std::size_t>(std::round(span / LOOKUP_TABLE_RANGE_STEP_DB) + 1);
+    std::size_t first = n;
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double csr = compute(DbToRatio(LOOKUP_TABLE_MIN_SNR_DB + i * LOOKUP_TABLE_RANGE_STEP_DB),
+                             nbits);
+        if (csr > m_precision / 2)
+        {
+            first = std::min(first, i);
+        }
+        if (csr < 1 - m_precision / 2)
+        {
+            last = i;
+        }
+    }
+    first = (first == n) ? n - 2 : (first > 0 ? first - 1 : 0);
+    last = std::max(std::min(last + 1, n - 1), first + 1);
+    row.minSnrDb = LOOKUP_TABLE_MIN_SNR_DB + first * LOOKUP_TABLE_RANGE_STEP_DB;
+    double range = (last - first) * LOOKUP_TABLE_RANGE_STEP_DB;
+
+    for (uint8_t refinement = 0; refinement <= LOOKUP_TABLE_SNR_REFINEMENTS; refinement++)
+    {
+        double step = LOOKUP_TABLE_SNR_STEP_DB / (1 << refinement);
+        n = static_cast<std::size_t>(std::round(range / step) + 1);
+        std::vector<double> values(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double csr = compute(DbToRatio(row.minSnrDb + i * step), nbits);
+            values[i] = std::max(std::log(csr), LOOKUP_TABLE_MIN_LOG);
+        }
+        bool valid = true;
+        for (std::size_t i = 0; valid && i + 1 < n; i++)
+        {
+            double csr = compute(DbToRatio(row.minSnrDb + (i + 0.5) * step), nbits);
+            valid = std::abs(std::exp((values[i] + values[i + 1]) / 2) - csr) <= m_precision;
+        }
+        if (valid)
+        {
+            row.step = step;
+            row.values = std::move(values);
+            return;
+        }
+    }
+    NS_LOG_DEBUG("Chunks of " << nbits << " bits cannot be interpolated");
+}
+
+double
+ErrorRateModel::LookupTables::Interpolate(const Row& row, double snrDb)
+{
+    double position = (snrDb - row.minSnrDb) / row.step;
+    if (position <= 0)
+    {
+        return row.values.front();
+    }
+    if (position >= row.values.size() - 1)
+    {
+        return row.values.back();
+    }
+    auto i = static_cast<std::size_t>(position);
+    return row.values[i] + (position - i) * (row.values[i + 1] - row.values[i]);
+}
+
+std::optional<double>
+ErrorRateModel::LookupTables::Interpolate(const Key& key,
+                                          double snr,
+                                          uint64_t nbits,
+                                          const ChunkSuccessRate& compute)
+{
+    double snrDb = RatioToDb(snr);
+    if (nbits < LOOKUP_TABLE_MIN_NBITS ||
+        !(snrDb >= LOOKUP_TABLE_MIN_SNR_DB && snrDb <= LOOKUP_TABLE_MAX_SNR_DB))
+    {
+        return std::nullopt;
+    }
+    while (m_rowNbits.back() <= nbits)
+    {
+        m_rowNbits.push_back(std::llround(LOOKUP_TABLE_MIN_NBITS *
+                                          std::exp2(m_rowNbits.size() / 4.0)));
+    }
+    // The chunk size is between the sizes of the rows k and k + 1
+    std::size_t k = std::upper_bound(m_rowNbits.cbegin(), m_rowNbits.cend(), nbits) -
+                    m_rowNbits.cbegin() - 1;
+    // Consecutive chunks usually use the same table
+    if (!m_lastTable || key != m_lastKey)
+    {
+        m_lastKey = key;
+        m_lastTable = &m_tables[key];
+    }
+    Table& table = *m_lastTable;
+    if (table.intervals.size() <= k)
+    {
+        table.intervals.resize(k + 1, UNCHECKED);
+        table.rows.resize(k + 2);
+    }
+    if (table.intervals[k] == INVALID)
+    {
+        return std::nullopt;
+    }
+    Row& low = table.rows[k];
+    Row& high = table.rows[k + 1];
+    double lowNbits = m_rowNbits[k];
+    double highNbits = m_rowNbits[k + 1];
+    if (table.intervals[k] == UNCHECKED)
+    {
+        for (auto [row, rowNbits] : {std::pair{&low, lowNbits}, std::pair{&high, highNbits}})
+        {
+            if (!row->built)
+            {
+                Build(*row, rowNbits, compute);
+            }
+        }
+        // Check the interpolation between the rows, in the middle of the
+        // interval, at the SNRs of both rows
+        bool valid = (low.step > 0 && high.step > 0);
+        auto middle = static_cast<uint64_t>((lowNbits + highNbits) / 2);
+        double t = (middle - lowNbits) / (highNbits - lowNbits);
+        for (const Row* row : {&low, &high})
+        {
+            for (std::size_t i = 0; valid && i < row->values.size(); i++)
+            {
+                double snrDb = row->minSnrDb + i * row->step;
+                double lowValue = Interpolate(low, snrDb);
+                double value = lowValue + t * (Interpolate(high, snrDb) - lowValue);
+                double csr = compute(DbToRatio(snrDb), middle);
+                valid = std::abs(std::exp(value) - csr) <= m_precision;
+            }
+        }
+        table.intervals[k] = valid ? VALID : INVALID;
+        if (!valid)
+        {
+            NS_LOG_DEBUG("Chunks of " << lowNbits << " to " << highNbits
+                                      << " bits cannot be interpolated");
+            return std::nullopt;
+        }
+    }
+    double lowValue = Interpolate(low, snrDb);
+    double t = (nbits - lowNbits) / (highNbits - lowNbits);
+    return std::exp(lowValue + t * (Interpolate(high, snrDb) - lowValue));
+}
+
 TypeId
 ErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::ErrorRateModel").SetParent<Object>().SetGroupName("Wifi");
+    static TypeId tid =
+        TypeId("ns3::ErrorRateModel")
+            .SetParent<Object>()
+            .SetGroupName("Wifi")
+            .AddAttribute("UseLookupTables",
+                          "Whether the chunk success rates are interpolated in lookup tables "
+                          "built on first use, instead of being computed for each chunk",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker())
+            .AddAttribute("LookupTablePrecision",
+                          "The largest error on the chunk success rates interpolated in the "
+                          "lookup tables, checked at the middle of the steps of the tables",
+                          DoubleValue(1e-4),
+                          MakeDoubleAccessor(&ErrorRateModel::m_lookupTablePrecision),
+                          MakeDoubleChecker<double>(0, 1));
     return tid;
 }
 
+ErrorRateModel::ErrorRateModel()
+    : m_useLookupTables(false),
+      m_lookupTablePrecision(1e-4)
+{
+}
+
+ErrorRateModel::~ErrorRateModel()
+{
+    m_lookupTables = nullptr;
+}
+
+std::string
+ErrorRateModel::GetLookupTablesId() const
+{
+    std::ostringstream id;
+    TypeId instanceTid = GetInstanceTypeId();
+    id << instanceTid.GetName();
+    for (TypeId tid = instanceTid; tid != Object::GetTypeId(); tid = tid.GetParent())
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            Ptr<AttributeValue> value = info.checker->Create();
+            GetAttribute(info.name, *value);
+            id << " " << info.name << "=";
+            // Recurse into the error rate models used by this one
+            const auto pointer = DynamicCast<PointerValue>(value);
+            const auto model = pointer ? pointer->Get<ErrorRateModel>() : nullptr;
+            if (model)
+            {
+                id << "{" << model->GetLookupTablesId() << "}";
+            }
+            else
+            {
+                id << value->SerializeToString(info.checker);
+            }
+        }
+    }
+    return id.str();
+}
+
 double
 ErrorRateModel::CalculateSnr(const WifiTxVector& txVector, double ber) const
 {
@@ -69,6 +440,52 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
                                     uint8_t numRxAntennas,
                                     WifiPpduField field,
                                     uint16_t staId) const
+{
+    if (m_useLookupTables && txVector.GetModeInitialized())
+    {
+        if (!m_lookupTables)
+        {
+            m_lookupTables = LookupTables::Get(GetLookupTablesId(), m_lookupTablePrecision);
+        }
+        bool isHeaderMode =
+            (txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId));
+        uint8_t ruType = (txVector.IsMu() && !isHeaderMode)
+                             ? static_cast<uint8_t>(txVector.GetRu(staId).GetRuType())
+                             : 0;
+        LookupTables::Key key{mode.GetUid(),
+                              field,
+                              numRxAntennas,
+                              txVector.GetChannelWidth(),
+                              txVector.GetGuardInterval(),
+                              isHeaderMode ? 0 : txVector.GetNss(staId),
+                              ruType,
+                              txVector.IsLdpc(),
+                              isHeaderMode};
+        auto compute = [&](double chunkSnr, uint64_t chunkNbits) {
+            return ComputeChunkSuccessRate(mode,
+                                           txVector,
+                                           chunkSnr,
+                                           chunkNbits,
+                                           numRxAntennas,
+                                           field,
+                                           staId);
+        };
+        if (auto csr = m_lookupTables->Interpolate(key, snr, nbits, compute); csr.has_value())
+        {
+            return *csr;
+        }
+    }
+    return ComputeChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+}
+
+double
+ErrorRateModel::ComputeChunkSuccessRate(WifiMode mode,
+                                        const WifiTxVector& txVector,
+                                        double snr,
+                                        uint64_t nbits,
+                                        uint8_t numRxAntennas,
+                                        WifiPpduField field,
+                                        uint16_t staId) const
 {
     if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
         mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
@@ -31,6 +31,24 @@ namespace ns3
  * \ingroup wifi
  * \brief the interface for Wifi's error models
  *
+ * When the UseLookupTables attribute is set, the chunk success rates are
+ * interpolated in tables of the success rate of each mode over a grid of
+ * SNRs and chunk sizes, instead of being computed for each chunk. The
+ * tables are built on first use, and shared by the error rate models of
+ * the same type with the same attribute values, so the attributes of a
+ * model should not be changed once it has been used. The shared tables are
+ * released when the simulator is destroyed. Each row of a table, for a
+ * given chunk size, uses the coarsest SNR step whose interpolation error is
+ * below the LookupTablePrecision attribute at the middle of the steps; the
+ * interpolation between two chunk sizes is checked in the same way. The
+ * chunk success rates that cannot be interpolated within this precision,
+ * and those out of the grid, are computed by the model.
+ *
+ * The tables are indexed by the mode, the PPDU field, the number of RX
+ * antennas, and the channel width, guard interval, number of spatial
+ * streams and LDPC coding of the TXVECTOR, which are the parameters used
+ * by the wifi error rate models. An error rate model using other
+ * parameters, or random variables, must not use the lookup tables.
  */
 class ErrorRateModel : public Object
 {
@@ -41,6 +59,9 @@ class ErrorRateModel : public Object
      */
     static TypeId GetTypeId();
 
+    ErrorRateModel();
+    ~ErrorRateModel() override;
+
     /**
      * \param txVector a specific transmission vector including WifiMode
      * \param ber a target BER
@@ -103,6 +124,35 @@ class ErrorRateModel : public Object
     virtual int64_t AssignStreams(int64_t stream);
 
   private:
+    class LookupTables;
+
+    /**
+     * Compute the chunk success rate with the model.
+     *
+     * \param mode the Wi-Fi mode applicable to this chunk
+     * \param txVector TXVECTOR of the overall transmission
+     * \param snr the SNR of the chunk
+     * \param nbits the number of bits in this chunk
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunk belongs to
+     * \param staId the station ID for MU
+     *
+     * \return probability of successfully receiving the chunk
+     */
+    double ComputeChunkSuccessRate(WifiMode mode,
+                                   const WifiTxVector& txVector,
+                                   double snr,
+                                   uint64_t nbits,
+                                   uint8_t numRxAntennas,
+                                   WifiPpduField field,
+                                   uint16_t staId) const;
+
+    /**
+     * \return a description of the type and attribute values of this model,
+     *         identifying the models that can share their lookup tables
+     */
+    std::string GetLookupTablesId() const;
+
     /**
      * A pure virtual method that must be implemented in the subclass.
      *
@@ -123,6 +173,10 @@ class ErrorRateModel : public Object
                                          uint8_t numRxAntennas,
                                          WifiPpduField field,
                                          uint16_t staId) const = 0;
+
+    bool m_useLookupTables;                   //!< whether to use the lookup tables
+    double m_lookupTablePrecision;            //!< precision of the lookup tables
+    mutable Ptr<LookupTables> m_lookupTables; //!< lookup tables, shared with similar models
 };
 
 } // namespace ns3
@@ -199,7 +199,7 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
+    for (auto& it : m_niChanges)
     {
         it.second.clear();
     }
@@ -360,7 +360,7 @@ InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartHePortionRxing)
         {
             m_firstPowers.find(band)->second = previousPowerStart;
             // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            niIt->second.erase(std::next(niIt->second.begin()), std::next(previousPowerPosition));
         }
         else if (isStartHePortionRxing)
         {
@@ -371,8 +371,10 @@ InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartHePortionRxing)
         }
         auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        // Inserting the last change invalidates the iterator to the first one
+        const auto firstIndex = std::distance(niIt->second.begin(), first);
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + firstIndex; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -432,7 +434,7 @@ InterferenceHelper::CalculateSnr(double signal,
 
 double
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChangesRange& nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
@@ -441,40 +443,55 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     double noiseInterferenceW = firstPower_it->second;
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
-    auto it = niIt->second.find(event->GetStartTime());
-    double muMimoPowerW = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
-                              ? CalculateMuMimoPowerW(event, band)
-                              : 0.0;
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    const auto& niChanges = niIt->second;
+    auto byTime = [](const NiChanges::value_type& niChange, const Time& moment) {
+        return niChange.first < moment;
+    };
+    auto start =
+        std::lower_bound(niChanges.cbegin(), niChanges.cend(), event->GetStartTime(), byTime);
+    auto now = std::lower_bound(start, niChanges.cend(), Simulator::Now(), byTime);
+    if (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
     {
-        if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
-            (event != it->second.GetEvent()))
+        double muMimoPowerW = CalculateMuMimoPowerW(event, band);
+        for (auto it = start; it != now; ++it)
         {
-            // Do not calculate noiseInterferenceW if events belong to the same MU-MIMO transmission
-            // unless this is the same event
-            continue;
+            if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
+                (event != it->second.GetEvent()))
+            {
+                // Do not calculate noiseInterferenceW if events belong to the same MU-MIMO
+                // transmission unless this is the same event
+                continue;
+            }
+            noiseInterferenceW = it->second.GetPower() - event->GetRxPowerW(band) - muMimoPowerW;
+            if (std::abs(noiseInterferenceW) < std::numeric_limits<double>::epsilon())
+            {
+                // fix some possible rounding issues with double values
+                noiseInterferenceW = 0.0;
+            }
         }
-        noiseInterferenceW = it->second.GetPower() - event->GetRxPowerW(band) - muMimoPowerW;
+    }
+    else if (now != start)
+    {
+        // The noise and interference is given by the last change before now
+        noiseInterferenceW = std::prev(now)->second.GetPower() - event->GetRxPowerW(band);
         if (std::abs(noiseInterferenceW) < std::numeric_limits<double>::epsilon())
         {
             // fix some possible rounding issues with double values
             noiseInterferenceW = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    for (; start != niChanges.cend() && start->second.GetEvent() != event; ++start)
     {
         ;
     }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    NS_ABORT_IF(start == niChanges.cend());
+    auto end = std::lower_bound(std::next(start), niChanges.cend(), event->GetEndTime(), byTime);
+    for (; end != niChanges.cend() && end->second.GetEvent() != event; ++end)
     {
-        ni.insert(*it);
+        ;
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
+    NS_ABORT_IF(end == niChanges.cend());
+    nis = {start, std::next(end)};
     NS_ASSERT_MSG(noiseInterferenceW >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
     return noiseInterferenceW;
@@ -563,15 +580,14 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         uint16_t channelWidth,
-                                        NiChangesPerBand* nis,
+                                        const NiChangesRange& nis,
                                         const WifiSpectrumBandInfo& band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
+    auto j = nis.first;
     Time previous = j->first;
     double muMimoPowerW = 0.0;
     WifiMode payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
@@ -592,7 +608,7 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_ABORT_IF(m_firstPowers.count(band) == 0);
     double noiseInterferenceW = m_firstPowers.at(band);
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.cend())
+    while (++j != nis.second)
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -645,15 +661,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Ptr<const Event> event,
-    NiChangesPerBand* nis,
+    const NiChangesRange& nis,
     uint16_t channelWidth,
     const WifiSpectrumBandInfo& band,
     PhyEntity::PhyHeaderSections phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.first;
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection = Seconds(0);
@@ -666,7 +681,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
     NS_ABORT_IF(m_firstPowers.count(band) == 0);
     double noiseInterferenceW = m_firstPowers.at(band);
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.end())
+    while (++j != nis.second)
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -708,19 +723,18 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          const NiChangesRange& nis,
                                           uint16_t channelWidth,
                                           const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyEntity::PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), nis.first->first))
     {
         if (section.first == header)
         {
@@ -745,7 +759,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band),
                               noiseInterferenceW,
@@ -755,7 +769,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    double per = CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -766,7 +780,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, nss);
     return snr;
@@ -779,14 +793,14 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    double per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -794,7 +808,12 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](const Time& moment, const NiChanges::value_type& niChange) {
+                                return moment < niChange.first;
+                            });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -810,7 +829,7 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
+    return niIt->second.emplace(GetNextPosition(moment, niIt), moment, change);
 }
 
 void
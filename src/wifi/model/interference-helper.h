@@ -386,9 +386,18 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * NiChanges of a band, sorted by time. The changes occurring at the same
+     * time are kept in their order of insertion. The power of each change
+     * is the total power received from that time on, so that the noise and
+     * interference at a given time is found by a binary search.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
+
+    /**
+     * Range of the NiChanges of a band covering an event: from the change at
+     * the start of the event to the one following the change at its end
+     */
+    using NiChangesRange = std::pair<NiChanges::const_iterator, NiChanges::const_iterator>;
 
     /**
      * Map of NiChanges per band
@@ -431,13 +440,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power in W.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band during the event
      * \param band the band
      *
      * \return noise and interference power
      */
     double CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
+                                       NiChangesRange& nis,
                                        const WifiSpectrumBandInfo& band) const;
 
     /**
@@ -459,7 +468,7 @@ class InterferenceHelper : public Object
      *
      * \param event the event
      * \param channelWidth the channel width used to transmit the PSDU (in MHz)
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band during the event
      * \param band identify the band used by the PSDU
      * \param staId the station ID of the PSDU (only used for MU)
      * \param window time window (pair of start and end times) of PHY payload to focus on
@@ -468,7 +477,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                uint16_t channelWidth,
-                               NiChangesPerBand* nis,
+                               const NiChangesRange& nis,
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -477,7 +486,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band during the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param header the PHY header to consider
@@ -485,7 +494,7 @@ class InterferenceHelper : public Object
      * \return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 const NiChangesRange& nis,
                                  uint16_t channelWidth,
                                  const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
@@ -493,7 +502,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band during the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
@@ -501,7 +510,7 @@ class InterferenceHelper : public Object
      * \return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        const NiChangesRange& nis,
                                         uint16_t channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
@@ -25,6 +25,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -33,6 +34,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -57,11 +60,20 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "If greater than zero, the maximum distance, in meters, between a "
+                          "sender and the PHYs to which its PPDUs are delivered. The other PHYs "
+                          "are found through a spatial index, without computing the propagation "
+                          "loss to them.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -72,6 +84,19 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_index)
+    {
+        m_index->Dispose();
+        m_index = nullptr;
+    }
+    m_unlocatedPhys.clear();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -92,42 +117,96 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    PhyList physInRange;
+    if (m_maxRange > 0)
     {
-        if (sender != (*i))
+        physInRange = GetPhysInRange(senderMobility);
+    }
+    const PhyList& phys = (m_maxRange > 0) ? physInRange : m_phyList;
+
+    // The Rx powers of all the receivers are computed at once
+    PhyList receivers;
+    std::vector<Ptr<MobilityModel>> receiverMobilities;
+    for (const auto& phy : phys)
+    {
+        // For now don't account for inter channel interference nor channel bonding
+        if (sender != phy && phy->GetChannelNumber() == sender->GetChannelNumber())
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
+            receivers.push_back(phy);
+            receiverMobilities.push_back(phy->GetMobility()->GetObject<MobilityModel>());
+        }
+    }
+    std::vector<double> rxPowersDbm(receivers.size());
+    if (!receivers.empty())
+    {
+        m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobilities, rxPowersDbm);
+    }
 
-            Ptr<MobilityModel> receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            Ptr<NetDevice> dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
+    for (std::size_t i = 0; i < receivers.size(); i++)
+    {
+        Ptr<MobilityModel> receiverMobility = receiverMobilities[i];
+        Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        double rxPowerDbm = rxPowersDbm[i];
+        NS_LOG_DEBUG("propagation: txPower="
+                     << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
+                     << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                     << "m, delay=" << delay);
+        Ptr<NetDevice> dstNetDevice = receivers[i]->GetDevice();
+        uint32_t dstNode;
+        if (!dstNetDevice)
+        {
+            dstNode = 0xffffffff;
+        }
+        else
+        {
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &YansWifiChannel::Receive,
+                                       receivers[i],
+                                       ppdu,
+                                       rxPowerDbm);
+    }
+}
+
+YansWifiChannel::PhyList
+YansWifiChannel::GetPhysInRange(Ptr<MobilityModel> senderMobility) const
+{
+    NS_LOG_FUNCTION(this << senderMobility);
+    if (!m_index)
+    {
+        m_index = CreateObject<SpatialIndex>();
+        m_index->SetAttribute("CellSize", DoubleValue(m_maxRange));
+        m_unlocatedPhys.clear();
+        for (uint32_t i = 0; i < m_phyList.size(); ++i)
+        {
+            if (Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility())
             {
-                dstNode = 0xffffffff;
+                m_index->Add(i, mobility);
             }
             else
             {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                m_unlocatedPhys.push_back(i);
             }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPowerDbm);
         }
     }
+
+    std::vector<uint32_t> indices =
+        m_index->GetItemsWithin(senderMobility->GetPosition(), m_maxRange);
+    if (!m_unlocatedPhys.empty())
+    {
+        indices.insert(indices.end(), m_unlocatedPhys.begin(), m_unlocatedPhys.end());
+        std::sort(indices.begin(), indices.end());
+    }
+    PhyList phys;
+    phys.reserve(indices.size());
+    for (auto i : indices)
+    {
+        phys.push_back(m_phyList[i]);
+    }
+    return phys;
 }
 
 void
@@ -166,6 +245,12 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    // the spatial index of the PHYs is rebuilt on the next transmission
+    if (m_index)
+    {
+        m_index->Dispose();
+        m_index = nullptr;
+    }
 }
 
 int64_t
@@ -21,6 +21,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/spatial-index.h"
 
 namespace ns3
 {
@@ -41,6 +42,12 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * If the MaxRange attribute is set, the PHYs are kept in a SpatialIndex,
+ * and a PPDU is only delivered to the PHYs within that distance of the
+ * sender, without computing the propagation loss to the other PHYs. The
+ * index is built on the first transmission after a PHY is added, so the
+ * PHYs must have their mobility model by then.
  */
 class YansWifiChannel : public Channel
 {
@@ -96,6 +103,9 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
@@ -113,9 +123,22 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
+    /**
+     * Get the PHYs within MaxRange of a sender, and the PHYs without a
+     * mobility model, building the spatial index of the PHYs if needed.
+     *
+     * \param senderMobility the mobility model of the sender
+     * \return the PHYs, in the order of the PHY list
+     */
+    PhyList GetPhysInRange(Ptr<MobilityModel> senderMobility) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Max distance of the receivers, 0 for no limit
+    mutable Ptr<SpatialIndex> m_index;  //!< Spatial index of the PHYs, if built
+    /// Indices in the PHY list of the PHYs without a mobility model
+    mutable std::vector<uint32_t> m_unlocatedPhys;
 };
 
 } // namespace ns3
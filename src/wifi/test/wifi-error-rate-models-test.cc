@@ -25,11 +25,17 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/dsss-phy.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1038,6 +1044,97 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the chunk success rates interpolated in the lookup tables of
+ * the error rate models against the rates computed by the models, over a
+ * sweep of the SNRs for some chunk sizes, and over a dense random sample of
+ * SNRs and chunk sizes
+ */
+class ErrorRateLookupTablesTestCase : public TestCase
+{
+  public:
+    ErrorRateLookupTablesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ErrorRateLookupTablesTestCase::ErrorRateLookupTablesTestCase()
+    : TestCase("Check the lookup tables of the error rate models")
+{
+}
+
+void
+ErrorRateLookupTablesTestCase::DoRun()
+{
+    const double precision = 1e-4;
+    for (const auto& typeId :
+         {"ns3::NistErrorRateModel", "ns3::YansErrorRateModel", "ns3::TableBasedErrorRateModel"})
+    {
+        ObjectFactory factory(typeId);
+        Ptr<ErrorRateModel> model = factory.Create<ErrorRateModel>();
+        factory.Set("UseLookupTables", BooleanValue(true));
+        factory.Set("LookupTablePrecision", DoubleValue(precision));
+        Ptr<ErrorRateModel> tables = factory.Create<ErrorRateModel>();
+
+        for (const auto& [mode, channelWidth] : {std::pair{DsssPhy::GetDsssRate11Mbps(), 22},
+                                                 std::pair{OfdmPhy::GetOfdmRate6Mbps(), 20},
+                                                 std::pair{OfdmPhy::GetOfdmRate54Mbps(), 20},
+                                                 std::pair{HtPhy::GetHtMcs7(), 40},
+                                                 std::pair{VhtPhy::GetVhtMcs8(), 80},
+                                                 std::pair{HePhy::GetHeMcs11(), 160}})
+        {
+            WifiTxVector txVector;
+            txVector.SetMode(mode);
+            txVector.SetChannelWidth(channelWidth);
+            for (uint64_t nbits : {8, 16, 1000, 3200, 100000})
+            {
+                double maxError = 0;
+                for (double snr = -12; snr <= 72; snr += 0.137)
+                {
+                    double expected =
+                        model->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                    double csr = tables->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                    maxError = std::max(maxError, std::abs(csr - expected));
+                }
+                // The precision is checked at the middle of the steps of the tables
+                NS_TEST_EXPECT_MSG_LT_OR_EQ(maxError,
+                                            2 * precision,
+                                            typeId << " " << mode << " " << nbits << " bits");
+            }
+
+            // Random SNRs and chunk sizes, between the steps of the tables
+            // and between the chunk sizes of their rows
+            Ptr<UniformRandomVariable> snrVar = CreateObject<UniformRandomVariable>();
+            snrVar->SetAttribute("Min", DoubleValue(-12));
+            snrVar->SetAttribute("Max", DoubleValue(72));
+            snrVar->SetStream(1);
+            Ptr<UniformRandomVariable> log2NbitsVar = CreateObject<UniformRandomVariable>();
+            log2NbitsVar->SetAttribute("Min", DoubleValue(3));
+            log2NbitsVar->SetAttribute("Max", DoubleValue(17));
+            log2NbitsVar->SetStream(2);
+            double maxError = 0;
+            for (std::size_t i = 0; i < 2000; i++)
+            {
+                double snr = snrVar->GetValue();
+                auto nbits = static_cast<uint64_t>(std::exp2(log2NbitsVar->GetValue()));
+                double expected = model->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                double csr = tables->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), nbits);
+                maxError = std::max(maxError, std::abs(csr - expected));
+            }
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(maxError,
+                                        2 * precision,
+                                        typeId << " " << mode << " random chunks");
+        }
+    }
+
+    // Release the lookup tables
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1105,6 +1202,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
                                                 HePhy::GetHeMcs11(),
                                                 1458),
                 TestCase::QUICK);
+    AddTestCase(new ErrorRateLookupTablesTestCase, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
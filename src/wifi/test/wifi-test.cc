@@ -24,6 +24,7 @@
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/frame-exchange-manager.h"
@@ -3532,6 +3533,193 @@ IdealRateManagerMimoTest::DoRun()
     Simulator::Destroy();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a YansWifiChannel with a MaxRange equal to the range of
+ * a RangePropagationLossModel starts the reception of the same PPDUs as the
+ * exhaustive search of the receivers, with static and moving nodes.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+  public:
+    YansWifiChannelMaxRangeTest();
+
+  private:
+    void DoRun() override;
+
+    /// A reception: time and receiving node
+    using Rx = std::pair<Time, uint32_t>;
+
+    /**
+     * Run a simulation.
+     * \param maxRange the MaxRange attribute of the channel
+     * \return the receptions
+     */
+    std::vector<Rx> Run(double maxRange);
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest()
+    : TestCase("Check the PHYs culled by the MaxRange of YansWifiChannel")
+{
+}
+
+std::vector<YansWifiChannelMaxRangeTest::Rx>
+YansWifiChannelMaxRangeTest::Run(double maxRange)
+{
+    const double range = 100;
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes(30);
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(60),
+                                  "DeltaY",
+                                  DoubleValue(60),
+                                  "GridWidth",
+                                  UintegerValue(6));
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); i += 2)
+    {
+        nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(
+            Vector(i % 4 == 0 ? 20 : -20, 10, 0));
+    }
+
+    YansWifiChannelHelper channelHelper;
+    channelHelper.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    channelHelper.AddPropagationLoss("ns3::LogDistancePropagationLossModel");
+    channelHelper.AddPropagationLoss("ns3::RangePropagationLossModel",
+                                     "MaxRange",
+                                     DoubleValue(range));
+    Ptr<YansWifiChannel> channel = channelHelper.Create();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    std::vector<Rx> receptions;
+    for (uint32_t i = 0; i < devices.GetN(); ++i)
+    {
+        auto device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        device->GetPhy()->TraceConnectWithoutContext(
+            "PhyRxBegin",
+            MakeBoundCallback(
+                +[](std::vector<Rx>* receptions,
+                    uint32_t node,
+                    Ptr<const Packet> packet,
+                    RxPowerWattPerChannelBand rxPowersW) {
+                    receptions->emplace_back(Simulator::Now(), node);
+                },
+                &receptions,
+                i));
+        for (uint32_t j = 0; j < 10; ++j)
+        {
+            Simulator::Schedule(MilliSeconds(100 * j + 3 * i),
+                                &WifiNetDevice::Send,
+                                device,
+                                Create<Packet>(500),
+                                device->GetBroadcast(),
+                                1);
+        }
+    }
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+    Simulator::Destroy();
+    return receptions;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    std::vector<Rx> exhaustive = Run(0);
+    std::vector<Rx> culled = Run(100);
+    NS_TEST_ASSERT_MSG_GT(exhaustive.size(), 0, "No PPDU received");
+    NS_TEST_ASSERT_MSG_EQ(culled.size(), exhaustive.size(), "Wrong number of receptions");
+    for (std::size_t i = 0; i < culled.size(); ++i)
+    {
+        // The positions of the moving nodes are computed at other times
+        // with the spatial index, which may change their last bits
+        NS_TEST_EXPECT_MSG_EQ_TOL(culled[i].first,
+                                  exhaustive[i].first,
+                                  NanoSeconds(1),
+                                  "Wrong time of reception " << i);
+        NS_TEST_EXPECT_MSG_EQ(culled[i].second,
+                              exhaustive[i].second,
+                              "Wrong receiver of reception " << i);
+    }
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a PHY can transmit on a YansWifiChannel without any other
+ * PHY and without propagation loss model, as the propagation loss model is
+ * only needed to compute the Rx power of the receivers.
+ */
+class YansWifiChannelSinglePhyTest : public TestCase
+{
+  public:
+    YansWifiChannelSinglePhyTest();
+
+  private:
+    void DoRun() override;
+};
+
+YansWifiChannelSinglePhyTest::YansWifiChannelSinglePhyTest()
+    : TestCase("Check the transmission of a single PHY on a YansWifiChannel without loss model")
+{
+}
+
+void
+YansWifiChannelSinglePhyTest::DoRun()
+{
+    NodeContainer nodes(1);
+    MobilityHelper mobility;
+    mobility.Install(nodes);
+
+    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel>();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    uint32_t numTx = 0;
+    auto device = DynamicCast<WifiNetDevice>(devices.Get(0));
+    device->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxBegin",
+        MakeBoundCallback(
+            +[](uint32_t* numTx, Ptr<const Packet> packet, double txPowerW) { ++(*numTx); },
+            &numTx));
+    Simulator::Schedule(Seconds(1),
+                        &WifiNetDevice::Send,
+                        device,
+                        Create<Packet>(500),
+                        device->GetBroadcast(),
+                        1);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(numTx, 1, "The PPDU was not transmitted");
+}
+
 //-----------------------------------------------------------------------------
 /**
  * \ingroup wifi-test
@@ -3809,6 +3997,8 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new Issue169TestCase, TestCase::QUICK);           // Issue #169
     AddTestCase(new IdealRateManagerChannelWidthTest, TestCase::QUICK);
     AddTestCase(new IdealRateManagerMimoTest, TestCase::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest, TestCase::QUICK);
+    AddTestCase(new YansWifiChannelSinglePhyTest, TestCase::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::QUICK);
 }
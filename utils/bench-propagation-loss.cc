@@ -0,0 +1,208 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Benchmark of chains of propagation loss models, with and without the
+ * CachedPropagationLossModel.
+ *
+ * The nodes of a static mesh, placed on a grid, transmit in turn, and the
+ * Rx Power of each transmission is computed for all the other nodes, as
+ * the wifi and spectrum channels do.  Each chain of loss models is timed
+ * as is, for each receiver in turn and for all the receivers at once, and
+ * with its deterministic models cached by a CachedPropagationLossModel and
+ * its stochastic models chained after it.  The Rx Powers are folded into a
+ * checksum, which must be the same in all the cases.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Fold a double into a checksum, using its bit pattern.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (sum ^ bits) * 0x100000001b3ULL;
+}
+
+/**
+ * Time the Rx Powers of the transmissions of all the nodes.
+ * \param [in] name The name of the chain of loss models.
+ * \param [in] loss The first loss model of the chain.
+ * \param [in] mobility The mobility models of the nodes.
+ * \param [in] rounds The number of times each node transmits.
+ * \param [in] batch Whether the Rx Powers of all the receivers are computed at once.
+ */
+void
+Bench(const std::string& name,
+      Ptr<PropagationLossModel> loss,
+      const std::vector<Ptr<MobilityModel>>& mobility,
+      uint32_t rounds,
+      bool batch)
+{
+    // The receivers of each node
+    std::vector<std::vector<Ptr<MobilityModel>>> receivers;
+    for (const auto& tx : mobility)
+    {
+        receivers.emplace_back();
+        for (const auto& rx : mobility)
+        {
+            if (rx != tx)
+            {
+                receivers.back().push_back(rx);
+            }
+        }
+    }
+    std::vector<double> rxPowerDbm(mobility.size());
+
+    loss->AssignStreams(1);
+    uint64_t sum = 0xcbf29ce484222325ULL;
+    uint64_t n = 0;
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        for (std::size_t tx = 0; tx < mobility.size(); tx++)
+        {
+            const auto& rxs = receivers[tx];
+            if (batch)
+            {
+                std::span<double> out(rxPowerDbm.data(), rxs.size());
+                loss->CalcRxPower(16, mobility[tx], rxs, out);
+                for (double value : out)
+                {
+                    sum = Fold(sum, value);
+                }
+            }
+            else
+            {
+                for (const auto& rx : rxs)
+                {
+                    sum = Fold(sum, loss->CalcRxPower(16, mobility[tx], rx));
+                }
+            }
+            n += rxs.size();
+        }
+    }
+    int64_t ms = clock.End();
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << 1e6 * ms / n << " ns/rx   checksum "
+              << std::hex << std::setw(16) << std::setfill('0') << sum << std::dec
+              << std::setfill(' ') << std::endl;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 100;
+    uint32_t rounds = 100;
+    double spacing = 30;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark chains of propagation loss models with and without caching.");
+    cmd.AddValue("nodes", "number of nodes of the mesh", nodes);
+    cmd.AddValue("rounds", "number of transmissions of each node", rounds);
+    cmd.AddValue("spacing", "distance between neighbor nodes, in meters", spacing);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Propagation loss benchmark: " << nodes << " nodes, " << rounds << " rounds"
+              << std::endl;
+
+    std::vector<Ptr<MobilityModel>> mobility;
+    auto side = static_cast<uint32_t>(std::ceil(std::sqrt(nodes)));
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        Ptr<MobilityModel> model = CreateObject<ConstantPositionMobilityModel>();
+        model->SetPosition(Vector(spacing * (i % side), spacing * (i / side), 1.5));
+        mobility.push_back(model);
+    }
+
+    // Chains of deterministic models, followed by optional stochastic models
+    struct Chain
+    {
+        std::string name;
+        std::function<Ptr<PropagationLossModel>()> deterministic;
+        std::function<Ptr<PropagationLossModel>()> stochastic;
+    };
+
+    std::vector<Chain> chains{
+        {"LogDistance",
+         []() { return CreateObject<LogDistancePropagationLossModel>(); },
+         []() { return nullptr; }},
+        {"ThreeLogDistance+Nakagami",
+         []() { return CreateObject<ThreeLogDistancePropagationLossModel>(); },
+         []() { return CreateObject<NakagamiPropagationLossModel>(); }},
+        {"TwoRayGround+Range+Nakagami",
+         []() {
+             Ptr<PropagationLossModel> model = CreateObject<TwoRayGroundPropagationLossModel>();
+             model->SetNext(CreateObject<RangePropagationLossModel>());
+             return model;
+         },
+         []() { return CreateObject<NakagamiPropagationLossModel>(); }},
+        {"ItuR1411NlosOverRooftop",
+         []() { return CreateObject<ItuR1411NlosOverRooftopPropagationLossModel>(); },
+         []() { return nullptr; }},
+    };
+
+    for (const auto& chain : chains)
+    {
+        // Each run has its own models, as the random variables keep some
+        // state across AssignStreams()
+        auto create = [&chain]() {
+            Ptr<PropagationLossModel> loss = chain.deterministic();
+            Ptr<PropagationLossModel> last = loss;
+            while (last->GetNext())
+            {
+                last = last->GetNext();
+            }
+            last->SetNext(chain.stochastic());
+            return loss;
+        };
+        Bench(chain.name, create(), mobility, rounds, false);
+        Bench(chain.name + " (batch)", create(), mobility, rounds, true);
+
+        Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+        cached->SetModel(chain.deterministic());
+        cached->SetNext(chain.stochastic());
+        Bench(chain.name + " (cached)", cached, mobility, rounds, false);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Benchmark of the route lookups of Ipv4GlobalRouting, Ipv4StaticRouting
+ * and Ipv6StaticRouting.
+ *
+ * A router is given one host route per destination, as a data-center
+ * router populated by GlobalRouteManager, plus one network route per
+ * 256 destinations and a default route.  The benchmark then times the
+ * route lookups of random destinations, most of them covered by a host
+ * route and the others only by a network or the default route.  The
+ * IPv6 lookups are timed without and with the Ipv6StaticRouting route
+ * cache.
+ */
+
+using namespace ns3;
+
+/**
+ * Time the route lookups of a routing protocol.
+ *
+ * \tparam Header \explicit The IP header type.
+ * \tparam Routing \deduced The routing protocol type.
+ * \tparam Address \deduced The address type.
+ * \param [in] name The routing protocol name.
+ * \param [in] routing The routing protocol.
+ * \param [in] destinations The destinations to look up.
+ * \param [in] iterations The number of passes over the destinations.
+ */
+template <typename Header, typename Routing, typename Address>
+static void
+Bench(const std::string& name,
+      Ptr<Routing> routing,
+      const std::vector<Address>& destinations,
+      uint32_t iterations)
+{
+    Ptr<Packet> packet = Create<Packet>();
+    Header header;
+    Socket::SocketErrno error;
+    uint64_t found = 0;
+
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t it = 0; it < iterations; it++)
+    {
+        for (const auto& destination : destinations)
+        {
+            header.SetDestination(destination);
+            found += routing->RouteOutput(packet, header, nullptr, error) ? 1 : 0;
+        }
+    }
+    int64_t ms = clock.End();
+    double lookups = static_cast<double>(iterations) * destinations.size();
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << 1e6 * ms / lookups << " ns/lookup "
+              << std::setw(12) << found << " routes found" << std::endl;
+}
+
+/**
+ * Get the IPv6 address of a destination.
+ *
+ * \param [in] index The destination index.
+ * \return The address, in 2001:db8::/96.
+ */
+static Ipv6Address
+GetIpv6Destination(uint32_t index)
+{
+    uint8_t bytes[16] = {0x20, 0x01, 0x0d, 0xb8};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        bytes[15 - i] = (index >> (8 * i)) & 0xff;
+    }
+    return Ipv6Address(bytes);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t routes = 10000;
+    uint32_t lookups = 100000;
+    uint32_t iterations = 1;
+    uint32_t cacheSize = 4096;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the IPv4 global and static and the IPv6 static routing lookups.");
+    cmd.AddValue("routes", "number of host routes", routes);
+    cmd.AddValue("lookups", "number of destinations looked up", lookups);
+    cmd.AddValue("iterations", "number of passes over the destinations", iterations);
+    cmd.AddValue("cacheSize", "size of the IPv6 static routing route cache", cacheSize);
+    cmd.Parse(argc, argv);
+
+    // A router with one interface, whose routing protocols are used directly
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(device);
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t interface = ipv4->AddInterface(device);
+    ipv4->AddAddress(interface, Ipv4InterfaceAddress("192.168.0.1", "255.255.255.0"));
+    ipv4->SetUp(interface);
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+    uint32_t interface6 = ipv6->AddInterface(device);
+    ipv6->AddAddress(interface6, Ipv6InterfaceAddress("2001:1::1", Ipv6Prefix(64)));
+    ipv6->SetUp(interface6);
+
+    Ptr<Ipv4GlobalRouting> global = CreateObject<Ipv4GlobalRouting>();
+    global->SetIpv4(ipv4);
+    Ptr<Ipv4StaticRouting> sr = CreateObject<Ipv4StaticRouting>();
+    sr->SetIpv4(ipv4);
+    Ptr<Ipv6StaticRouting> sr6 = CreateObject<Ipv6StaticRouting>();
+    sr6->SetIpv6(ipv6);
+
+    const uint32_t base = Ipv4Address("10.0.0.0").Get();
+    const Ipv4Address gateway("192.168.0.2");
+    const Ipv6Address gateway6("2001:1::2");
+    for (uint32_t i = 0; i < routes; i++)
+    {
+        global->AddHostRouteTo(Ipv4Address(base + i), gateway, interface);
+        sr->AddHostRouteTo(Ipv4Address(base + i), gateway, interface);
+        sr6->AddHostRouteTo(GetIpv6Destination(i), gateway6, interface6);
+    }
+    for (uint32_t i = 0; i < routes; i += 256)
+    {
+        global->AddNetworkRouteTo(Ipv4Address(base + i), "255.255.255.0", gateway, interface);
+        sr->AddNetworkRouteTo(Ipv4Address(base + i), "255.255.255.0", gateway, interface);
+        sr6->AddNetworkRouteTo(GetIpv6Destination(i), Ipv6Prefix(120), gateway6, interface6);
+    }
+    global->AddASExternalRouteTo("0.0.0.0", "0.0.0.0", gateway, interface);
+    sr->SetDefaultRoute(gateway, interface);
+    sr6->SetDefaultRoute(gateway6, interface6);
+
+    // Nine destinations out of ten have a host route
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    std::vector<Ipv4Address> destinations;
+    std::vector<Ipv6Address> destinations6;
+    for (uint32_t i = 0; i < lookups; i++)
+    {
+        uint32_t index = random->GetInteger(0, routes * 10 / 9);
+        destinations.emplace_back(base + index);
+        destinations6.emplace_back(GetIpv6Destination(index));
+    }
+
+    std::cout << "Route lookup benchmark: " << routes << " host routes, " << global->GetNRoutes()
+              << " IPv4 global routes, " << sr->GetNRoutes() << " IPv4 static routes, "
+              << sr6->GetNRoutes() << " IPv6 static routes" << std::endl;
+    Bench<Ipv4Header>("Ipv4GlobalRouting", global, destinations, iterations);
+    Bench<Ipv4Header>("Ipv4StaticRouting", sr, destinations, iterations);
+    Bench<Ipv6Header>("Ipv6StaticRouting", sr6, destinations6, iterations);
+    sr6->SetAttribute("RouteCacheSize", UintegerValue(cacheSize));
+    Bench<Ipv6Header>("Ipv6StaticRouting (cache)", sr6, destinations6, iterations);
+
+    Simulator::Destroy();
+    return 0;
+}
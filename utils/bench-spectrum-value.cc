@@ -0,0 +1,162 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/spectrum-value.h"
+
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Microbenchmark of the SpectrumValue operations.
+ *
+ * The operations used by the spectrum channels and the interference
+ * models on each signal are applied to random power spectral densities
+ * of spectrum models of typical sizes, from the 100 resource blocks of
+ * an LTE channel to the 3300 subcarriers of a wide wifi channel.  The
+ * results are folded into a checksum, which is printed with the timing
+ * so that the results of two builds can be compared bit for bit.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Fold a double into a checksum, using its bit pattern.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (sum ^ bits) * 0x100000001b3ULL;
+}
+
+/**
+ * Time one operation.
+ * \param [in] name The operation name.
+ * \param [in] nBands The number of bands of the spectrum model.
+ * \param [in] iterations The number of times the operation is run.
+ * \param [in] operation The operation, returning a value to fold into the checksum.
+ */
+void
+Bench(const std::string& name,
+      std::size_t nBands,
+      uint32_t iterations,
+      const std::function<double()>& operation)
+{
+    uint64_t sum = 0xcbf29ce484222325ULL;
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t it = 0; it < iterations; it++)
+    {
+        sum = Fold(sum, operation());
+    }
+    int64_t ms = clock.End();
+    double ns = 1e6 * ms / iterations;
+    std::cout << std::left << std::setw(30) << name << std::right << std::setw(6) << nBands
+              << " bands " << std::fixed << std::setprecision(1) << std::setw(10) << ns
+              << " ns/op " << std::setprecision(3) << std::setw(8) << ns / nBands
+              << " ns/band   checksum " << std::hex << std::setw(16) << std::setfill('0') << sum
+              << std::dec << std::setfill(' ') << std::endl;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string bands = "100,256,1024,3300";
+    uint64_t values = 100000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the SpectrumValue operations.\n"
+              "\n"
+              "The checksums only depend on the operands and on the\n"
+              "order of the sums, so they can be compared between\n"
+              "builds to check that the results are identical. The sums\n"
+              "are interleaved with --SpectrumValueInterleavedSums=true.");
+    cmd.AddValue("bands", "comma-separated numbers of bands of the spectrum models", bands);
+    cmd.AddValue("values", "number of values processed by each operation", values);
+    cmd.Parse(argc, argv);
+
+    std::cout << "SpectrumValue benchmark: " << values << " values per operation" << std::endl;
+
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::istringstream bandList(bands);
+    std::string token;
+    while (std::getline(bandList, token, ','))
+    {
+        std::size_t nBands = std::stoul(token);
+        uint32_t iterations = std::max<uint64_t>(values / nBands, 1);
+
+        std::vector<double> freqs;
+        for (std::size_t i = 0; i < nBands; i++)
+        {
+            freqs.push_back(5e9 + 78125 * i);
+        }
+        Ptr<const SpectrumModel> model = Create<SpectrumModel>(freqs);
+        auto psd = [&]() {
+            Ptr<SpectrumValue> value = Create<SpectrumValue>(model);
+            for (auto it = value->ValuesBegin(); it != value->ValuesEnd(); ++it)
+            {
+                *it = rng->GetValue(1e-18, 1e-15);
+            }
+            return value;
+        };
+        Ptr<SpectrumValue> rx = psd();
+        Ptr<SpectrumValue> all = psd();
+        Ptr<SpectrumValue> noise = psd();
+        *all += *rx;
+
+        // Signal received through a spectrum channel
+        Bench("Copy and scale", nBands, iterations, [&]() {
+            Ptr<SpectrumValue> rxPsd = rx->Copy();
+            *rxPsd *= 1e-9;
+            return rxPsd->ValuesAt(0);
+        });
+        // Interference and SINR as in LteInterference and SpectrumInterference
+        Bench("Interference and SINR", nBands, iterations, [&]() {
+            SpectrumValue interf = (*all) - (*rx) + (*noise);
+            SpectrumValue sinr = (*rx) / interf;
+            return sinr.ValuesAt(0);
+        });
+        // Addition and removal of a signal to the total signal
+        Bench("In-place addition", nBands, iterations, [&]() {
+            *all += *rx;
+            *all -= *rx;
+            return all->ValuesAt(0);
+        });
+        Bench("Addition", nBands, iterations, [&]() { return (*all + *rx).ValuesAt(0); });
+        Bench("Sum", nBands, iterations, [&]() { return Sum(*rx); });
+        Bench("Integral", nBands, iterations, [&]() { return Integral(*rx); });
+        Bench("Norm", nBands, iterations, [&]() { return Norm(*rx); });
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <iomanip>
+#include <iostream>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Benchmark of a TCP bulk transfer with a large window and random losses.
+ *
+ * A sender fills its socket buffer as fast as TcpSocketBase drains it,
+ * over a link with a large bandwidth-delay product which drops data
+ * segments at random.  With SACK, most of the ACKs carry SACK blocks, so
+ * the benchmark times the TcpTxBuffer scoreboard updates, loss marking
+ * and retransmission lookups, as well as the TcpRxBuffer out-of-order
+ * insertions.
+ *
+ * With the bulk option, the queue discs dequeue packets in batches bounded
+ * by dynamic queue limits, and the benchmark reports the batch sizes.
+ */
+
+using namespace ns3;
+
+/// Bytes received by the sink.
+static uint64_t g_received = 0;
+
+/**
+ * Fill the socket buffer of the sender.
+ *
+ * \param [in] socket The sender socket.
+ * \param [in] available The free space of the socket buffer.
+ */
+static void
+Fill(Ptr<Socket> socket, uint32_t available)
+{
+    while (socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint32_t>(socket->GetTxAvailable(), 65536);
+        if (socket->Send(Create<Packet>(size)) < 0)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * Drain the socket buffer of the sink.
+ *
+ * \param [in] socket The sink socket.
+ */
+static void
+Drain(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        g_received += packet->GetSize();
+    }
+}
+
+/**
+ * Accept a connection on the sink.
+ *
+ * \param [in] socket The accepted socket.
+ * \param [in] from The sender address.
+ */
+static void
+Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&Drain));
+}
+
+int
+main(int argc, char* argv[])
+{
+    DataRate rate("1Gbps");
+    Time delay = MilliSeconds(50);
+    double loss = 0.0001;
+    Time duration = Seconds(10);
+    bool sack = true;
+    bool offload = false;
+    bool bulk = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark a TCP bulk transfer with a large window and random losses.");
+    cmd.AddValue("rate", "link data rate", rate);
+    cmd.AddValue("delay", "one-way link delay", delay);
+    cmd.AddValue("loss", "data segment loss probability", loss);
+    cmd.AddValue("duration", "simulated duration", duration);
+    cmd.AddValue("sack", "enable SACK", sack);
+    cmd.AddValue("offload",
+                 "enable the segmentation and receive offloads, without queue discs",
+                 offload);
+    cmd.AddValue("bulk",
+                 "dequeue packets from the queue discs in batches, with dynamic queue limits",
+                 bulk);
+    cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(bulk && offload, "The offloads are benchmarked without queue discs");
+
+    // Buffers of twice the bandwidth-delay product
+    uint32_t buffer = static_cast<uint32_t>(rate.GetBitRate() / 8 * 4 * delay.GetSeconds());
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(buffer));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(buffer));
+    Config::SetDefault("ns3::TcpSocketBase::Sack", BooleanValue(sack));
+    if (offload)
+    {
+        Config::SetDefault("ns3::TcpSocketBase::SegmentationOffloadSize", UintegerValue(65535));
+        Config::SetDefault("ns3::TcpSocketBase::ReceiveOffloadTimeout",
+                           TimeValue(MicroSeconds(100)));
+    }
+
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper link;
+    link.SetDeviceAttribute("DataRate", DataRateValue(rate));
+    link.SetChannelAttribute("Delay", TimeValue(delay));
+    if (offload)
+    {
+        // Without queue disc, the device queue must hold the whole window
+        link.SetQueue("ns3::DropTailQueue<Packet>",
+                      "MaxSize",
+                      QueueSizeValue(QueueSize(QueueSizeUnit::BYTES, buffer)));
+    }
+    NetDeviceContainer devices = link.Install(nodes);
+    Ptr<RateErrorModel> errors = CreateObject<RateErrorModel>();
+    errors->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errors->SetRate(loss);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errors));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = addresses.Assign(devices);
+    if (offload)
+    {
+        // Super-segments are only sent whole to devices without queue disc
+        // and with a large enough MTU
+        TrafficControlHelper().Uninstall(devices);
+        for (uint32_t i = 0; i < devices.GetN(); ++i)
+        {
+            devices.Get(i)->SetMtu(65535);
+        }
+    }
+    QueueDiscContainer qdiscs;
+    if (bulk)
+    {
+        TrafficControlHelper tch = TrafficControlHelper::Default();
+        tch.SetQueueLimits("ns3::DynamicQueueLimits");
+        tch.Uninstall(devices);
+        qdiscs = tch.Install(devices);
+        for (uint32_t i = 0; i < qdiscs.GetN(); ++i)
+        {
+            qdiscs.Get(i)->SetAttribute("BulkDequeue", BooleanValue(true));
+        }
+    }
+
+    Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(1), TcpSocketFactory::GetTypeId());
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 5000));
+    sink->Listen();
+    sink->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                            MakeCallback(&Accept));
+
+    Ptr<Socket> sender = Socket::CreateSocket(nodes.Get(0), TcpSocketFactory::GetTypeId());
+    sender->Bind();
+    sender->SetSendCallback(MakeCallback(&Fill));
+    sender->Connect(InetSocketAddress(interfaces.GetAddress(1), 5000));
+    Simulator::Schedule(Seconds(0), &Fill, sender, 0);
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Stop(duration);
+    Simulator::Run();
+    int64_t ms = clock.End();
+
+    uint64_t segments = g_received / 1448;
+    std::cout << "TCP bulk transfer benchmark: " << rate << ", " << delay.As(Time::MS)
+              << " one-way delay, " << loss << " loss, SACK " << (sack ? "on" : "off")
+              << ", offload " << (offload ? "on" : "off") << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "received " << g_received << " bytes ("
+              << 8e-6 * g_received / duration.GetSeconds() << " Mbps) in " << ms
+              << " ms wall-clock, " << (segments ? 1e3 * ms / segments : 0.0)
+              << " us per segment" << std::endl;
+    if (bulk)
+    {
+        const QueueDisc::Stats& stats = qdiscs.Get(0)->GetStats();
+        std::cout << "sender queue disc: " << stats.nTotalSentPackets << " packets sent in "
+                  << stats.nTotalRuns << " runs and " << stats.nTotalSentBatches
+                  << " batches, largest batch " << stats.nMaxSentBatchPackets << " packets"
+                  << std::endl;
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
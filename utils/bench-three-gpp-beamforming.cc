@@ -0,0 +1,219 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/antenna-module.h"
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/spectrum-module.h"
+
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Benchmark of the beamforming gain computation of the
+ * ThreeGppSpectrumPropagationLossModel.
+ *
+ * A base station with a uniform planar array of 64 elements and a user
+ * equipment with an array of 16 elements, in the 3GPP UMa scenario at
+ * 28 GHz, exchange signals over spectrum models of typical numbers of
+ * resource blocks.  The received power spectral density is computed with
+ * the long term component of the channel cached, which measures the
+ * computation of the frequency-domain channel matrix of each resource
+ * block, and with the beamforming vector of the base station changed
+ * before each signal, which also measures the computation of the long
+ * term component.  The received powers are folded into a checksum, which
+ * is printed with the timing so that the results of two builds can be
+ * compared.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Fold a double into a checksum, using its bit pattern.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (sum ^ bits) * 0x100000001b3ULL;
+}
+
+/**
+ * Time one computation.
+ * \param [in] name The computation name.
+ * \param [in] nRbs The number of resource blocks of the spectrum model.
+ * \param [in] iterations The number of times the computation is run.
+ * \param [in] computation The computation, returning a value to fold into the checksum.
+ */
+void
+Bench(const std::string& name,
+      std::size_t nRbs,
+      uint32_t iterations,
+      const std::function<double()>& computation)
+{
+    uint64_t sum = 0xcbf29ce484222325ULL;
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t it = 0; it < iterations; it++)
+    {
+        sum = Fold(sum, computation());
+    }
+    int64_t ms = clock.End();
+    double us = 1e3 * ms / iterations;
+    std::cout << std::left << std::setw(20) << name << std::right << std::setw(6) << nRbs
+              << " RBs " << std::fixed << std::setprecision(2) << std::setw(10) << us
+              << " us/signal " << std::setprecision(3) << std::setw(8) << 1e3 * us / nRbs
+              << " ns/RB   checksum " << std::hex << std::setw(16) << std::setfill('0') << sum
+              << std::dec << std::setfill(' ') << std::endl;
+}
+
+/**
+ * Create a uniform planar array of isotropic elements.
+ * \param [in] rows The number of rows.
+ * \param [in] columns The number of columns.
+ * \param [in] ports The number of vertical and horizontal ports.
+ * \return The array.
+ */
+Ptr<PhasedArrayModel>
+CreateArray(uint32_t rows, uint32_t columns, uint32_t ports)
+{
+    return CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumRows",
+        UintegerValue(rows),
+        "NumColumns",
+        UintegerValue(columns),
+        "NumVerticalPorts",
+        UintegerValue(ports),
+        "NumHorizontalPorts",
+        UintegerValue(ports),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string rbs = "100,275,3300";
+    uint32_t signals = 2000;
+    uint32_t bsRows = 8;
+    uint32_t bsColumns = 8;
+    uint32_t ueRows = 4;
+    uint32_t ueColumns = 4;
+    uint32_t ports = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the beamforming gain computation of the\n"
+              "ThreeGppSpectrumPropagationLossModel.");
+    cmd.AddValue("rbs", "comma-separated numbers of resource blocks of the spectrum models", rbs);
+    cmd.AddValue("signals", "number of signals per computation", signals);
+    cmd.AddValue("bsRows", "number of rows of the array of the base station", bsRows);
+    cmd.AddValue("bsColumns", "number of columns of the array of the base station", bsColumns);
+    cmd.AddValue("ueRows", "number of rows of the array of the user equipment", ueRows);
+    cmd.AddValue("ueColumns", "number of columns of the array of the user equipment", ueColumns);
+    cmd.AddValue("ports", "number of vertical and horizontal ports of the arrays", ports);
+    cmd.Parse(argc, argv);
+
+    std::cout << "ThreeGppSpectrumPropagationLossModel benchmark: " << bsRows << "x" << bsColumns
+              << " and " << ueRows << "x" << ueColumns << " arrays, " << ports * ports
+              << " ports, " << signals << " signals" << std::endl;
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    const double frequency = 28e9;
+    Ptr<ThreeGppSpectrumPropagationLossModel> lossModel =
+        CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    lossModel->SetChannelModelAttribute("Frequency", DoubleValue(frequency));
+    lossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+    lossModel->SetChannelModelAttribute(
+        "ChannelConditionModel",
+        PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    lossModel->AssignStreams(1);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> bsMob = CreateObject<ConstantPositionMobilityModel>();
+    bsMob->SetPosition(Vector(0.0, 0.0, 25.0));
+    Ptr<MobilityModel> ueMob = CreateObject<ConstantPositionMobilityModel>();
+    ueMob->SetPosition(Vector(100.0, 50.0, 1.5));
+    nodes.Get(0)->AggregateObject(bsMob);
+    nodes.Get(1)->AggregateObject(ueMob);
+
+    Ptr<PhasedArrayModel> bsAntenna = CreateArray(bsRows, bsColumns, ports);
+    Ptr<PhasedArrayModel> ueAntenna = CreateArray(ueRows, ueColumns, ports);
+    Angles bsToUe(ueMob->GetPosition(), bsMob->GetPosition());
+    PhasedArrayModel::ComplexVector bsVectors[] = {
+        bsAntenna->GetBeamformingVector(bsToUe),
+        bsAntenna->GetBeamformingVector(
+            Angles(bsToUe.GetAzimuth() + 0.1, bsToUe.GetInclination())),
+    };
+    bsAntenna->SetBeamformingVector(bsVectors[0]);
+    ueAntenna->SetBeamformingVector(
+        ueAntenna->GetBeamformingVector(Angles(bsMob->GetPosition(), ueMob->GetPosition())));
+
+    std::istringstream rbList(rbs);
+    std::string token;
+    while (std::getline(rbList, token, ','))
+    {
+        std::size_t nRbs = std::stoul(token);
+
+        // Resource blocks of 12 subcarriers of 30 kHz
+        std::vector<double> freqs;
+        for (std::size_t i = 0; i < nRbs; i++)
+        {
+            freqs.push_back(frequency + 360e3 * (i - nRbs / 2.0));
+        }
+        Ptr<SpectrumValue> psd = Create<SpectrumValue>(Create<SpectrumModel>(freqs));
+        *psd = 1e-9;
+        Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters>();
+        txParams->psd = psd;
+
+        auto rxPower = [&]() {
+            return Sum(*lossModel
+                            ->CalcRxPowerSpectralDensity(txParams,
+                                                         bsMob,
+                                                         ueMob,
+                                                         bsAntenna,
+                                                         ueAntenna)
+                            ->psd);
+        };
+        Bench("Cached long term", nRbs, signals, rxPower);
+        uint32_t vector = 0;
+        Bench("Long term update", nRbs, signals, [&]() {
+            vector ^= 1;
+            bsAntenna->SetBeamformingVector(bsVectors[vector]);
+            return rxPower();
+        });
+    }
+    return 0;
+}
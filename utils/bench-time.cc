@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Microbenchmark of the Time and int64x64_t operations.
+ *
+ * Each operation is applied to a table of pseudo-random operands, and
+ * the results are folded into a checksum, which is printed with the
+ * timing so that the results of two builds can be compared bit for bit.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Fold a value into a checksum.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, uint64_t value)
+{
+    return (sum ^ value) * 0x100000001b3ULL;
+}
+
+/**
+ * Fold a double into a checksum, using its bit pattern.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return Fold(sum, bits);
+}
+
+/**
+ * Fold a fixed point value into a checksum.
+ * \param [in] sum The checksum.
+ * \param [in] value The value.
+ * \return The updated checksum.
+ */
+inline uint64_t
+Fold(uint64_t sum, const int64x64_t& value)
+{
+    return Fold(Fold(sum, static_cast<uint64_t>(value.GetHigh())), value.GetLow());
+}
+
+/** The benchmark operands. */
+struct Operands
+{
+    std::vector<Time> times;         //!< Times, from 1 ns to about 1000 s.
+    std::vector<double> doubles;     //!< Doubles, from 0 to 1000.
+    std::vector<int64x64_t> scales;  //!< Fixed point scale factors.
+    std::vector<uint64_t> integers;  //!< Integers, from 0 to 1e6.
+};
+
+/**
+ * Time one operation over all the operands.
+ * \param [in] name The operation name.
+ * \param [in] iterations The number of passes over the operands.
+ * \param [in] size The number of operands.
+ * \param [in] operation The operation, applied to operand \c i,
+ *             returning the updated checksum.
+ */
+void
+Bench(const std::string& name,
+      uint32_t iterations,
+      std::size_t size,
+      const std::function<uint64_t(uint64_t, std::size_t)>& operation)
+{
+    uint64_t sum = 0xcbf29ce484222325ULL;
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint32_t it = 0; it < iterations; it++)
+    {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            sum = operation(sum, i);
+        }
+    }
+    int64_t ms = clock.End();
+    double ns = 1e6 * ms / (static_cast<double>(iterations) * size);
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << ns << " ns/op   checksum " << std::hex
+              << std::setw(16) << std::setfill('0') << sum << std::dec << std::setfill(' ')
+              << std::endl;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t size = 100000;
+    uint32_t iterations = 100;
+    std::string resolution = "NS";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Time and int64x64_t operations.\n"
+              "\n"
+              "The checksums only depend on the operands, so they\n"
+              "can be compared between builds to check that the\n"
+              "results are identical.");
+    cmd.AddValue("size", "number of operands", size);
+    cmd.AddValue("iterations", "number of passes over the operands", iterations);
+    cmd.AddValue("resolution", "time resolution: FS, PS, NS, US or MS", resolution);
+    cmd.Parse(argc, argv);
+
+    if (resolution != "NS")
+    {
+        const std::vector<std::pair<std::string, Time::Unit>> units{
+            {"FS", Time::FS},
+            {"PS", Time::PS},
+            {"US", Time::US},
+            {"MS", Time::MS},
+        };
+        for (const auto& [label, unit] : units)
+        {
+            if (label == resolution)
+            {
+                Time::SetResolution(unit);
+            }
+        }
+    }
+
+    Operands op;
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        op.times.push_back(Time::From(rng->GetValue(0, 1000) * 1e9, Time::NS) + NanoSeconds(1));
+        op.doubles.push_back(rng->GetValue(0, 1000));
+        op.scales.push_back(int64x64_t(rng->GetValue(0, 4)));
+        op.integers.push_back(rng->GetInteger(0, 1000000));
+    }
+
+    // Freeze the resolution, as in a running simulation, so that new
+    // Times are no longer recorded for a resolution change
+    Simulator::Run();
+
+    std::cout << "Time and int64x64_t benchmark: " << size << " operands, " << iterations
+              << " iterations, resolution " << resolution << std::endl;
+
+    // Conversions to units
+    Bench("Time::GetSeconds", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].GetSeconds());
+    });
+    Bench("Time::GetMicroSeconds", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, static_cast<uint64_t>(op.times[i].GetMicroSeconds()));
+    });
+    Bench("Time::To(NS)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].To(Time::NS));
+    });
+    Bench("Time::To(PS)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].To(Time::PS));
+    });
+    Bench("Time::To(MS)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].To(Time::MS));
+    });
+    Bench("Time::ToDouble(NS)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].ToDouble(Time::NS));
+    });
+    Bench("Time::ToDouble(US)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i].ToDouble(Time::US));
+    });
+
+    // Conversions from units
+    Bench("Seconds(double)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, static_cast<uint64_t>(Seconds(op.doubles[i]).GetTimeStep()));
+    });
+    Bench("MicroSeconds(uint64_t)", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, static_cast<uint64_t>(MicroSeconds(op.integers[i]).GetTimeStep()));
+    });
+
+    // Arithmetic
+    Bench("Time * int64x64_t", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, static_cast<uint64_t>((op.times[i] * op.scales[i]).GetTimeStep()));
+    });
+    Bench("Time / Time", iterations, size, [&op, size](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.times[i] / op.times[size - 1 - i]);
+    });
+    Bench("Time < Time", iterations, size, [&op, size](uint64_t sum, std::size_t i) {
+        return Fold(sum, static_cast<uint64_t>(op.times[i] < op.times[size - 1 - i]));
+    });
+    Bench("int64x64_t * int64x64_t", iterations, size, [&op, size](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.scales[i] * op.scales[size - 1 - i]);
+    });
+    Bench("int64x64_t / int64x64_t", iterations, size, [&op, size](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.scales[i] / (op.scales[size - 1 - i] + int64x64_t(1)));
+    });
+    Bench("int64x64_t::GetDouble", iterations, size, [&op](uint64_t sum, std::size_t i) {
+        return Fold(sum, op.scales[i].GetDouble());
+    });
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,263 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-perf
+ *
+ * Benchmark of the noise and interference bookkeeping of the wifi
+ * InterferenceHelper.
+ *
+ * As in wifi-spectrum-per-example, a receiver operating on a wide
+ * channel tracks the 20 MHz subchannels and every wider band they make
+ * up, and receives A-MPDUs overlapped by other signals of random width
+ * and position in the channel.  Each signal is added to the helper, and
+ * the energy duration of each 20 MHz subchannel is checked at its
+ * arrival for CCA; the receiver locks on the signals arriving while it
+ * is idle and computes the SNR and PER of their PHY headers and of each
+ * of their MPDUs.  The benchmark reports the time per signal and a
+ * checksum of the PERs, which must not depend on the implementation,
+ * except when the error rate model uses lookup tables.
+ */
+
+using namespace ns3;
+
+/**
+ * Receiver of the InterferenceHelper benchmark.
+ */
+class InterferenceBench
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] channelWidth The width of the channel of the receiver, in MHz.
+     * \param [in] load The mean number of signals on the air.
+     * \param [in] nMpdus The number of MPDUs of the A-MPDUs.
+     */
+    InterferenceBench(uint16_t channelWidth, double load, uint32_t nMpdus);
+
+    /**
+     * Run the benchmark.
+     *
+     * \param [in] nSignals The number of signals.
+     */
+    void Run(uint32_t nSignals);
+
+  private:
+    /// Start the next signal and schedule the following one.
+    void StartSignal();
+    /**
+     * Compute the SNR and PER of a received signal and end its reception.
+     *
+     * \param [in] event The event of the signal.
+     */
+    void EndRx(Ptr<Event> event);
+
+    uint16_t m_channelWidth;                //!< Channel width, in MHz
+    uint32_t m_nMpdus;                      //!< Number of MPDUs of the A-MPDUs
+    Time m_duration;                        //!< Duration of the signals
+    Time m_meanInterval;                    //!< Mean interval between two signals
+    uint32_t m_remaining{0};                //!< Number of signals left to start
+    bool m_rxing{false};                    //!< Whether the receiver is locked on a signal
+    WifiSpectrumBands m_bands;              //!< All the bands of the channel
+    WifiSpectrumBands m_subchannels;        //!< The 20 MHz subchannels
+    Ptr<InterferenceHelper> m_interference; //!< The helper under test
+    Ptr<const WifiPpdu> m_ppdu;             //!< The PPDU of the signals
+    Ptr<UniformRandomVariable> m_uniform;   //!< Random variable
+    Ptr<ExponentialRandomVariable> m_interval; //!< Interval between the signals
+    uint64_t m_nRx{0};                         //!< Number of received signals
+    uint64_t m_nQueries{0};                    //!< Number of SNR and PER queries
+    double m_checksum{0};                      //!< Sum of the PERs
+};
+
+InterferenceBench::InterferenceBench(uint16_t channelWidth, double load, uint32_t nMpdus)
+    : m_channelWidth(channelWidth),
+      m_nMpdus(nMpdus)
+{
+    // The 20 MHz subchannels and all the wider bands of the channel
+    const uint64_t startFrequency = 5170e6;
+    for (uint16_t width = 20; width <= channelWidth; width *= 2)
+    {
+        for (uint16_t start = 0; start < channelWidth; start += width)
+        {
+            WifiSpectrumBandInfo band{{start * 4U, (start + width) * 4U - 1},
+                                      {startFrequency + start * 1000000ULL,
+                                       startFrequency + (start + width) * 1000000ULL}};
+            m_bands.push_back(band);
+            if (width == 20)
+            {
+                m_subchannels.push_back(band);
+            }
+        }
+    }
+
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetNoiseFigure(DbToRatio(7));
+    m_interference->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+    m_interference->SetNumberOfReceiveAntennas(1);
+    for (const auto& band : m_bands)
+    {
+        m_interference->AddBand(band);
+    }
+
+    WifiTxVector txVector(VhtPhy::GetVhtMcs5(),
+                          0,
+                          WIFI_PREAMBLE_VHT_SU,
+                          800,
+                          1,
+                          1,
+                          0,
+                          std::min<uint16_t>(channelWidth, 160),
+                          true);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    m_ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(1500), hdr),
+                              txVector,
+                              WifiPhyOperatingChannel());
+    m_duration = MicroSeconds(50 + 30 * nMpdus);
+    m_meanInterval = m_duration / load;
+
+    m_uniform = CreateObject<UniformRandomVariable>();
+    m_interval = CreateObject<ExponentialRandomVariable>();
+    m_interval->SetAttribute("Mean", DoubleValue(m_meanInterval.GetSeconds()));
+}
+
+void
+InterferenceBench::Run(uint32_t nSignals)
+{
+    m_remaining = nSignals;
+    Simulator::ScheduleNow(&InterferenceBench::StartSignal, this);
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Run();
+    int64_t ms = clock.End();
+
+    std::cout << std::left << std::setw(6) << m_channelWidth << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << 1e3 * ms / nSignals << " us/signal "
+              << std::setw(10) << m_nRx << " rx " << std::setw(10) << m_nQueries << " queries "
+              << std::setprecision(9) << std::setw(18) << m_checksum << " checksum" << std::endl;
+}
+
+void
+InterferenceBench::StartSignal()
+{
+    if (m_remaining == 0)
+    {
+        return;
+    }
+    m_remaining--;
+
+    // A signal of random width and power, aligned in the channel, leaking
+    // in the rest of the channel
+    uint16_t width = 20 << m_uniform->GetInteger(0, std::log2(m_channelWidth / 20));
+    uint16_t start = width * m_uniform->GetInteger(0, m_channelWidth / width - 1);
+    double powerW = DbmToW(m_uniform->GetValue(-90, -50));
+    RxPowerWattPerChannelBand rxPowerW;
+    for (const auto& band : m_bands)
+    {
+        double bandStart = (band.frequencies.first - m_bands.front().frequencies.first) / 1e6;
+        double bandStop = (band.frequencies.second - m_bands.front().frequencies.first) / 1e6;
+        double overlap = std::max(0.0,
+                                  std::min<double>(bandStop, start + width) -
+                                      std::max<double>(bandStart, start));
+        rxPowerW.insert({band, std::max(powerW * overlap / width, powerW * 1e-4)});
+    }
+
+    bool rx = !m_rxing;
+    Ptr<Event> event = m_interference->Add(m_ppdu, m_duration, rxPowerW);
+    for (const auto& subchannel : m_subchannels)
+    {
+        m_interference->GetEnergyDuration(DbmToW(-62), subchannel);
+    }
+    if (rx)
+    {
+        m_rxing = true;
+        m_interference->NotifyRxStart();
+        Simulator::Schedule(m_duration, &InterferenceBench::EndRx, this, event);
+    }
+    Simulator::Schedule(Seconds(m_interval->GetValue()), &InterferenceBench::StartSignal, this);
+}
+
+void
+InterferenceBench::EndRx(Ptr<Event> event)
+{
+    const WifiSpectrumBandInfo& band = m_bands.back();
+    for (auto field : {WIFI_PPDU_FIELD_NON_HT_HEADER, WIFI_PPDU_FIELD_SIG_A})
+    {
+        m_checksum += m_interference->CalculatePhyHeaderSnrPer(event, m_channelWidth, band, field)
+                          .per;
+        m_nQueries++;
+    }
+    Time payloadDuration = m_duration - MicroSeconds(50);
+    for (uint32_t i = 0; i < m_nMpdus; i++)
+    {
+        std::pair<Time, Time> window{payloadDuration * i / m_nMpdus,
+                                     payloadDuration * (i + 1) / m_nMpdus};
+        m_checksum += m_interference
+                          ->CalculatePayloadSnrPer(event, m_channelWidth, band, SU_STA_ID, window)
+                          .per;
+        m_nQueries++;
+    }
+    for (const auto& subchannel : m_subchannels)
+    {
+        m_checksum += 1e-9 * m_interference->CalculateSnr(event, 20, 1, subchannel);
+        m_nQueries++;
+    }
+    m_interference->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    m_rxing = false;
+    m_nRx++;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t signals = 20000;
+    double load = 4;
+    uint32_t mpdus = 32;
+    bool lookupTables = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the noise and interference bookkeeping of the wifi InterferenceHelper.");
+    cmd.AddValue("signals", "number of signals per channel width", signals);
+    cmd.AddValue("load", "mean number of signals on the air", load);
+    cmd.AddValue("mpdus", "number of MPDUs per A-MPDU", mpdus);
+    cmd.AddValue("lookupTables", "interpolate the chunk success rates in tables", lookupTables);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::ErrorRateModel::UseLookupTables", BooleanValue(lookupTables));
+
+    std::cout << "InterferenceHelper benchmark: " << signals << " signals, load " << load << ", "
+              << mpdus << " MPDUs per A-MPDU" << (lookupTables ? ", lookup tables" : "")
+              << std::endl;
+    for (uint16_t channelWidth : {20, 80, 160, 320})
+    {
+        RngSeedManager::SetRun(1);
+        InterferenceBench bench(channelWidth, load, mpdus);
+        bench.Run(signals);
+        Simulator::Destroy();
+    }
+    return 0;
+}
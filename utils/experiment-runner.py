@@ -0,0 +1,322 @@
+#! /usr/bin/env python3
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""
+Run parameter sweeps of an ns-3 program over independent replications.
+
+Every combination of the swept parameters is run once per RngRun value,
+each replication as a separate process passing the parameters and
+--RngRun through CommandLine, with up to --jobs replications running
+at the same time.  Each replication runs in its own directory under
+--outdir, named after its parameters, and is marked complete by a
+'done.json' file; re-running the same sweep skips the complete
+replications, so an interrupted sweep can be resumed.
+
+Once all the replications are complete, the FlowMonitor XML files
+(written with FlowMonitor::SerializeToXmlFile) and the OMNeT++ scalar
+files (written by the DataCollector OmnetDataOutput) found in the
+replication directories are gathered into a single CSV file, with one
+row per replication and measured quantity.
+
+Example:
+
+    ./utils/experiment-runner.py --program=my-scenario \\
+        --param nNodes=10,20,40 --param dataRate=1Mbps,5Mbps \\
+        --runs=1-10 --jobs=8 --outdir=sweep --results=sweep.csv
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+NS3_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# FlowMonitor per-flow statistics copied to the results, converted to numbers
+FLOW_STATS = [
+    "txBytes",
+    "rxBytes",
+    "txPackets",
+    "rxPackets",
+    "lostPackets",
+    "timesForwarded",
+    "delaySum",
+    "jitterSum",
+    "timeFirstTxPacket",
+    "timeLastRxPacket",
+]
+
+
+def read_lock_file():
+    """! Read the list of runnable programs from the ns-3 lock file
+    @return list of program paths and the output directory
+    """
+    lock_filename = os.path.join(NS3_DIR, ".lock-ns3_%s_build" % sys.platform)
+    if not os.path.exists(lock_filename):
+        sys.exit("The .lock-ns3 file was not found. Configure and build ns-3 first.")
+    build_info = {"ns3_runnable_programs": [], "out_dir": os.path.join(NS3_DIR, "build")}
+    with open(lock_filename, encoding="utf-8") as f:
+        exec(f.read(), globals(), build_info)
+    return build_info["ns3_runnable_programs"], build_info["out_dir"]
+
+
+def find_program(name):
+    """! Find the executable of an ns-3 program, e.g. 'first' or 'scratch/my-scenario'
+    @param name program name or path
+    @return the executable path and the library directory
+    """
+    programs, out_dir = read_lock_file()
+    if os.path.isfile(name) and os.access(name, os.X_OK):
+        return os.path.abspath(name), os.path.join(out_dir, "lib")
+    # Program executables are named ns3-<version>-<name>-<profile>
+    pattern = re.compile(r"(^|/)ns3[^/]*?-%s-[^-/]+$" % re.escape(os.path.basename(name)))
+    matches = [p for p in programs if pattern.search(p) and os.path.dirname(name) in p]
+    if not matches:
+        sys.exit("Program '%s' was not found (is it built?)" % name)
+    if len(matches) > 1:
+        sys.exit("Program '%s' is ambiguous: %s" % (name, ", ".join(matches)))
+    return matches[0], os.path.join(out_dir, "lib")
+
+
+def parse_runs(text):
+    """! Parse a list of runs, e.g. '1-10' or '1,3,5-7'
+    @param text the run list
+    @return list of run numbers
+    """
+    runs = []
+    for item in text.split(","):
+        if "-" in item:
+            first, last = item.split("-")
+            runs.extend(range(int(first), int(last) + 1))
+        else:
+            runs.append(int(item))
+    return runs
+
+
+def replication_name(params, run):
+    """! Directory name of a replication
+    @param params parameter name, value pairs
+    @param run the RngRun value
+    @return the name
+    """
+    parts = ["%s=%s" % (k, v) for k, v in params] + ["RngRun=%d" % run]
+    return re.sub(r"[^A-Za-z0-9=.,_+-]", "_", "_".join(parts))
+
+
+def run_replication(executable, libdir, directory, params, run, extra_args):
+    """! Run one replication, unless it is already complete
+    @param executable program path
+    @param libdir ns-3 library directory
+    @param directory replication directory
+    @param params parameter name, value pairs
+    @param run the RngRun value
+    @param extra_args additional program arguments
+    @return the replication status
+    """
+    done_file = os.path.join(directory, "done.json")
+    if os.path.exists(done_file):
+        with open(done_file, encoding="utf-8") as f:
+            status = json.load(f)
+        if status["returncode"] == 0:
+            status["skipped"] = True
+            return status
+
+    os.makedirs(directory, exist_ok=True)
+    command = (
+        [executable] + ["--%s=%s" % (k, v) for k, v in params] + ["--RngRun=%d" % run] + extra_args
+    )
+    env = os.environ.copy()
+    env["LD_LIBRARY_PATH"] = os.pathsep.join(filter(None, [libdir, env.get("LD_LIBRARY_PATH")]))
+    start = time.time()
+    with open(os.path.join(directory, "stdout.txt"), "wb") as out:
+        proc = subprocess.run(command, cwd=directory, env=env, stdout=out, stderr=subprocess.STDOUT)
+    status = {
+        "params": dict(params),
+        "run": run,
+        "command": command,
+        "returncode": proc.returncode,
+        "wallclock": time.time() - start,
+    }
+    if proc.returncode == 0:
+        # Only complete replications are marked, failed ones are retried on resume
+        with open(done_file, "w", encoding="utf-8") as f:
+            json.dump(status, f, indent=1)
+    return status
+
+
+def number(text):
+    """! Convert a FlowMonitor value, possibly a time such as '+1.5e+09ns', to a number
+    @param text the value
+    @return the number
+    """
+    return float(re.sub(r"[a-z]+$", "", text))
+
+
+def collect_flowmon(path):
+    """! Read the per-flow statistics of a FlowMonitor XML file
+    @param path the file
+    @return list of (key, metric, value) tuples
+    """
+    rows = []
+    root = ET.parse(path).getroot()
+    if root.tag != "FlowMonitor":
+        return rows
+    classifier = {}
+    for flow in root.iter("Flow"):
+        if "sourceAddress" in flow.attrib:
+            classifier[flow.get("flowId")] = "%s:%s->%s:%s/%s" % (
+                flow.get("sourceAddress"),
+                flow.get("sourcePort"),
+                flow.get("destinationAddress"),
+                flow.get("destinationPort"),
+                flow.get("protocol"),
+            )
+    for flow in root.find("FlowStats").iter("Flow"):
+        key = "flow %s %s" % (flow.get("flowId"), classifier.get(flow.get("flowId"), ""))
+        for stat in FLOW_STATS:
+            if stat in flow.attrib:
+                rows.append((key.strip(), stat, number(flow.get(stat))))
+    return rows
+
+
+def collect_omnet(path):
+    """! Read the scalars of a DataCollector OMNeT++ output file
+    @param path the file
+    @return list of (key, metric, value) tuples
+    """
+    rows = []
+    key = name = None
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            fields = line.split()
+            try:
+                if len(fields) == 4 and fields[0] == "scalar":
+                    rows.append((fields[1], fields[2], float(fields[3])))
+                elif len(fields) == 3 and fields[0] == "statistic":
+                    key, name = fields[1], fields[2]
+                elif len(fields) == 3 and fields[0] == "field" and name:
+                    rows.append((key, "%s.%s" % (name, fields[1]), float(fields[2])))
+            except ValueError:
+                # Labels, such as the measurement name, are not numeric
+                continue
+    return rows
+
+
+def collect(directory):
+    """! Gather the results files of a replication directory
+    @param directory the replication directory
+    @return list of (file, key, metric, value) tuples
+    """
+    rows = []
+    for name in sorted(os.listdir(directory)):
+        path = os.path.join(directory, name)
+        try:
+            if name.endswith(".xml"):
+                found = collect_flowmon(path)
+            elif name.endswith(".sca"):
+                found = collect_omnet(path)
+            else:
+                continue
+        except (ET.ParseError, ValueError, AttributeError) as e:
+            print("Skipping %s: %s" % (path, e), file=sys.stderr)
+            continue
+        rows.extend((name,) + row for row in found)
+    return rows
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--program", required=True, help="ns-3 program to run")
+    parser.add_argument(
+        "--param",
+        action="append",
+        default=[],
+        metavar="NAME=V1,V2,...",
+        help="CommandLine argument to sweep (may be repeated)",
+    )
+    parser.add_argument("--runs", default="1", help="RngRun values, e.g. 1-10 (default: 1)")
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=os.cpu_count(),
+        help="number of replications run in parallel (default: number of cores)",
+    )
+    parser.add_argument("--outdir", default="experiment", help="directory of the replications")
+    parser.add_argument("--results", default=None, help="CSV results file (default: OUTDIR.csv)")
+    parser.add_argument("args", nargs="*", help="additional program arguments, after '--'")
+    args = parser.parse_args(argv)
+
+    executable, libdir = find_program(args.program)
+    names = []
+    values = []
+    for param in args.param:
+        name, _, value = param.partition("=")
+        names.append(name)
+        values.append(value.split(","))
+    runs = parse_runs(args.runs)
+    outdir = os.path.abspath(args.outdir)
+    results = args.results or outdir.rstrip(os.sep) + ".csv"
+
+    replications = []
+    for combination in itertools.product(*values):
+        params = list(zip(names, combination))
+        for run in runs:
+            directory = os.path.join(outdir, replication_name(params, run))
+            replications.append((directory, params, run))
+
+    failed = 0
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        futures = [
+            pool.submit(run_replication, executable, libdir, d, p, r, args.args)
+            for d, p, r in replications
+        ]
+        for i, future in enumerate(as_completed(futures)):
+            status = future.result()
+            if status.get("skipped"):
+                state = "SKIP (complete)"
+            elif status["returncode"] == 0:
+                state = "PASS (%.1f s)" % status["wallclock"]
+            else:
+                state = "FAIL (return code %d)" % status["returncode"]
+                failed += 1
+            name = replication_name(list(status["params"].items()), status["run"])
+            print("[%d/%d] %s: %s" % (i + 1, len(replications), name, state))
+
+    with open(results, "w", newline="", encoding="utf-8") as f:
+        writer = csv.writer(f)
+        writer.writerow(names + ["RngRun", "file", "key", "metric", "value"])
+        for directory, params, run in replications:
+            if not os.path.exists(os.path.join(directory, "done.json")):
+                continue
+            for row in collect(directory):
+                writer.writerow([v for _, v in params] + [run] + list(row))
+    print("Results of %d replications written to %s" % (len(replications) - failed, results))
+    if failed:
+        print("%d replications failed; run the same command again to retry them" % failed)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))